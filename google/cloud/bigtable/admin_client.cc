@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/admin_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/internal/leased_reader.h"
 #include <google/longrunning/operations.grpc.pb.h>
 
 namespace {
@@ -57,6 +58,11 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
   std::shared_ptr<grpc::Channel> Channel() override { return impl_.Channel(); }
   void reset() override { return impl_.reset(); }
 
+  std::shared_ptr<google::cloud::bigtable::BackgroundThreads>
+  BackgroundThreads() override {
+    return impl_.BackgroundThreads();
+  }
+
   grpc::Status CreateTable(grpc::ClientContext* context,
                            btadmin::CreateTableRequest const& request,
                            btadmin::Table* response) override {
@@ -87,7 +93,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
   AsyncGetTable(grpc::ClientContext* context,
                 google::bigtable::admin::v2::GetTableRequest const& request,
                 grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetTable(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncGetTable(context, request, cq), stub);
   }
 
   grpc::Status DeleteTable(grpc::ClientContext* context,
@@ -163,7 +171,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::CreateTableRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCreateTable(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncCreateTable(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -172,7 +182,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DeleteTableRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDeleteTable(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncDeleteTable(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -181,7 +193,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::ModifyColumnFamiliesRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncModifyColumnFamilies(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncModifyColumnFamilies(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -190,7 +204,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DropRowRangeRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDropRowRange(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncDropRowRange(context, request, cq), stub);
   };
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -200,7 +216,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       const google::bigtable::admin::v2::GenerateConsistencyTokenRequest&
           request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGenerateConsistencyToken(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncGenerateConsistencyToken(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -209,7 +227,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::CheckConsistencyRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCheckConsistency(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncCheckConsistency(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -218,7 +238,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::GetSnapshotRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetSnapshot(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncGetSnapshot(context, request, cq), stub);
   };
 
   std::unique_ptr<
@@ -227,7 +249,9 @@ class DefaultAdminClient : public google::cloud::bigtable::AdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DeleteSnapshotRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDeleteSnapshot(context, request, cq);
+    auto stub = impl_.Stub();
+    return google::cloud::bigtable::internal::MakeLeasedReader(
+        stub->AsyncDeleteSnapshot(context, request, cq), stub);
   };
 
   std::unique_ptr<
@@ -251,6 +275,10 @@ namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+std::shared_ptr<BackgroundThreads> AdminClient::BackgroundThreads() {
+  return internal::DefaultBackgroundThreads();
+}
+
 std::shared_ptr<AdminClient> CreateDefaultAdminClient(std::string project,
                                                       ClientOptions options) {
   return std::make_shared<DefaultAdminClient>(std::move(project),
@@ -0,0 +1,120 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/background_threads.h"
+#include "google/cloud/bigtable/client_options.h"
+#include "google/cloud/bigtable/internal/client_options_defaults.h"
+#include "google/cloud/internal/make_unique.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/// Pin @p t to the core @p index, modulo the number of cores.
+void PinToCore(std::thread& t, std::size_t index) {
+#ifdef __linux__
+  auto const cores = std::thread::hardware_concurrency();
+  if (cores == 0) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(index % cores, &cpu_set);
+  // Pinning is only a hint, ignore any errors.
+  static_cast<void>(
+      pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set), &cpu_set));
+#else
+  static_cast<void>(t);
+  static_cast<void>(index);
+#endif  // __linux__
+}
+
+/// The number of threads for a pool where @p requested is the requested size.
+std::size_t PoolSize(std::size_t requested) {
+  return requested == 0 ? DefaultBackgroundThreadPoolSize() : requested;
+}
+}  // namespace
+
+AutomaticallyCreatedBackgroundThreads::AutomaticallyCreatedBackgroundThreads(
+    std::size_t thread_count, bool pin_to_cores)
+    : cq_(PoolSize(thread_count)) {
+  thread_count = PoolSize(thread_count);
+  pool_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    CompletionQueue cq = cq_;
+    pool_.emplace_back([cq]() mutable { cq.Run(); });
+    if (pin_to_cores) {
+      PinToCore(pool_.back(), i);
+    }
+  }
+}
+
+AutomaticallyCreatedBackgroundThreads::
+    ~AutomaticallyCreatedBackgroundThreads() {
+  cq_.Shutdown();
+  auto const self = std::this_thread::get_id();
+  for (auto& t : pool_) {
+    if (t.get_id() == self) {
+      // A thread cannot join itself. It keeps a copy of the queue, so it can
+      // finish draining it after this object is gone.
+      t.detach();
+      continue;
+    }
+    t.join();
+  }
+}
+
+std::size_t DefaultBackgroundThreadPoolSize() {
+  // `std::thread::hardware_concurrency()` is only a hint, it returns 0 if the
+  // value is not well defined or not computable.
+  std::size_t cpu_count = std::thread::hardware_concurrency();
+  return cpu_count > 0 ? cpu_count
+                       : BIGTABLE_CLIENT_DEFAULT_BACKGROUND_THREAD_POOL_SIZE;
+}
+
+namespace internal {
+std::unique_ptr<BackgroundThreads> MakeBackgroundThreads(
+    ClientOptions const& options) {
+  auto factory = options.background_threads_factory();
+  if (factory) {
+    return factory();
+  }
+  return google::cloud::internal::make_unique<
+      AutomaticallyCreatedBackgroundThreads>(
+      options.background_thread_pool_size(), options.pin_background_threads());
+}
+
+CompletionQueue BackgroundCompletionQueue(
+    std::shared_ptr<BackgroundThreads> threads) {
+  auto cq = threads->cq();
+  return CompletionQueue(cq, std::move(threads));
+}
+
+std::shared_ptr<BackgroundThreads> DefaultBackgroundThreads() {
+  // Intentionally leaked, destroying the pool during static destruction could
+  // join threads that are still used by other static objects.
+  static auto* const threads = new std::shared_ptr<BackgroundThreads>(
+      std::make_shared<AutomaticallyCreatedBackgroundThreads>());
+  return *threads;
+}
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,128 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BACKGROUND_THREADS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BACKGROUND_THREADS_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/version.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+class ClientOptions;
+
+/**
+ * A pool of threads running the event loop for asynchronous operations.
+ *
+ * The client library uses this interface to obtain a `CompletionQueue` when
+ * the application does not want to create and run its own. Applications can
+ * provide their own implementation through
+ * `ClientOptions::set_background_threads_factory()`.
+ */
+class BackgroundThreads {
+ public:
+  virtual ~BackgroundThreads() = default;
+
+  /// The completion queue served by the background threads.
+  virtual CompletionQueue cq() const = 0;
+};
+
+/**
+ * A `BackgroundThreads` implementation that owns its threads.
+ *
+ * The threads are created in the constructor, each one calls `Run()` on a
+ * `CompletionQueue` with one underlying gRPC queue per thread. The destructor
+ * shuts down the completion queue and joins the threads, any operations still
+ * pending at that point are cancelled. If the destructor runs in one of the
+ * pool threads, for example because a callback released the last reference to
+ * the pool, that thread is detached instead, it exits once its queue drains.
+ *
+ * @par Example
+ * @code
+ * bigtable::AutomaticallyCreatedBackgroundThreads threads;
+ * auto cq = threads.cq();
+ * table.AsyncApply(std::move(mutation), cq).get();
+ * @endcode
+ */
+class AutomaticallyCreatedBackgroundThreads : public BackgroundThreads {
+ public:
+  /**
+   * Create the pool.
+   *
+   * @param thread_count the number of threads, 0 uses
+   *     `DefaultBackgroundThreadPoolSize()`.
+   * @param pin_to_cores if true, pin each thread to a different core. This is
+   *     a best-effort request, it is ignored on platforms that do not support
+   *     it.
+   */
+  explicit AutomaticallyCreatedBackgroundThreads(std::size_t thread_count = 0,
+                                                 bool pin_to_cores = false);
+  ~AutomaticallyCreatedBackgroundThreads() override;
+
+  AutomaticallyCreatedBackgroundThreads(
+      AutomaticallyCreatedBackgroundThreads const&) = delete;
+  AutomaticallyCreatedBackgroundThreads& operator=(
+      AutomaticallyCreatedBackgroundThreads const&) = delete;
+
+  CompletionQueue cq() const override { return cq_; }
+
+  /// The number of threads in the pool.
+  std::size_t pool_size() const { return pool_.size(); }
+
+ private:
+  CompletionQueue cq_;
+  std::vector<std::thread> pool_;
+};
+
+/// The default number of background threads, one per core.
+std::size_t DefaultBackgroundThreadPoolSize();
+
+namespace internal {
+/**
+ * Create the background threads configured in @p options.
+ *
+ * Uses the factory in @p options if there is one, otherwise creates a
+ * `AutomaticallyCreatedBackgroundThreads` with the configured size.
+ */
+std::unique_ptr<BackgroundThreads> MakeBackgroundThreads(
+    ClientOptions const& options);
+
+/**
+ * Return the completion queue served by @p threads.
+ *
+ * Copies of the returned queue keep @p threads alive, so the queue is still
+ * served after the client that owns the threads is destroyed.
+ */
+CompletionQueue BackgroundCompletionQueue(
+    std::shared_ptr<BackgroundThreads> threads);
+
+/**
+ * The background threads used by clients that do not own any.
+ *
+ * The pool is created on first use and shared by the whole process, it is
+ * never destroyed.
+ */
+std::shared_ptr<BackgroundThreads> DefaultBackgroundThreads();
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BACKGROUND_THREADS_H_
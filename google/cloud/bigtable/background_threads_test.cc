@@ -0,0 +1,131 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/background_threads.h"
+#include "google/cloud/bigtable/client_options.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+using namespace google::cloud::testing_util::chrono_literals;
+
+/// @test Verify that the pool runs the completion queue event loop.
+TEST(BackgroundThreadsTest, LifeCycle) {
+  AutomaticallyCreatedBackgroundThreads threads(2);
+  EXPECT_EQ(2U, threads.pool_size());
+
+  auto timer = threads.cq().MakeRelativeTimer(2_ms);
+  EXPECT_EQ(std::future_status::ready, timer.wait_for(500_ms));
+}
+
+/// @test Verify that the default pool size is used when no size is given.
+TEST(BackgroundThreadsTest, DefaultPoolSize) {
+  AutomaticallyCreatedBackgroundThreads threads;
+  EXPECT_LE(1U, DefaultBackgroundThreadPoolSize());
+  EXPECT_EQ(DefaultBackgroundThreadPoolSize(), threads.pool_size());
+}
+
+/// @test Verify that pinned threads still run the event loop.
+TEST(BackgroundThreadsTest, PinToCores) {
+  AutomaticallyCreatedBackgroundThreads threads(2, true);
+  EXPECT_EQ(2U, threads.pool_size());
+
+  auto timer = threads.cq().MakeRelativeTimer(2_ms);
+  EXPECT_EQ(std::future_status::ready, timer.wait_for(500_ms));
+}
+
+/// @test Verify that the destructor does not wait for pending operations.
+TEST(BackgroundThreadsTest, DestructorCancelsPendingOperations) {
+  auto threads = google::cloud::internal::make_unique<
+      AutomaticallyCreatedBackgroundThreads>(2);
+  auto timer = threads->cq().MakeRelativeTimer(1_h);
+
+  auto start = std::chrono::steady_clock::now();
+  threads.reset();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, 500_ms);
+}
+
+/// @test Verify that a pool thread can destroy the pool.
+TEST(BackgroundThreadsTest, DestroyFromPoolThread) {
+  auto threads = std::make_shared<AutomaticallyCreatedBackgroundThreads>(2);
+  auto cq = threads->cq();
+
+  // The callback holds the last reference to the pool, it is destroyed in one
+  // of its own threads.
+  promise<void> done;
+  cq.RunAsync([&threads, &done](CompletionQueue&) {
+    threads.reset();
+    done.set_value();
+  });
+  EXPECT_EQ(std::future_status::ready, done.get_future().wait_for(500_ms));
+}
+
+/// @test Verify that the background queue keeps the pool running.
+TEST(BackgroundThreadsTest, BackgroundCompletionQueueKeepsPoolAlive) {
+  std::shared_ptr<BackgroundThreads> threads =
+      std::make_shared<AutomaticallyCreatedBackgroundThreads>(2);
+  auto cq = internal::BackgroundCompletionQueue(threads);
+  std::weak_ptr<BackgroundThreads> weak = threads;
+  threads.reset();
+  EXPECT_FALSE(weak.expired());
+
+  auto timer = cq.MakeRelativeTimer(2_ms);
+  EXPECT_EQ(std::future_status::ready, timer.wait_for(500_ms));
+}
+
+/// @test Verify that MakeBackgroundThreads() uses the options.
+TEST(BackgroundThreadsTest, MakeFromOptions) {
+  auto threads = internal::MakeBackgroundThreads(
+      ClientOptions().set_background_thread_pool_size(3));
+  auto const* automatic =
+      dynamic_cast<AutomaticallyCreatedBackgroundThreads*>(threads.get());
+  ASSERT_NE(nullptr, automatic);
+  EXPECT_EQ(3U, automatic->pool_size());
+}
+
+/// @test Verify that MakeBackgroundThreads() uses the factory if present.
+TEST(BackgroundThreadsTest, MakeFromFactory) {
+  int calls = 0;
+  auto options = ClientOptions().set_background_threads_factory(
+      [&calls]() -> std::unique_ptr<BackgroundThreads> {
+        ++calls;
+        return google::cloud::internal::make_unique<
+            AutomaticallyCreatedBackgroundThreads>(1);
+      });
+  auto threads = internal::MakeBackgroundThreads(options);
+  EXPECT_EQ(1, calls);
+  ASSERT_NE(nullptr, threads.get());
+
+  auto timer = threads->cq().MakeRelativeTimer(2_ms);
+  EXPECT_EQ(std::future_status::ready, timer.wait_for(500_ms));
+}
+
+/// @test Verify that the default background threads are shared.
+TEST(BackgroundThreadsTest, DefaultIsShared) {
+  auto a = internal::DefaultBackgroundThreads();
+  auto b = internal::DefaultBackgroundThreads();
+  EXPECT_EQ(a.get(), b.get());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,133 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/internal/random.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the cost of the first backoff of an operation.
+ *
+ * Every operation clones the backoff policy of its `Table`, and the first
+ * transient error calls `OnCompletion()` on the clone. When a service is
+ * unavailable all the operations do this at once. The benchmark runs this
+ * sequence from T threads, for T in 1, 2, 4, ..., thread-count, and reports
+ * the number of operations per second.
+ *
+ * For comparison, the benchmark also reports the throughput when each
+ * operation seeds a new `DefaultPRNG`, as the policies used to do.
+ *
+ * The benchmark does not need a Cloud Bigtable instance or an embedded server.
+ *
+ * Usage: backoff_benchmark [thread-count] [operations-per-thread]
+ */
+
+/// Helper functions and types for the backoff_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/// The default number of operations in each thread.
+constexpr long kDefaultOperationsPerThread = 10000;
+
+/// Run @p operation from @p thread_count threads, return the elapsed time.
+std::chrono::milliseconds RunPhase(int thread_count, long operations_per_thread,
+                                   std::function<long()> const& operation) {
+  std::atomic<bool> start(false);
+  std::atomic<long> checksum(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back(
+        [&start, &checksum, &operation, operations_per_thread] {
+          while (!start.load()) {
+            std::this_thread::yield();
+          }
+          long sum = 0;
+          for (long j = 0; j != operations_per_thread; ++j) {
+            sum += operation();
+          }
+          // Keep the compiler from optimizing the operations away.
+          checksum.fetch_add(sum);
+        });
+  }
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - begin);
+}
+
+void PrintResult(std::string const& name, int thread_count,
+                 long operations_per_thread,
+                 std::chrono::milliseconds elapsed) {
+  auto const operations = thread_count * operations_per_thread;
+  auto const throughput =
+      elapsed.count() == 0 ? 0 : 1000.0 * operations / elapsed.count();
+  std::cout << name << ", Threads=" << thread_count
+            << ", Operations=" << operations
+            << ", Elapsed=" << FormatDuration(elapsed)
+            << ", Operations/s=" << throughput << std::endl;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int thread_count = static_cast<int>(std::thread::hardware_concurrency());
+  long operations_per_thread = kDefaultOperationsPerThread;
+  if (argc > 1) {
+    thread_count = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    operations_per_thread = std::stol(argv[2]);
+  }
+  if (thread_count <= 0) {
+    thread_count = 1;
+  }
+
+  bigtable::ExponentialBackoffPolicy prototype(std::chrono::milliseconds(10),
+                                               std::chrono::minutes(5));
+  auto clone_and_backoff = [&prototype] {
+    auto policy = prototype.clone();
+    return static_cast<long>(
+        policy->OnCompletion(grpc::Status(grpc::StatusCode::UNAVAILABLE, ""))
+            .count());
+  };
+  auto seed_default_prng = [] {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    return static_cast<long>(generator() % 1000);
+  };
+
+  std::cout << "# Running Backoff Benchmark:\n";
+  for (int t = 1; t <= thread_count; t *= 2) {
+    PrintResult("CloneAndFirstBackoff", t, operations_per_thread,
+                RunPhase(t, operations_per_thread, clone_and_backoff));
+    PrintResult("SeedDefaultPRNG", t, operations_per_thread,
+                RunPhase(t, operations_per_thread, seed_default_prng));
+  }
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
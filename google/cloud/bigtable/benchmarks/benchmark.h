@@ -62,6 +62,11 @@ class Benchmark {
   /// Return a `bigtable::DataClient` configured for this benchmark.
   std::shared_ptr<bigtable::DataClient> MakeDataClient();
 
+  /// Return the client options used by `MakeDataClient()`.
+  bigtable::ClientOptions const& client_options() const {
+    return client_options_;
+  }
+
   /// Create a random key.
   std::string MakeRandomKey(google::cloud::internal::DefaultPRNG& gen) const;
 
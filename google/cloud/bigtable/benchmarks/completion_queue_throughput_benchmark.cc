@@ -0,0 +1,187 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/internal/make_unique.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the events per second handled by `bigtable::CompletionQueue` as the
+ * number of threads running the event loop grows.
+ *
+ * This benchmark creates an empty table and then runs two phases for each
+ * thread count T in 1, 2, 4, ..., thread-count:
+ *
+ * - In the `Shared` phase the T threads run a `CompletionQueue` backed by a
+ *   single gRPC completion queue.
+ * - In the `Sharded` phase the T threads run a `CompletionQueue` backed by T
+ *   gRPC completion queues, one for each thread.
+ *
+ * During each phase the benchmark keeps a fixed number of `AsyncApply()`
+ * requests in flight for each thread, starting a new request from the
+ * callback of each completed request, until the test duration expires. It
+ * then reports the number of completed requests per second.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local gRPC server that implements the Cloud Bigtable APIs used by the
+ * benchmark.  If this parameter is not used the benchmark uses the default
+ * configuration, that is, a production instance of Cloud Bigtable unless the
+ * CLOUD_BIGTABLE_EMULATOR environment variable is set.
+ */
+
+/// Helper functions and types for the completion_queue_throughput_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+using google::cloud::future;
+using google::cloud::promise;
+using google::cloud::Status;
+
+/// The number of requests in flight for each thread running the event loop.
+constexpr int kOutstandingPerThread = 16;
+
+struct PhaseResult {
+  long events;
+  long failed;
+  std::chrono::milliseconds elapsed;
+};
+
+/// Keep one request in flight until @p end, then satisfy @p done.
+class RequestLoop {
+ public:
+  RequestLoop(Benchmark& benchmark, bigtable::Table& table,
+              bigtable::CompletionQueue& cq,
+              std::chrono::steady_clock::time_point end,
+              std::atomic<long>& events, std::atomic<long>& failed)
+      : benchmark_(benchmark),
+        table_(table),
+        cq_(cq),
+        end_(end),
+        events_(events),
+        failed_(failed),
+        generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+
+  future<void> Start() {
+    auto f = done_.get_future();
+    Next();
+    return f;
+  }
+
+ private:
+  void Next() {
+    if (std::chrono::steady_clock::now() >= end_) {
+      done_.set_value();
+      return;
+    }
+    bigtable::SingleRowMutation mutation(benchmark_.MakeRandomKey(generator_));
+    mutation.emplace_back(MakeRandomMutation(generator_, 0));
+    table_.AsyncApply(std::move(mutation), cq_).then([this](future<Status> f) {
+      ++events_;
+      if (!f.get().ok()) {
+        ++failed_;
+      }
+      Next();
+    });
+  }
+
+  Benchmark& benchmark_;
+  bigtable::Table& table_;
+  bigtable::CompletionQueue& cq_;
+  std::chrono::steady_clock::time_point end_;
+  std::atomic<long>& events_;
+  std::atomic<long>& failed_;
+  google::cloud::internal::DefaultPRNG generator_;
+  promise<void> done_;
+};
+
+/// Run a phase with @p thread_count threads and @p queue_count queues.
+PhaseResult RunPhase(Benchmark& benchmark,
+                     bigtable::AppProfileId const& app_profile_id,
+                     std::string const& table_id, int thread_count,
+                     int queue_count, std::chrono::seconds test_duration) {
+  bigtable::Table table(benchmark.MakeDataClient(), app_profile_id, table_id);
+  bigtable::CompletionQueue cq(queue_count);
+  std::vector<std::thread> runners;
+  for (int i = 0; i != thread_count; ++i) {
+    runners.emplace_back([&cq] { cq.Run(); });
+  }
+
+  std::atomic<long> events(0);
+  std::atomic<long> failed(0);
+  auto start = std::chrono::steady_clock::now();
+  auto end = start + test_duration;
+  std::vector<std::unique_ptr<RequestLoop>> loops;
+  std::vector<future<void>> pending;
+  for (int i = 0; i != thread_count * kOutstandingPerThread; ++i) {
+    loops.emplace_back(google::cloud::internal::make_unique<RequestLoop>(
+        benchmark, table, cq, end, events, failed));
+    pending.emplace_back(loops.back()->Start());
+  }
+  for (auto& f : pending) {
+    f.get();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  cq.Shutdown();
+  for (auto& t : runners) {
+    t.join();
+  }
+  return PhaseResult{events.load(), failed.load(), elapsed};
+}
+
+void PrintResult(std::string const& mode, int thread_count,
+                 PhaseResult const& result) {
+  auto const throughput =
+      result.elapsed.count() == 0
+          ? 0
+          : 1000.0 * result.events / result.elapsed.count();
+  std::cout << mode << ", Threads=" << thread_count
+            << ", Events=" << result.events << ", Failed=" << result.failed
+            << ", Elapsed=" << FormatDuration(result.elapsed)
+            << ", Events/s=" << throughput << std::endl;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  bigtable::benchmarks::BenchmarkSetup setup("cq", argc, argv);
+  Benchmark benchmark(setup);
+  benchmark.CreateTable();
+
+  std::cout << "# Running CompletionQueue Throughput Benchmark:\n";
+  bigtable::AppProfileId const app_profile_id(setup.app_profile_id());
+  for (int thread_count = 1; thread_count <= setup.thread_count();
+       thread_count *= 2) {
+    auto shared = RunPhase(benchmark, app_profile_id, setup.table_id(),
+                           thread_count, 1, setup.test_duration());
+    PrintResult("Shared", thread_count, shared);
+    auto sharded = RunPhase(benchmark, app_profile_id, setup.table_id(),
+                            thread_count, thread_count, setup.test_duration());
+    PrintResult("Sharded", thread_count, sharded);
+  }
+
+  benchmark.DeleteTable();
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
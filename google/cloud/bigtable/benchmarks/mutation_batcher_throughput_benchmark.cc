@@ -0,0 +1,137 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the throughput of `bigtable::MutationBatcher::AsyncApply()` as the
+ * number of producer threads grows.
+ *
+ * This benchmark creates an empty table and then runs a phase for each
+ * producer thread count P in 1, 2, 4, ..., T. During each phase:
+ *
+ * - P threads share a single `MutationBatcher` and `CompletionQueue`.
+ * - Each thread runs for S seconds, creating a small mutation for a random row
+ *   and calling `AsyncApply()`, then waiting on the *admission* future.
+ * - When the time expires the benchmark waits for all the mutations to
+ *   complete and reports the number of mutations per second.
+ *
+ * The mutations are small on purpose: the goal is to measure the cost of
+ * submitting mutations from many threads, not the cost of sending them.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local gRPC server that implements the Cloud Bigtable APIs used by the
+ * benchmark.  If this parameter is not used the benchmark uses the default
+ * configuration, that is, a production instance of Cloud Bigtable unless the
+ * CLOUD_BIGTABLE_EMULATOR environment variable is set.
+ */
+
+/// Helper functions and types for the mutation_batcher_throughput_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+using google::cloud::future;
+using google::cloud::Status;
+
+struct PhaseResult {
+  long succeeded;
+  long failed;
+  std::chrono::milliseconds elapsed;
+};
+
+/// Run a phase of the benchmark with @p producer_count threads.
+PhaseResult RunPhase(Benchmark& benchmark,
+                     bigtable::AppProfileId const& app_profile_id,
+                     std::string const& table_id, int producer_count,
+                     std::chrono::seconds test_duration) {
+  bigtable::Table table(benchmark.MakeDataClient(), app_profile_id, table_id);
+  bigtable::MutationBatcher batcher(table);
+  bigtable::CompletionQueue cq;
+  std::thread cq_runner([&cq] { cq.Run(); });
+
+  std::atomic<long> succeeded(0);
+  std::atomic<long> failed(0);
+  auto start = std::chrono::steady_clock::now();
+  auto end = start + test_duration;
+  auto producer = [&]() {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    while (std::chrono::steady_clock::now() < end) {
+      bigtable::SingleRowMutation mutation(benchmark.MakeRandomKey(generator));
+      mutation.emplace_back(MakeRandomMutation(generator, 0));
+      auto admission_completion = batcher.AsyncApply(cq, std::move(mutation));
+      admission_completion.second.then([&succeeded, &failed](future<Status> f) {
+        if (f.get().ok()) {
+          ++succeeded;
+        } else {
+          ++failed;
+        }
+      });
+      admission_completion.first.get();
+    }
+  };
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i != producer_count; ++i) {
+    producers.emplace_back(producer);
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  batcher.AsyncWaitForNoPendingRequests().get();
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  cq.Shutdown();
+  cq_runner.join();
+  return PhaseResult{succeeded.load(), failed.load(), elapsed};
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  bigtable::benchmarks::BenchmarkSetup setup("batch", argc, argv);
+  Benchmark benchmark(setup);
+  benchmark.CreateTable();
+
+  std::cout << "# Running MutationBatcher Throughput Benchmark:\n";
+  for (int producer_count = 1; producer_count <= setup.thread_count();
+       producer_count *= 2) {
+    auto result =
+        RunPhase(benchmark, bigtable::AppProfileId(setup.app_profile_id()),
+                 setup.table_id(), producer_count, setup.test_duration());
+    auto const count = result.succeeded + result.failed;
+    auto const throughput =
+        result.elapsed.count() == 0 ? 0
+                                    : 1000.0 * count / result.elapsed.count();
+    std::cout << "Producers=" << producer_count << ", Mutations=" << count
+              << ", Failed=" << result.failed
+              << ", Elapsed=" << FormatDuration(result.elapsed)
+              << ", Mutations/s=" << throughput << std::endl;
+  }
+
+  benchmark.DeleteTable();
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
@@ -0,0 +1,193 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the allocations per cell in `internal::ReadRowsParser`.
+ *
+ * This benchmark feeds a synthetic stream of `ReadRowsResponse` chunks, with
+ * R rows of C cells each, to the parser and reports the number of heap
+ * allocations and the throughput for three modes:
+ *
+ * - `Row`: each cell owns a copy of the row key, family and qualifier.
+ * - `SharedRow`: cells share the row key, families and qualifiers.
+ * - `RowView`: cells refer to the data in the chunks, nothing is copied.
+ *
+ * The benchmark does not need a Cloud Bigtable instance or an embedded server,
+ * it only exercises the parser. The allocations are counted by replacing the
+ * global `operator new` in this program.
+ *
+ * Usage: read_rows_parser_benchmark [cells-per-row] [row-count]
+ */
+
+namespace {
+std::atomic<std::uint64_t> allocation_count(0);
+}  // anonymous namespace
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/// Helper functions and types for the read_rows_parser_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+using google::bigtable::v2::ReadRowsResponse_CellChunk;
+
+/// The default number of cells in each row, a "wide" row.
+constexpr long kDefaultCellsPerRow = 10000;
+
+/// The default number of rows in each iteration.
+constexpr long kDefaultRowCount = 20;
+
+/// Create the chunks for @p row_count rows, each with @p cells_per_row cells.
+std::vector<ReadRowsResponse_CellChunk> MakeChunks(long cells_per_row,
+                                                   long row_count) {
+  std::vector<ReadRowsResponse_CellChunk> chunks;
+  chunks.reserve(cells_per_row * row_count);
+  std::string const value(kFieldSize, 'x');
+  for (long r = 0; r != row_count; ++r) {
+    // Keys must be in increasing order, a fixed width makes that easy.
+    auto row_key = std::to_string(1000000 + r);
+    for (long c = 0; c != cells_per_row; ++c) {
+      ReadRowsResponse_CellChunk chunk;
+      if (c == 0) {
+        chunk.set_row_key(row_key);
+        chunk.mutable_family_name()->set_value(kColumnFamily);
+      }
+      chunk.mutable_qualifier()->set_value("field" + std::to_string(c));
+      chunk.set_timestamp_micros(1000);
+      chunk.set_value(value);
+      chunk.set_commit_row(c == cells_per_row - 1);
+      chunks.emplace_back(std::move(chunk));
+    }
+  }
+  return chunks;
+}
+
+struct ParseResult {
+  long cells;
+  std::uint64_t allocations;
+  std::chrono::microseconds elapsed;
+};
+
+/// How the parser receives the chunks and builds the cells.
+enum class ParseMode { kRow, kSharedRow, kRowView };
+
+/// Parse all the @p chunks, use @p extract to consume each row.
+template <typename Extractor>
+ParseResult Parse(std::vector<ReadRowsResponse_CellChunk> chunks,
+                  Extractor extract, ParseMode mode) {
+  bigtable::internal::ReadRowsParser parser;
+  parser.set_share_strings(mode == ParseMode::kSharedRow);
+  bool const use_views = mode == ParseMode::kRowView;
+  grpc::Status status;
+  long cells = 0;
+  auto const allocations_start = allocation_count.load();
+  auto const start = std::chrono::steady_clock::now();
+  for (auto& chunk : chunks) {
+    if (use_views) {
+      parser.HandleChunkView(chunk, status);
+    } else {
+      parser.HandleChunk(std::move(chunk), status);
+    }
+    if (!status.ok()) {
+      throw std::runtime_error(status.error_message());
+    }
+    if (parser.HasNext()) {
+      cells += extract(parser, status);
+    }
+  }
+  parser.HandleEndOfStream(status);
+  using std::chrono::duration_cast;
+  auto const elapsed = duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  return ParseResult{cells, allocation_count.load() - allocations_start,
+                     elapsed};
+}
+
+void PrintResult(std::string const& mode, ParseResult const& r) {
+  auto const cells_per_second =
+      r.elapsed.count() == 0 ? 0 : r.cells * 1000000 / r.elapsed.count();
+  std::cout << mode << ", Cells=" << r.cells
+            << ", Elapsed=" << FormatDuration(r.elapsed)
+            << ", Cells/s=" << cells_per_second << ", Allocations/Cell="
+            << static_cast<double>(r.allocations) / r.cells << "\n";
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  long cells_per_row = kDefaultCellsPerRow;
+  long row_count = kDefaultRowCount;
+  if (argc > 1) {
+    cells_per_row = std::stol(argv[1]);
+  }
+  if (argc > 2) {
+    row_count = std::stol(argv[2]);
+  }
+
+  std::cout << "# Parsing " << row_count << " rows with " << cells_per_row
+            << " cells each\n";
+
+  auto row_result = Parse(MakeChunks(cells_per_row, row_count),
+                          [](bigtable::internal::ReadRowsParser& parser,
+                             grpc::Status& status) {
+                            auto row = parser.Next(status);
+                            return static_cast<long>(row.cells().size());
+                          },
+                          ParseMode::kRow);
+  PrintResult("Row", row_result);
+
+  auto shared_result = Parse(MakeChunks(cells_per_row, row_count),
+                             [](bigtable::internal::ReadRowsParser& parser,
+                                grpc::Status& status) {
+                               auto row = parser.NextShared(status);
+                               return static_cast<long>(row.cells().size());
+                             },
+                             ParseMode::kSharedRow);
+  PrintResult("SharedRow", shared_result);
+
+  auto view_result = Parse(MakeChunks(cells_per_row, row_count),
+                           [](bigtable::internal::ReadRowsParser& parser,
+                              grpc::Status& status) {
+                             auto row = parser.NextView(status);
+                             return static_cast<long>(row.cells().size());
+                           },
+                           ParseMode::kRowView);
+  PrintResult("RowView", view_result);
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
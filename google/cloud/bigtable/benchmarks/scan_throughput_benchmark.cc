@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 /**
  * @file
@@ -47,6 +49,11 @@
  * The benchmark will report throughput in rows per second for each scans with
  * 100, 1,000 and 10,000 rows.
  *
+ * Each scan size is measured twice, once reading the rows one at a time using
+ * the `RowReader` iterators, and once reading the rows into a columnar
+ * `bigtable::RowBatch`. For each mode the benchmark also reports the throughput
+ * in cells per second.
+ *
  * Using a command-line parameter the benchmark can be configured to create a
  * local gRPC server that implements the Cloud Bigtable APIs used by the
  * benchmark.  If this parameter is not used, the benchmark uses the default
@@ -61,13 +68,21 @@ using namespace bigtable::benchmarks;
 
 constexpr int kScanSizes[] = {100, 1000, 10000};
 
+/// How the rows are read in each scan.
+enum class ScanMode { kRowAtATime, kBatch };
+
+/// The results of running the benchmark for a scan size.
+struct ScanResult {
+  BenchmarkResult result;
+  long cell_count;
+};
+
 /// Run an iteration of the test.
-BenchmarkResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
-                             std::shared_ptr<bigtable::DataClient> data_client,
-                             long table_size,
-                             bigtable::AppProfileId app_profile_id,
-                             std::string const& table_id, long scan_size,
-                             std::chrono::seconds test_duration);
+ScanResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
+                        std::shared_ptr<bigtable::DataClient> data_client,
+                        long table_size, bigtable::AppProfileId app_profile_id,
+                        std::string const& table_id, long scan_size,
+                        ScanMode mode, std::chrono::seconds test_duration);
 }  // anonymous namespace
 
 int main(int argc, char* argv[]) try {
@@ -84,21 +99,30 @@ int main(int argc, char* argv[]) try {
   auto data_client = benchmark.MakeDataClient();
   std::map<std::string, BenchmarkResult> results_by_size;
   for (auto scan_size : kScanSizes) {
-    std::cout << "# Running benchmark [" << scan_size << "] " << std::flush;
-    auto start = std::chrono::steady_clock::now();
-    auto combined =
-        RunBenchmark(benchmark, data_client, setup.table_size(),
-                     bigtable::AppProfileId(setup.app_profile_id()),
-                     setup.table_id(), scan_size, setup.test_duration());
-    using std::chrono::duration_cast;
-    combined.elapsed = duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start);
-    std::cout << " DONE. Elapsed=" << FormatDuration(combined.elapsed)
-              << ", Ops=" << combined.operations.size()
-              << ", Rows=" << combined.row_count << "\n";
-    auto op_name = "Scan(" + std::to_string(scan_size) + ")";
-    benchmark.PrintLatencyResult(std::cout, "scant", op_name, combined);
-    results_by_size[op_name] = std::move(combined);
+    for (auto mode : {ScanMode::kRowAtATime, ScanMode::kBatch}) {
+      auto op_name = std::string(mode == ScanMode::kBatch ? "BatchScan("
+                                                          : "Scan(") +
+                     std::to_string(scan_size) + ")";
+      std::cout << "# Running benchmark [" << op_name << "] " << std::flush;
+      auto start = std::chrono::steady_clock::now();
+      auto scan = RunBenchmark(benchmark, data_client, setup.table_size(),
+                               bigtable::AppProfileId(setup.app_profile_id()),
+                               setup.table_id(), scan_size, mode,
+                               setup.test_duration());
+      auto& combined = scan.result;
+      using std::chrono::duration_cast;
+      combined.elapsed = duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+      auto const elapsed_ms =
+          (std::max)(combined.elapsed, std::chrono::milliseconds(1)).count();
+      std::cout << " DONE. Elapsed=" << FormatDuration(combined.elapsed)
+                << ", Ops=" << combined.operations.size()
+                << ", Rows=" << combined.row_count
+                << ", Cells=" << scan.cell_count
+                << ", Cells/s=" << scan.cell_count * 1000 / elapsed_ms << "\n";
+      benchmark.PrintLatencyResult(std::cout, "scant", op_name, combined);
+      results_by_size[op_name] = std::move(combined);
+    }
   }
 
   std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
@@ -118,36 +142,61 @@ int main(int argc, char* argv[]) try {
 }
 
 namespace {
-BenchmarkResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
-                             std::shared_ptr<bigtable::DataClient> data_client,
-                             long table_size,
-                             bigtable::AppProfileId app_profile_id,
-                             std::string const& table_id, long scan_size,
-                             std::chrono::seconds test_duration) {
-  BenchmarkResult result = {};
+ScanResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
+                        std::shared_ptr<bigtable::DataClient> data_client,
+                        long table_size, bigtable::AppProfileId app_profile_id,
+                        std::string const& table_id, long scan_size,
+                        ScanMode mode, std::chrono::seconds test_duration) {
+  ScanResult scan = {};
+  auto& result = scan.result;
 
   bigtable::Table table(std::move(data_client), app_profile_id, table_id);
 
   auto generator = google::cloud::internal::MakeDefaultPRNG();
   std::uniform_int_distribution<long> prng(0, table_size - scan_size - 1);
 
+  // Reuse the batch buffers across scans, as an application would.
+  bigtable::RowBatch batch;
+
   auto test_start = std::chrono::steady_clock::now();
   while (std::chrono::steady_clock::now() < test_start + test_duration) {
     auto range =
         bigtable::RowRange::StartingAt(benchmark.MakeKey(prng(generator)));
 
     long count = 0;
-    auto op = [&count, &table, &scan_size, &range]() {
+    long cells = 0;
+    auto op = [&count, &cells, &table, &scan_size, &range, &batch, mode]() {
       auto reader =
           table.ReadRows(bigtable::RowSet(std::move(range)), scan_size,
                          bigtable::Filter::ColumnRangeClosed(
                              kColumnFamily, "field0", "field9"));
-      count = std::distance(reader.begin(), reader.end());
+      if (mode == ScanMode::kRowAtATime) {
+        for (auto& row : reader) {
+          if (!row) {
+            throw std::runtime_error(row.status().message());
+          }
+          ++count;
+          cells += static_cast<long>(row->cells().size());
+        }
+        return;
+      }
+      for (;;) {
+        auto status = reader.NextBatch(batch);
+        if (!status.ok()) {
+          throw std::runtime_error(status.message());
+        }
+        if (batch.empty()) {
+          break;
+        }
+        count += static_cast<long>(batch.row_count());
+        cells += static_cast<long>(batch.cell_count());
+      }
     };
     result.operations.push_back(Benchmark::TimeOperation(op));
     result.row_count += count;
+    scan.cell_count += cells;
   }
-  return result;
+  return scan;
 }
 
 }  // anonymous namespace
@@ -0,0 +1,182 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the latency of the first RPCs made by a newly created `DataClient`,
+ * with and without prewarming the connection pool.
+ *
+ * The benchmark creates an empty table and then runs two phases:
+ *
+ * - In the `Lazy` phase the client connects each channel when it is first
+ *   used, this is the default behavior.
+ * - In the `Prewarmed` phase the client is created with
+ *   `ClientOptions::set_connection_pool_prewarm_timeout()`, and connects all
+ *   its channels before the constructor returns.
+ *
+ * Each phase runs several iterations. Each iteration creates a new client,
+ * with a new connection pool, and makes the first N `Apply()` requests from T
+ * threads. N is 10 requests for each channel in the pool. The benchmark
+ * reports the time to create the client, the time from the start of the
+ * iteration until the N requests complete, and the latency distribution of
+ * the requests.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local gRPC server that implements the Cloud Bigtable APIs used by the
+ * benchmark.  If this parameter is not used the benchmark uses the default
+ * configuration, that is, a production instance of Cloud Bigtable unless the
+ * CLOUD_BIGTABLE_EMULATOR environment variable is set.
+ */
+
+/// Helper functions and types for the startup_latency_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/// The number of clients created in each phase.
+constexpr int kIterations = 10;
+
+/// The number of requests made for each channel in the pool.
+constexpr int kRequestsPerChannel = 10;
+
+/// The timeout to connect the pool in the `Prewarmed` phase.
+constexpr std::chrono::seconds kPrewarmTimeout(10);
+
+struct PhaseResult {
+  std::chrono::microseconds create_client;
+  std::chrono::microseconds first_requests;
+  BenchmarkResult requests;
+};
+
+/// Make @p count `Apply()` requests, recording their latency.
+BenchmarkResult MakeRequests(Benchmark& benchmark, bigtable::Table& table,
+                             int count) {
+  BenchmarkResult result = {};
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  for (int i = 0; i != count; ++i) {
+    bigtable::SingleRowMutation mutation(benchmark.MakeRandomKey(generator));
+    mutation.emplace_back(MakeRandomMutation(generator, 0));
+    result.operations.emplace_back(
+        Benchmark::TimeOperation([&table, &mutation] {
+          auto status = table.Apply(std::move(mutation));
+          if (!status.ok()) {
+            throw std::runtime_error(status.message());
+          }
+        }));
+    ++result.row_count;
+  }
+  return result;
+}
+
+/// Run one iteration of a phase, using a new connection pool.
+void RunIteration(Benchmark& benchmark, BenchmarkSetup const& setup,
+                  bigtable::ClientOptions options, PhaseResult& phase) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  auto start = std::chrono::steady_clock::now();
+  auto data_client = bigtable::CreateDefaultDataClient(
+      setup.project_id(), setup.instance_id(), std::move(options));
+  auto created = std::chrono::steady_clock::now();
+  bigtable::Table table(data_client,
+                        bigtable::AppProfileId(setup.app_profile_id()),
+                        setup.table_id());
+
+  auto const requests =
+      kRequestsPerChannel *
+      static_cast<int>(benchmark.client_options().connection_pool_size());
+  auto const per_thread = requests / setup.thread_count() + 1;
+  std::vector<std::future<BenchmarkResult>> tasks;
+  for (int i = 0; i != setup.thread_count(); ++i) {
+    tasks.emplace_back(std::async(std::launch::async, MakeRequests,
+                                  std::ref(benchmark), std::ref(table),
+                                  per_thread));
+  }
+  for (auto& t : tasks) {
+    auto r = t.get();
+    phase.requests.row_count += r.row_count;
+    phase.requests.operations.insert(phase.requests.operations.end(),
+                                     r.operations.begin(),
+                                     r.operations.end());
+  }
+  auto done = std::chrono::steady_clock::now();
+  phase.create_client += duration_cast<microseconds>(created - start);
+  phase.first_requests += duration_cast<microseconds>(done - start);
+}
+
+/// Run all the iterations of a phase.
+PhaseResult RunPhase(Benchmark& benchmark, BenchmarkSetup const& setup,
+                     std::string const& name, bool prewarm) {
+  PhaseResult phase{};
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != kIterations; ++i) {
+    auto options = benchmark.client_options();
+    // gRPC shares connections between channels with the same attributes, use
+    // a different pool name to start from scratch in each iteration.
+    options.set_connection_pool_name(name + "-" + std::to_string(i));
+    if (prewarm) {
+      options.set_connection_pool_prewarm_timeout(kPrewarmTimeout);
+    }
+    RunIteration(benchmark, setup, std::move(options), phase);
+  }
+  phase.requests.elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+  return phase;
+}
+
+void PrintResult(Benchmark const& benchmark, std::string const& name,
+                 PhaseResult& phase) {
+  std::cout << name << " CreateClient="
+            << FormatDuration(phase.create_client / kIterations)
+            << ", TimeToFirstRequests="
+            << FormatDuration(phase.first_requests / kIterations) << "\n";
+  benchmark.PrintLatencyResult(std::cout, "startup", name + "/Apply()",
+                               phase.requests);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  bigtable::benchmarks::BenchmarkSetup setup("startup", argc, argv);
+  Benchmark benchmark(setup);
+  benchmark.CreateTable();
+
+  std::cout << "# Running Startup Latency Benchmark:\n";
+  auto lazy = RunPhase(benchmark, setup, "Lazy", false);
+  PrintResult(benchmark, "Lazy", lazy);
+  auto prewarmed = RunPhase(benchmark, setup, "Prewarmed", true);
+  PrintResult(benchmark, "Prewarmed", prewarmed);
+
+  std::cout << Benchmark::ResultsCsvHeader() << "\n";
+  benchmark.PrintResultCsv(std::cout, "startup", "Lazy", "Latency",
+                           lazy.requests);
+  benchmark.PrintResultCsv(std::cout, "startup", "Prewarmed", "Latency",
+                           prewarmed.requests);
+
+  benchmark.DeleteTable();
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
@@ -0,0 +1,139 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/internal/common_client.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the contention in the stub lookup performed by `DataClient` for
+ * every RPC.
+ *
+ * The benchmark calls `Stub()` on the `internal::CommonClient` used by the
+ * default `DataClient` from T threads, for T in 1, 2, 4, ..., thread-count,
+ * and reports the number of lookups per second. It runs once for each
+ * channel selection policy.
+ *
+ * The benchmark does not need a Cloud Bigtable instance or an embedded server,
+ * the channels connect lazily and no RPC is ever made.
+ *
+ * Usage: stub_contention_benchmark [thread-count] [lookups-per-thread]
+ */
+
+/// Helper functions and types for the stub_contention_benchmark.
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using namespace bigtable::benchmarks;
+
+/// The default number of calls to `Stub()` in each thread.
+constexpr long kDefaultLookupsPerThread = 1000000;
+
+/// The default connection pool size, larger than most applications use.
+constexpr std::size_t kPoolSize = 16;
+
+/// Same traits as the default `DataClient`.
+struct DataTraits {
+  static std::string const& Endpoint(bigtable::ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using DataClientImpl =
+    bigtable::internal::CommonClient<DataTraits,
+                                     google::bigtable::v2::Bigtable>;
+
+/// Run @p thread_count threads calling `Stub()`, return the elapsed time.
+std::chrono::milliseconds RunPhase(
+    bigtable::ChannelSelectionPolicy const& policy, int thread_count,
+    long lookups_per_thread) {
+  DataClientImpl client(
+      bigtable::ClientOptions(grpc::InsecureChannelCredentials())
+          .set_data_endpoint("localhost:1")
+          .set_connection_pool_size(kPoolSize)
+          .set_channel_selection_policy(policy));
+  // Create the pool before starting the clock.
+  client.Stub();
+
+  std::atomic<bool> start(false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back([&client, &start, lookups_per_thread] {
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      for (long j = 0; j != lookups_per_thread; ++j) {
+        auto stub = client.Stub();
+      }
+    });
+  }
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - begin);
+}
+
+void PrintResult(std::string const& policy, int thread_count,
+                 long lookups_per_thread, std::chrono::milliseconds elapsed) {
+  auto const lookups = thread_count * lookups_per_thread;
+  auto const throughput =
+      elapsed.count() == 0 ? 0 : 1000.0 * lookups / elapsed.count();
+  std::cout << policy << ", Threads=" << thread_count
+            << ", Lookups=" << lookups
+            << ", Elapsed=" << FormatDuration(elapsed)
+            << ", Lookups/s=" << throughput << std::endl;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int thread_count = static_cast<int>(std::thread::hardware_concurrency());
+  long lookups_per_thread = kDefaultLookupsPerThread;
+  if (argc > 1) {
+    thread_count = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    lookups_per_thread = std::stol(argv[2]);
+  }
+  if (thread_count <= 0) {
+    thread_count = 1;
+  }
+
+  std::cout << "# Running Stub Contention Benchmark:\n";
+  for (int t = 1; t <= thread_count; t *= 2) {
+    PrintResult("RoundRobin", t, lookups_per_thread,
+                RunPhase(bigtable::RoundRobinChannelSelection(), t,
+                         lookups_per_thread));
+    PrintResult("LeastOutstandingRpcs", t, lookups_per_thread,
+                RunPhase(bigtable::LeastOutstandingRpcsChannelSelection(), t,
+                         lookups_per_thread));
+    PrintResult("PowerOfTwoChoices", t, lookups_per_thread,
+                RunPhase(bigtable::PowerOfTwoChoicesChannelSelection(), t,
+                         lookups_per_thread));
+  }
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
@@ -20,8 +20,10 @@ bigtable_client_hdrs = [
     "admin_client.h",
     "app_profile_config.h",
     "async_operation.h",
+    "background_threads.h",
     "bigtable_strong_types.h",
     "cell.h",
+    "channel_selection_policy.h",
     "client_options.h",
     "cluster_config.h",
     "cluster_list_responses.h",
@@ -47,6 +49,7 @@ bigtable_client_hdrs = [
     "internal/async_poll_op.h",
     "internal/async_sample_row_keys.h",
     "internal/async_read_row_operation.h",
+    "internal/async_read_rows_future.h",
     "internal/async_retry_multi_page.h",
     "internal/async_retry_op.h",
     "internal/async_retry_unary_rpc.h",
@@ -58,13 +61,19 @@ bigtable_client_hdrs = [
     "internal/common_client.h",
     "internal/conjunction.h",
     "internal/grpc_error_delegate.h",
+    "internal/leased_reader.h",
+    "internal/mpsc_queue.h",
     "internal/instance_admin.h",
     "internal/poll_longrunning_operation.h",
+    "internal/prefetching_read_rows_reader.h",
     "internal/prefix_range_end.h",
+    "internal/read_rows_arena_pool.h",
     "internal/readrowsparser.h",
+    "internal/retry_backoff.h",
     "internal/rpc_policy_parameters.inc",
     "internal/rpc_policy_parameters.h",
     "internal/rowreaderiterator.h",
+    "internal/split_row_set.h",
     "internal/strong_type.h",
     "internal/table.h",
     "internal/table_admin.h",
@@ -72,15 +81,18 @@ bigtable_client_hdrs = [
     "idempotent_mutation_policy.h",
     "mutation_batcher.h",
     "mutations.h",
+    "parallel_scan_options.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
     "row.h",
+    "row_batch.h",
     "row_key_sample.h",
     "row_range.h",
     "row_reader.h",
     "row_set.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
+    "retry_budget.h",
     "metadata_update_policy.h",
     "table.h",
     "table_admin.h",
@@ -92,6 +104,8 @@ bigtable_client_hdrs = [
 bigtable_client_srcs = [
     "admin_client.cc",
     "app_profile_config.cc",
+    "background_threads.cc",
+    "channel_selection_policy.cc",
     "client_options.cc",
     "cluster_config.cc",
     "completion_queue.cc",
@@ -103,25 +117,32 @@ bigtable_client_srcs = [
     "instance_update_config.cc",
     "internal/async_future_from_callback.cc",
     "internal/async_sample_row_keys.cc",
+    "internal/async_read_rows_future.cc",
     "internal/bulk_mutator.cc",
     "internal/completion_queue_impl.cc",
     "internal/common_client.cc",
     "internal/grpc_error_delegate.cc",
     "internal/instance_admin.cc",
+    "internal/prefetching_read_rows_reader.cc",
     "internal/prefix_range_end.cc",
+    "internal/read_rows_arena_pool.cc",
     "internal/readrowsparser.cc",
     "internal/rowreaderiterator.cc",
+    "internal/split_row_set.cc",
     "internal/table.cc",
     "internal/table_admin.cc",
     "idempotent_mutation_policy.cc",
     "mutation_batcher.cc",
     "mutations.cc",
+    "parallel_scan_options.cc",
     "polling_policy.cc",
+    "row_batch.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
+    "retry_budget.cc",
     "metadata_update_policy.cc",
     "table.cc",
     "table_admin.cc",
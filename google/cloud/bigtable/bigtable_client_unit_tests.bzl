@@ -22,8 +22,10 @@ bigtable_client_unit_tests = [
     "async_list_app_profiles_test.cc",
     "async_list_clusters_test.cc",
     "async_list_instances_test.cc",
+    "background_threads_test.cc",
     "bigtable_version_test.cc",
     "cell_test.cc",
+    "channel_selection_policy_test.cc",
     "client_options_test.cc",
     "cluster_config_test.cc",
     "column_family_test.cc",
@@ -49,10 +51,16 @@ bigtable_client_unit_tests = [
     "internal/async_retry_unary_rpc_and_poll_test.cc",
     "internal/async_retry_unary_rpc_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/common_client_test.cc",
     "internal/table_async_check_and_mutate_row_test.cc",
     "internal/instance_admin_test.cc",
     "internal/grpc_error_delegate_test.cc",
+    "internal/mpsc_queue_test.cc",
+    "internal/prefetching_read_rows_reader_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/read_rows_arena_pool_test.cc",
+    "internal/retry_backoff_test.cc",
+    "internal/split_row_set_test.cc",
     "internal/table_admin_test.cc",
     "internal/table_async_apply_test.cc",
     "internal/table_async_bulk_apply_test.cc",
@@ -63,15 +71,18 @@ bigtable_client_unit_tests = [
     "mutations_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
+    "table_async_readrows_test.cc",
     "table_bulk_apply_test.cc",
     "table_check_and_mutate_row_test.cc",
     "table_config_test.cc",
+    "table_parallel_readrows_test.cc",
     "table_readrow_test.cc",
     "table_readrows_test.cc",
     "table_sample_row_keys_test.cc",
     "table_test.cc",
     "table_readmodifywriterow_test.cc",
     "read_modify_write_rule_test.cc",
+    "row_batch_test.cc",
     "row_reader_test.cc",
     "row_test.cc",
     "row_range_test.cc",
@@ -79,5 +90,6 @@ bigtable_client_unit_tests = [
     "rpc_backoff_policy_test.cc",
     "metadata_update_policy_test.cc",
     "rpc_retry_policy_test.cc",
+    "retry_budget_test.cc",
     "polling_policy_test.cc",
 ]
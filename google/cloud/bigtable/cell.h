@@ -19,7 +19,10 @@
 #include "google/cloud/internal/big_endian.h"
 #include "google/cloud/status_or.h"
 
+#include <google/protobuf/repeated_field.h>
 #include <chrono>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -118,6 +121,162 @@ class Cell {
   std::vector<std::string> labels_;
 };
 
+/**
+ * A Bigtable cell that shares the storage for its row key, family and column.
+ *
+ * Rows returned by a scan often contain many cells with the same row key, and
+ * a small number of distinct column families and column qualifiers. Objects of
+ * this class refer to these strings through reference-counted handles, so a
+ * wide row allocates its row key once, and each distinct column family or
+ * column qualifier is allocated once per stream. Only the value and the labels
+ * are owned by each cell.
+ *
+ * Applications scanning wide rows, where the per-cell copies in `Cell` are
+ * significant, can use this class via `SharedRow`. Use `ToCell()` to create a
+ * `Cell` that owns all its data.
+ */
+class SharedCell {
+ public:
+  /// The type used to share the row key, family, and column qualifier.
+  using StringPtr = std::shared_ptr<std::string const>;
+
+  /// Create a SharedCell and fill it with data.
+  SharedCell(StringPtr row_key, StringPtr family_name,
+             StringPtr column_qualifier, std::int64_t timestamp,
+             std::string value, std::vector<std::string> labels)
+      : row_key_(std::move(row_key)),
+        family_name_(std::move(family_name)),
+        column_qualifier_(std::move(column_qualifier)),
+        timestamp_(timestamp),
+        value_(std::move(value)),
+        labels_(std::move(labels)) {}
+
+  /// Return the row key this cell belongs to. The returned value is valid
+  /// while any cell (or row) sharing it is alive.
+  std::string const& row_key() const { return *row_key_; }
+
+  /// Return the family this cell belongs to. The returned value is valid
+  /// while any cell sharing it is alive.
+  std::string const& family_name() const { return *family_name_; }
+
+  /// Return the column this cell belongs to. The returned value is valid
+  /// while any cell sharing it is alive.
+  std::string const& column_qualifier() const { return *column_qualifier_; }
+
+  /// Return the timestamp of this cell.
+  std::chrono::microseconds timestamp() const {
+    return std::chrono::microseconds(timestamp_);
+  }
+
+  /// Return the contents of this cell. The returned value is not valid after
+  /// this object is deleted.
+  std::string const& value() const { return value_; }
+
+  /// Interpret the value as a big-endian encoded `T` and return it.
+  template <typename T>
+  StatusOr<T> decode_big_endian_integer() const {
+    return google::cloud::internal::DecodeBigEndian<T>(value_);
+  }
+
+  /// Return the labels applied to this cell by label transformer read filters.
+  std::vector<std::string> const& labels() const { return labels_; }
+
+  //@{
+  /// @name Access the shared storage, mostly useful to test sharing.
+  StringPtr const& shared_row_key() const { return row_key_; }
+  StringPtr const& shared_family_name() const { return family_name_; }
+  StringPtr const& shared_column_qualifier() const { return column_qualifier_; }
+  //@}
+
+  //@{
+  /// Create a `Cell` owning copies of the shared data.
+  Cell ToCell() const& {
+    return Cell(*row_key_, *family_name_, *column_qualifier_, timestamp_,
+                value_, labels_);
+  }
+  Cell ToCell() && {
+    return Cell(*row_key_, *family_name_, *column_qualifier_, timestamp_,
+                std::move(value_), std::move(labels_));
+  }
+  //@}
+
+ private:
+  StringPtr row_key_;
+  StringPtr family_name_;
+  StringPtr column_qualifier_;
+  std::int64_t timestamp_;
+  std::string value_;
+  std::vector<std::string> labels_;
+};
+
+/**
+ * A Bigtable cell that refers to data owned by a `RowReader`.
+ *
+ * Objects of this class are returned (via `RowView`) by
+ * `RowReader::NextRowView()`. They do not own any data, the row key, family,
+ * column qualifier, value and labels refer to the buffers used to receive the
+ * `ReadRows` responses. These buffers are recycled after the row is consumed,
+ * so a `CellView` is only valid until the next call to `NextRowView()` on the
+ * same reader, or until the reader is deleted. Use `ToCell()` to keep a copy.
+ */
+class CellView {
+ public:
+  /// The type used to represent the labels in the response.
+  using Labels = google::protobuf::RepeatedPtrField<std::string>;
+
+  /// Create a CellView referring to existing data.
+  CellView(std::string const& row_key, std::string const& family_name,
+           std::string const& column_qualifier, std::int64_t timestamp,
+           std::string const& value, Labels const& labels)
+      : row_key_(&row_key),
+        family_name_(&family_name),
+        column_qualifier_(&column_qualifier),
+        timestamp_(timestamp),
+        value_(&value),
+        labels_(&labels) {}
+
+  /// Return the row key this cell belongs to.
+  std::string const& row_key() const { return *row_key_; }
+
+  /// Return the family this cell belongs to.
+  std::string const& family_name() const { return *family_name_; }
+
+  /// Return the column this cell belongs to.
+  std::string const& column_qualifier() const { return *column_qualifier_; }
+
+  /// Return the timestamp of this cell.
+  std::chrono::microseconds timestamp() const {
+    return std::chrono::microseconds(timestamp_);
+  }
+
+  /// Return the contents of this cell.
+  std::string const& value() const { return *value_; }
+
+  /// Interpret the value as a big-endian encoded `T` and return it.
+  template <typename T>
+  StatusOr<T> decode_big_endian_integer() const {
+    return google::cloud::internal::DecodeBigEndian<T>(*value_);
+  }
+
+  /// Return the labels applied to this cell by label transformer read filters.
+  Labels const& labels() const { return *labels_; }
+
+  /// Create a `Cell` owning copies of the data.
+  Cell ToCell() const {
+    return Cell(*row_key_, *family_name_, *column_qualifier_, timestamp_,
+                *value_,
+                std::vector<std::string>(labels_->begin(), labels_->end()));
+  }
+
+ private:
+  std::string const* row_key_;
+  std::string const* family_name_;
+  std::string const* column_qualifier_;
+  std::int64_t timestamp_;
+  std::string const* value_;
+  Labels const* labels_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -77,3 +77,63 @@ TEST(CellTest, SimpleNumericNegativeValue) {
   EXPECT_STATUS_OK(decoded);
   EXPECT_EQ(value, *decoded);
 }
+
+/// @test Verify SharedCell instantiation and conversion to Cell.
+TEST(CellTest, SharedCell) {
+  auto row_key = std::make_shared<std::string const>("row");
+  auto family_name = std::make_shared<std::string const>("family");
+  auto column_qualifier = std::make_shared<std::string const>("column");
+
+  bigtable::SharedCell cell(row_key, family_name, column_qualifier, 42, "value",
+                            {"l1"});
+  EXPECT_EQ("row", cell.row_key());
+  EXPECT_EQ("family", cell.family_name());
+  EXPECT_EQ("column", cell.column_qualifier());
+  EXPECT_EQ(42, cell.timestamp().count());
+  EXPECT_EQ("value", cell.value());
+  ASSERT_EQ(1U, cell.labels().size());
+  EXPECT_EQ(row_key.get(), cell.shared_row_key().get());
+  EXPECT_EQ(family_name.get(), cell.shared_family_name().get());
+  EXPECT_EQ(column_qualifier.get(), cell.shared_column_qualifier().get());
+
+  bigtable::SharedCell other(row_key, family_name, column_qualifier, 43, "v2",
+                             {});
+  EXPECT_EQ(&cell.row_key(), &other.row_key());
+  EXPECT_EQ(&cell.family_name(), &other.family_name());
+
+  bigtable::Cell copy = cell.ToCell();
+  EXPECT_EQ("row", copy.row_key());
+  EXPECT_EQ("family", copy.family_name());
+  EXPECT_EQ("column", copy.column_qualifier());
+  EXPECT_EQ(42, copy.timestamp().count());
+  EXPECT_EQ("value", copy.value());
+  EXPECT_EQ(1U, copy.labels().size());
+}
+
+/// @test Verify CellView refers to existing data and converts to Cell.
+TEST(CellTest, CellView) {
+  std::string const row_key = "row";
+  std::string const family_name = "family";
+  std::string const column_qualifier = "column";
+  std::string const value = "value";
+  bigtable::CellView::Labels labels;
+  labels.Add()->assign("l1");
+
+  bigtable::CellView cell(row_key, family_name, column_qualifier, 42, value,
+                          labels);
+  EXPECT_EQ(&row_key, &cell.row_key());
+  EXPECT_EQ(&family_name, &cell.family_name());
+  EXPECT_EQ(&column_qualifier, &cell.column_qualifier());
+  EXPECT_EQ(&value, &cell.value());
+  EXPECT_EQ(42, cell.timestamp().count());
+  ASSERT_EQ(1, cell.labels().size());
+
+  bigtable::Cell copy = cell.ToCell();
+  EXPECT_EQ("row", copy.row_key());
+  EXPECT_EQ("family", copy.family_name());
+  EXPECT_EQ("column", copy.column_qualifier());
+  EXPECT_EQ(42, copy.timestamp().count());
+  EXPECT_EQ("value", copy.value());
+  ASSERT_EQ(1U, copy.labels().size());
+  EXPECT_EQ("l1", copy.labels()[0]);
+}
@@ -0,0 +1,107 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/channel_selection_policy.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/random.h"
+#include <random>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+std::unique_ptr<ChannelSelectionPolicy> DefaultChannelSelectionPolicy() {
+  return google::cloud::internal::make_unique<RoundRobinChannelSelection>();
+}
+
+std::unique_ptr<ChannelSelectionPolicy> RoundRobinChannelSelection::clone()
+    const {
+  return google::cloud::internal::make_unique<RoundRobinChannelSelection>();
+}
+
+std::size_t RoundRobinChannelSelection::Select(ChannelLoad const& channels) {
+  auto const size = channels.size();
+  auto const start = next_.fetch_add(1) % size;
+  for (std::size_t i = 0; i != size; ++i) {
+    auto const index = (start + i) % size;
+    if (channels.healthy(index)) {
+      return index;
+    }
+  }
+  // All the channels are unhealthy, there is nothing better to do.
+  return start;
+}
+
+std::unique_ptr<ChannelSelectionPolicy>
+LeastOutstandingRpcsChannelSelection::clone() const {
+  return google::cloud::internal::make_unique<
+      LeastOutstandingRpcsChannelSelection>();
+}
+
+std::size_t LeastOutstandingRpcsChannelSelection::Select(
+    ChannelLoad const& channels) {
+  auto const size = channels.size();
+  // Start at a different channel each time, so ties are broken in round-robin
+  // order.
+  auto const start = next_.fetch_add(1) % size;
+  auto best = start;
+  std::int64_t best_load = -1;
+  for (std::size_t i = 0; i != size; ++i) {
+    auto const index = (start + i) % size;
+    auto const load = channels.outstanding_rpcs(index);
+    if (best_load >= 0 && load >= best_load) {
+      continue;
+    }
+    if (!channels.healthy(index)) {
+      continue;
+    }
+    best = index;
+    best_load = load;
+  }
+  return best;
+}
+
+std::unique_ptr<ChannelSelectionPolicy>
+PowerOfTwoChoicesChannelSelection::clone() const {
+  return google::cloud::internal::make_unique<
+      PowerOfTwoChoicesChannelSelection>();
+}
+
+std::size_t PowerOfTwoChoicesChannelSelection::Select(
+    ChannelLoad const& channels) {
+  auto const size = channels.size();
+  if (size == 1) {
+    return 0;
+  }
+  // Each thread uses its own generator, so this policy needs no locks.
+  auto& generator = google::cloud::internal::ThreadLocalFastPRNG();
+  auto const a =
+      std::uniform_int_distribution<std::size_t>(0, size - 1)(generator);
+  // Pick a different channel for the second choice.
+  auto const b =
+      (a + 1 +
+       std::uniform_int_distribution<std::size_t>(0, size - 2)(generator)) %
+      size;
+  bool const a_healthy = channels.healthy(a);
+  bool const b_healthy = channels.healthy(b);
+  if (a_healthy != b_healthy) {
+    return a_healthy ? a : b;
+  }
+  return channels.outstanding_rpcs(b) < channels.outstanding_rpcs(a) ? b : a;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
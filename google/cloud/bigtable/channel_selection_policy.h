@@ -0,0 +1,128 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANNEL_SELECTION_POLICY_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANNEL_SELECTION_POLICY_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/// The load and state of a channel in the connection pool.
+struct ChannelStats {
+  /// The number of RPCs currently using the channel.
+  std::int64_t outstanding_rpcs;
+  /// The number of RPCs started on the channel since it was created.
+  std::uint64_t total_rpcs;
+  /// The connectivity state of the channel.
+  grpc_connectivity_state state;
+};
+
+/**
+ * The channels in a connection pool, as seen by a `ChannelSelectionPolicy`.
+ *
+ * Querying the health of a channel is more expensive than querying its load,
+ * policies should only check the health of the channels they consider.
+ */
+class ChannelLoad {
+ public:
+  virtual ~ChannelLoad() = default;
+
+  /// The number of channels in the pool, always greater than 0.
+  virtual std::size_t size() const = 0;
+
+  /// The number of RPCs currently using the channel at @p index.
+  virtual std::int64_t outstanding_rpcs(std::size_t index) const = 0;
+
+  /// Return false if the channel at @p index is failing or shut down.
+  virtual bool healthy(std::size_t index) const = 0;
+};
+
+/**
+ * Define the interface for selecting a channel from the connection pool.
+ *
+ * The client library calls `Select()` each time it starts an RPC. The policy
+ * should avoid channels that are not healthy, unless all channels are
+ * unhealthy. Implementations must be thread-safe.
+ *
+ * The application provides an instance of this class in the `ClientOptions`,
+ * each client uses `clone()` to create its own copy.
+ */
+class ChannelSelectionPolicy {
+ public:
+  virtual ~ChannelSelectionPolicy() = default;
+
+  /// Return a new copy of this object, with the same initial state.
+  virtual std::unique_ptr<ChannelSelectionPolicy> clone() const = 0;
+
+  /// Return the index of the channel for the next RPC.
+  virtual std::size_t Select(ChannelLoad const& channels) = 0;
+};
+
+/// Return the default channel selection policy, round-robin.
+std::unique_ptr<ChannelSelectionPolicy> DefaultChannelSelectionPolicy();
+
+/// Use the channels in order, skipping unhealthy channels.
+class RoundRobinChannelSelection : public ChannelSelectionPolicy {
+ public:
+  RoundRobinChannelSelection() : next_(0) {}
+
+  std::unique_ptr<ChannelSelectionPolicy> clone() const override;
+  std::size_t Select(ChannelLoad const& channels) override;
+
+ private:
+  std::atomic<std::size_t> next_;
+};
+
+/**
+ * Use the healthy channel with the fewest outstanding RPCs.
+ *
+ * Ties are broken in round-robin order. This policy examines every channel on
+ * each call, prefer `PowerOfTwoChoicesChannelSelection` for large pools.
+ */
+class LeastOutstandingRpcsChannelSelection : public ChannelSelectionPolicy {
+ public:
+  LeastOutstandingRpcsChannelSelection() : next_(0) {}
+
+  std::unique_ptr<ChannelSelectionPolicy> clone() const override;
+  std::size_t Select(ChannelLoad const& channels) override;
+
+ private:
+  std::atomic<std::size_t> next_;
+};
+
+/**
+ * Pick two channels at random and use the one with fewer outstanding RPCs.
+ *
+ * This approximates `LeastOutstandingRpcsChannelSelection` while examining
+ * only two channels on each call.
+ */
+class PowerOfTwoChoicesChannelSelection : public ChannelSelectionPolicy {
+ public:
+  std::unique_ptr<ChannelSelectionPolicy> clone() const override;
+  std::size_t Select(ChannelLoad const& channels) override;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHANNEL_SELECTION_POLICY_H_
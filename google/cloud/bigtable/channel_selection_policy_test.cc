@@ -0,0 +1,137 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/channel_selection_policy.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// A fake pool where the tests control the load and health of each channel.
+class FakeChannelLoad : public ChannelLoad {
+ public:
+  FakeChannelLoad(std::vector<std::int64_t> load, std::vector<bool> healthy)
+      : load_(std::move(load)), healthy_(std::move(healthy)) {}
+
+  std::size_t size() const override { return load_.size(); }
+  std::int64_t outstanding_rpcs(std::size_t index) const override {
+    return load_[index];
+  }
+  bool healthy(std::size_t index) const override { return healthy_[index]; }
+
+ private:
+  std::vector<std::int64_t> load_;
+  std::vector<bool> healthy_;
+};
+
+TEST(ChannelSelectionPolicyTest, RoundRobin) {
+  RoundRobinChannelSelection policy;
+  FakeChannelLoad channels({0, 0, 0}, {true, true, true});
+  EXPECT_EQ(0U, policy.Select(channels));
+  EXPECT_EQ(1U, policy.Select(channels));
+  EXPECT_EQ(2U, policy.Select(channels));
+  EXPECT_EQ(0U, policy.Select(channels));
+}
+
+TEST(ChannelSelectionPolicyTest, RoundRobinSkipsUnhealthy) {
+  RoundRobinChannelSelection policy;
+  FakeChannelLoad channels({0, 0, 0}, {true, false, true});
+  EXPECT_EQ(0U, policy.Select(channels));
+  EXPECT_EQ(2U, policy.Select(channels));
+  EXPECT_EQ(2U, policy.Select(channels));
+  EXPECT_EQ(0U, policy.Select(channels));
+}
+
+TEST(ChannelSelectionPolicyTest, RoundRobinAllUnhealthy) {
+  RoundRobinChannelSelection policy;
+  FakeChannelLoad channels({0, 0}, {false, false});
+  EXPECT_EQ(0U, policy.Select(channels));
+  EXPECT_EQ(1U, policy.Select(channels));
+}
+
+TEST(ChannelSelectionPolicyTest, LeastOutstandingRpcs) {
+  LeastOutstandingRpcsChannelSelection policy;
+  FakeChannelLoad channels({5, 2, 7, 3}, {true, true, true, true});
+  for (int i = 0; i != 8; ++i) {
+    EXPECT_EQ(1U, policy.Select(channels));
+  }
+}
+
+TEST(ChannelSelectionPolicyTest, LeastOutstandingRpcsSkipsUnhealthy) {
+  LeastOutstandingRpcsChannelSelection policy;
+  FakeChannelLoad channels({5, 2, 7, 3}, {true, false, true, true});
+  for (int i = 0; i != 8; ++i) {
+    EXPECT_EQ(3U, policy.Select(channels));
+  }
+}
+
+TEST(ChannelSelectionPolicyTest, LeastOutstandingRpcsBreaksTies) {
+  LeastOutstandingRpcsChannelSelection policy;
+  FakeChannelLoad channels({1, 1, 1}, {true, true, true});
+  EXPECT_EQ(0U, policy.Select(channels));
+  EXPECT_EQ(1U, policy.Select(channels));
+  EXPECT_EQ(2U, policy.Select(channels));
+}
+
+TEST(ChannelSelectionPolicyTest, PowerOfTwoChoices) {
+  PowerOfTwoChoicesChannelSelection policy;
+  // With two channels both are always considered, the least loaded wins.
+  FakeChannelLoad channels({5, 2}, {true, true});
+  for (int i = 0; i != 16; ++i) {
+    EXPECT_EQ(1U, policy.Select(channels));
+  }
+}
+
+TEST(ChannelSelectionPolicyTest, PowerOfTwoChoicesSkipsUnhealthy) {
+  PowerOfTwoChoicesChannelSelection policy;
+  FakeChannelLoad channels({0, 9}, {false, true});
+  for (int i = 0; i != 16; ++i) {
+    EXPECT_EQ(1U, policy.Select(channels));
+  }
+}
+
+TEST(ChannelSelectionPolicyTest, PowerOfTwoChoicesSpreadsLoad) {
+  PowerOfTwoChoicesChannelSelection policy;
+  FakeChannelLoad channels({0, 0, 0, 0}, {true, true, true, true});
+  std::vector<int> counts(4);
+  for (int i = 0; i != 1000; ++i) {
+    auto index = policy.Select(channels);
+    ASSERT_LT(index, counts.size());
+    ++counts[index];
+  }
+  for (auto c : counts) {
+    EXPECT_LT(0, c);
+  }
+}
+
+TEST(ChannelSelectionPolicyTest, Clone) {
+  LeastOutstandingRpcsChannelSelection original;
+  auto clone = original.clone();
+  FakeChannelLoad channels({3, 1}, {true, true});
+  EXPECT_EQ(1U, clone->Select(channels));
+
+  auto policy = DefaultChannelSelectionPolicy();
+  FakeChannelLoad single({0}, {true});
+  EXPECT_EQ(0U, policy->Select(single));
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
 #include "google/cloud/internal/build_info.h"
 #include "google/cloud/internal/getenv.h"
+#include <algorithm>
 #include <thread>
 
 namespace {
@@ -46,6 +47,16 @@ inline std::size_t CalculateDefaultConnectionPoolSize() {
 ClientOptions::ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds)
     : credentials_(std::move(creds)),
       connection_pool_size_(CalculateDefaultConnectionPoolSize()),
+      min_connection_pool_size_(0),
+      max_connection_pool_size_(0),
+      target_outstanding_rpcs_per_channel_(
+          BIGTABLE_CLIENT_DEFAULT_TARGET_OUTSTANDING_RPCS_PER_CHANNEL),
+      max_channel_age_(0),
+      channel_pool_maintenance_period_(std::chrono::seconds(1)),
+      connection_pool_prewarm_timeout_(0),
+      channel_selection_policy_(DefaultChannelSelectionPolicy()),
+      background_thread_pool_size_(0),
+      pin_background_threads_(false),
       data_endpoint_("bigtable.googleapis.com"),
       admin_endpoint_("bigtableadmin.googleapis.com"),
       instance_admin_endpoint_("bigtableadmin.googleapis.com") {
@@ -81,6 +92,20 @@ ClientOptions& ClientOptions::set_connection_pool_size(std::size_t size) {
   return *this;
 }
 
+std::size_t ClientOptions::min_connection_pool_size() const {
+  if (min_connection_pool_size_ == 0) {
+    return connection_pool_size_;
+  }
+  return min_connection_pool_size_;
+}
+
+std::size_t ClientOptions::max_connection_pool_size() const {
+  if (max_connection_pool_size_ == 0) {
+    return std::max(connection_pool_size_, min_connection_pool_size());
+  }
+  return std::max(max_connection_pool_size_, min_connection_pool_size());
+}
+
 std::string ClientOptions::UserAgentPrefix() {
   std::string agent = "cbt-c++/" + version_string();
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
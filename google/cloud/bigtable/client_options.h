@@ -15,15 +15,22 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CLIENT_OPTIONS_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CLIENT_OPTIONS_H_
 
+#include "google/cloud/bigtable/channel_selection_policy.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/status.h"
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/resource_quota.h>
+#include <chrono>
+#include <functional>
+#include <memory>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+class BackgroundThreads;
+class RetryBudget;
+
 /**
  * Configuration options for the Bigtable Client.
  *
@@ -116,6 +123,174 @@ class ClientOptions {
 
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /**
+   * Let the connection pool grow and shrink between @p min_size and
+   * @p max_size channels.
+   *
+   * By default the pool has exactly `connection_pool_size()` channels. With
+   * different bounds the client adds channels when the outstanding RPCs per
+   * channel exceed `target_outstanding_rpcs_per_channel()`, and removes them,
+   * one at a time, when the load drops. The initial size of the pool is
+   * `connection_pool_size()` clamped to these bounds. Specifying 0 for either
+   * bound uses `connection_pool_size()`.
+   */
+  ClientOptions& set_connection_pool_size_bounds(std::size_t min_size,
+                                                 std::size_t max_size) {
+    min_connection_pool_size_ = min_size;
+    max_connection_pool_size_ = max_size;
+    return *this;
+  }
+  /// Return the minimum size of the connection pool.
+  std::size_t min_connection_pool_size() const;
+  /// Return the maximum size of the connection pool.
+  std::size_t max_connection_pool_size() const;
+
+  /**
+   * Set the load that makes a resizable connection pool grow.
+   *
+   * The pool is sized to keep, on average, at most @p count outstanding RPCs
+   * on each channel. Each HTTP/2 connection typically allows 100 concurrent
+   * streams. Specifying 0 disables load-based resizing.
+   */
+  ClientOptions& set_target_outstanding_rpcs_per_channel(std::size_t count) {
+    target_outstanding_rpcs_per_channel_ = count;
+    return *this;
+  }
+  /// Return the target number of outstanding RPCs per channel.
+  std::size_t target_outstanding_rpcs_per_channel() const {
+    return target_outstanding_rpcs_per_channel_;
+  }
+
+  /**
+   * Replace the channels in the pool once they are older than @p age.
+   *
+   * Long-lived channels stay connected to the same frontends, refreshing them
+   * spreads the load as the service rebalances. The replacement channel is
+   * connected before it takes over, the RPCs using the old channel run to
+   * completion. Specifying 0 disables the refresh, this is the default.
+   */
+  ClientOptions& set_max_channel_age(std::chrono::milliseconds age) {
+    max_channel_age_ = age;
+    return *this;
+  }
+  /// Return the maximum age of the channels, 0 if they are never refreshed.
+  std::chrono::milliseconds max_channel_age() const { return max_channel_age_; }
+
+  /**
+   * Set how often the client resizes and refreshes the connection pool.
+   *
+   * The maintenance runs in the thread making an RPC, at most once per
+   * @p period, and never waits for a channel to connect.
+   */
+  ClientOptions& set_channel_pool_maintenance_period(
+      std::chrono::milliseconds period) {
+    channel_pool_maintenance_period_ = period;
+    return *this;
+  }
+  /// Return how often the connection pool is resized and refreshed.
+  std::chrono::milliseconds channel_pool_maintenance_period() const {
+    return channel_pool_maintenance_period_;
+  }
+
+  /**
+   * Connect all the channels in the pool when the client is created.
+   *
+   * By default each channel connects when it is first used, so the first RPCs
+   * on each channel pay for the TCP, TLS and HTTP/2 setup. With a non-zero
+   * @p timeout the client constructor creates the pool and blocks until all
+   * the channels are connected, or until @p timeout expires. Channels that are
+   * not connected by then keep connecting in the background.
+   */
+  ClientOptions& set_connection_pool_prewarm_timeout(
+      std::chrono::milliseconds timeout) {
+    connection_pool_prewarm_timeout_ = timeout;
+    return *this;
+  }
+  /// Return how long to wait for the pool to connect, 0 if it connects lazily.
+  std::chrono::milliseconds connection_pool_prewarm_timeout() const {
+    return connection_pool_prewarm_timeout_;
+  }
+
+  /**
+   * Set the policy to select a channel from the connection pool for each RPC.
+   *
+   * The default policy is round-robin, skipping unhealthy channels. Workloads
+   * mixing long scans with short RPCs may prefer
+   * `LeastOutstandingRpcsChannelSelection` or
+   * `PowerOfTwoChoicesChannelSelection`.
+   */
+  ClientOptions& set_channel_selection_policy(
+      ChannelSelectionPolicy const& policy) {
+    channel_selection_policy_ = policy.clone();
+    return *this;
+  }
+  /// Return a new copy of the channel selection policy.
+  std::unique_ptr<ChannelSelectionPolicy> channel_selection_policy() const {
+    return channel_selection_policy_->clone();
+  }
+
+  /**
+   * Set the number of background threads created by the client.
+   *
+   * The client creates these threads, on first use, to run asynchronous
+   * operations when the application does not provide a `CompletionQueue`.
+   * Specifying 0 for @p size uses one thread per core.
+   */
+  ClientOptions& set_background_thread_pool_size(std::size_t size) {
+    background_thread_pool_size_ = size;
+    return *this;
+  }
+  /// Return the number of background threads, 0 means one per core.
+  std::size_t background_thread_pool_size() const {
+    return background_thread_pool_size_;
+  }
+
+  /// Pin each background thread to a different core, if supported.
+  ClientOptions& set_pin_background_threads(bool pin) {
+    pin_background_threads_ = pin;
+    return *this;
+  }
+  /// Return true if the background threads are pinned to cores.
+  bool pin_background_threads() const { return pin_background_threads_; }
+
+  /// The type of the functions that create background threads.
+  using BackgroundThreadsFactory =
+      std::function<std::unique_ptr<BackgroundThreads>()>;
+
+  /**
+   * Use @p factory to create the background threads.
+   *
+   * Applications that already run a `CompletionQueue` can use this to share
+   * it with the client. If the factory is not set the client creates an
+   * `AutomaticallyCreatedBackgroundThreads` configured with
+   * `background_thread_pool_size()` and `pin_background_threads()`.
+   */
+  ClientOptions& set_background_threads_factory(
+      BackgroundThreadsFactory factory) {
+    background_threads_factory_ = std::move(factory);
+    return *this;
+  }
+  /// Return the factory for background threads, it may be empty.
+  BackgroundThreadsFactory const& background_threads_factory() const {
+    return background_threads_factory_;
+  }
+
+  /**
+   * Limit the retries of all the operations using the client.
+   *
+   * Each `Table` created with the client applies @p budget to its retry
+   * policy, see `RetryBudget` for details. By default there is no budget, each
+   * operation retries as allowed by its own retry policy.
+   */
+  ClientOptions& set_retry_budget(std::shared_ptr<RetryBudget> budget) {
+    retry_budget_ = std::move(budget);
+    return *this;
+  }
+  /// Return the retry budget shared by the operations, it may be null.
+  std::shared_ptr<RetryBudget> const& retry_budget() const {
+    return retry_budget_;
+  }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -299,6 +474,17 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  std::size_t min_connection_pool_size_;
+  std::size_t max_connection_pool_size_;
+  std::size_t target_outstanding_rpcs_per_channel_;
+  std::chrono::milliseconds max_channel_age_;
+  std::chrono::milliseconds channel_pool_maintenance_period_;
+  std::chrono::milliseconds connection_pool_prewarm_timeout_;
+  std::shared_ptr<ChannelSelectionPolicy const> channel_selection_policy_;
+  std::size_t background_thread_pool_size_;
+  bool pin_background_threads_;
+  BackgroundThreadsFactory background_threads_factory_;
+  std::shared_ptr<RetryBudget> retry_budget_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
   // The endpoint for instance admin operations, in most scenarios this should
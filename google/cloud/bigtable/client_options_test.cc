@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/client_options.h"
+#include "google/cloud/bigtable/background_threads.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
+#include "google/cloud/bigtable/retry_budget.h"
 #include "google/cloud/internal/setenv.h"
 #include "google/cloud/status.h"
 #include "google/cloud/testing_util/assert_ok.h"
@@ -324,6 +326,78 @@ TEST(ClientOptionsTest, UserAgentPrefix) {
   EXPECT_THAT(actual, ::testing::AnyOf(HasSubstr(" noex "), HasSubstr(" ex ")));
 }
 
+TEST(ClientOptionsTest, BackgroundThreads) {
+  auto client_options_object = bigtable::ClientOptions();
+  EXPECT_EQ(0U, client_options_object.background_thread_pool_size());
+  EXPECT_FALSE(client_options_object.pin_background_threads());
+  EXPECT_FALSE(client_options_object.background_threads_factory());
+
+  client_options_object.set_background_thread_pool_size(3)
+      .set_pin_background_threads(true)
+      .set_background_threads_factory(
+          [] { return std::unique_ptr<BackgroundThreads>(); });
+  EXPECT_EQ(3U, client_options_object.background_thread_pool_size());
+  EXPECT_TRUE(client_options_object.pin_background_threads());
+  EXPECT_TRUE(client_options_object.background_threads_factory());
+}
+
+TEST(ClientOptionsTest, ChannelSelectionPolicy) {
+  auto client_options_object = bigtable::ClientOptions();
+  EXPECT_TRUE(client_options_object.channel_selection_policy());
+
+  client_options_object.set_channel_selection_policy(
+      LeastOutstandingRpcsChannelSelection());
+  auto policy = client_options_object.channel_selection_policy();
+  ASSERT_TRUE(policy);
+  EXPECT_NE(nullptr,
+            dynamic_cast<LeastOutstandingRpcsChannelSelection*>(policy.get()));
+}
+
+TEST(ClientOptionsTest, ConnectionPoolSizeBounds) {
+  auto client_options_object = bigtable::ClientOptions();
+  client_options_object.set_connection_pool_size(3);
+  EXPECT_EQ(3U, client_options_object.min_connection_pool_size());
+  EXPECT_EQ(3U, client_options_object.max_connection_pool_size());
+  EXPECT_EQ(0, client_options_object.max_channel_age().count());
+
+  client_options_object.set_connection_pool_size_bounds(2, 8);
+  EXPECT_EQ(2U, client_options_object.min_connection_pool_size());
+  EXPECT_EQ(8U, client_options_object.max_connection_pool_size());
+
+  // The maximum is never smaller than the minimum.
+  client_options_object.set_connection_pool_size_bounds(4, 2);
+  EXPECT_EQ(4U, client_options_object.min_connection_pool_size());
+  EXPECT_EQ(4U, client_options_object.max_connection_pool_size());
+}
+
+TEST(ClientOptionsTest, ChannelRefresh) {
+  auto client_options_object = bigtable::ClientOptions();
+  client_options_object.set_max_channel_age(std::chrono::minutes(30))
+      .set_channel_pool_maintenance_period(std::chrono::seconds(5))
+      .set_target_outstanding_rpcs_per_channel(20);
+  EXPECT_EQ(std::chrono::minutes(30), client_options_object.max_channel_age());
+  EXPECT_EQ(std::chrono::seconds(5),
+            client_options_object.channel_pool_maintenance_period());
+  EXPECT_EQ(20U, client_options_object.target_outstanding_rpcs_per_channel());
+}
+
+TEST(ClientOptionsTest, ConnectionPoolPrewarmTimeout) {
+  auto client_options_object = bigtable::ClientOptions();
+  EXPECT_EQ(0, client_options_object.connection_pool_prewarm_timeout().count());
+  client_options_object.set_connection_pool_prewarm_timeout(
+      std::chrono::seconds(3));
+  EXPECT_EQ(std::chrono::seconds(3),
+            client_options_object.connection_pool_prewarm_timeout());
+}
+
+TEST(ClientOptionsTest, RetryBudget) {
+  auto client_options_object = bigtable::ClientOptions();
+  EXPECT_FALSE(client_options_object.retry_budget());
+  auto budget = std::make_shared<bigtable::RetryBudget>(0.2);
+  client_options_object.set_retry_budget(budget);
+  EXPECT_EQ(budget, client_options_object.retry_budget());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -38,19 +38,17 @@ namespace {
  */
 class AsyncTimerFuture : public internal::AsyncGrpcOperation {
  public:
-  AsyncTimerFuture(std::unique_ptr<grpc::Alarm> alarm)
-      : alarm_(std::move(alarm)) {}
+  AsyncTimerFuture(std::chrono::system_clock::time_point deadline,
+                   std::unique_ptr<grpc::Alarm> alarm)
+      : deadline_(deadline), alarm_(std::move(alarm)) {}
 
   future<std::chrono::system_clock::time_point> GetFuture() {
     return promise_.get_future();
   }
 
-  void Set(grpc::CompletionQueue& cq,
-           std::chrono::system_clock::time_point deadline, void* tag) {
-    deadline_ = deadline;
-
+  void Set(grpc::CompletionQueue& cq, void* tag) {
     if (alarm_) {
-      alarm_->Set(&cq, deadline, tag);
+      alarm_->Set(&cq, deadline_, tag);
     }
   }
 
@@ -76,17 +74,22 @@ class AsyncTimerFuture : public internal::AsyncGrpcOperation {
 
 CompletionQueue::CompletionQueue() : impl_(new internal::CompletionQueueImpl) {}
 
+CompletionQueue::CompletionQueue(std::size_t num_queues)
+    : impl_(new internal::CompletionQueueImpl(num_queues)) {}
+
 void CompletionQueue::Run() { impl_->Run(*this); }
 
-void CompletionQueue::Shutdown() { impl_->Shutdown(); }
+void CompletionQueue::Shutdown() { impl_->Shutdown(*this); }
 
 google::cloud::future<std::chrono::system_clock::time_point>
 CompletionQueue::MakeDeadlineTimer(
     std::chrono::system_clock::time_point deadline) {
-  auto op = std::make_shared<AsyncTimerFuture>(impl_->CreateAlarm());
-  void* tag = impl_->RegisterOperation(op);
-  op->Set(impl_->cq(), deadline, tag);
-  return op->GetFuture();
+  auto op = std::make_shared<AsyncTimerFuture>(deadline, impl_->CreateAlarm());
+  auto f = op->GetFuture();
+  impl_->StartOperation(*this, op, [&op](grpc::CompletionQueue& cq, void* tag) {
+    op->Set(cq, tag);
+  });
+  return f;
 }
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -30,18 +30,49 @@ inline namespace BIGTABLE_CLIENT_NS {
 class CompletionQueue {
  public:
   CompletionQueue();
+
+  /**
+   * Create a completion queue backed by @p num_queues gRPC completion queues.
+   *
+   * Each thread calling `Run()` serves one of the underlying queues, and
+   * operations started from a callback run in the same thread complete in that
+   * thread too. This avoids contention between threads running the event loop,
+   * but the application must call `Run()` from at least @p num_queues threads.
+   */
+  explicit CompletionQueue(std::size_t num_queues);
+
   explicit CompletionQueue(std::shared_ptr<internal::CompletionQueueImpl> impl)
       : impl_(std::move(impl)) {}
 
+  /**
+   * Create a copy of @p cq that also keeps @p owner alive.
+   *
+   * Queues run by background threads use this, so the threads keep running
+   * while the application, or an operation, holds a copy of the queue.
+   */
+  CompletionQueue(CompletionQueue const& cq, std::shared_ptr<void> owner)
+      : impl_(cq.impl_), owner_(std::move(owner)) {}
+
   /**
    * Run the completion queue event loop.
    *
    * Note that more than one thread can call this member function, to create a
-   * pool of threads completing asynchronous operations.
+   * pool of threads completing asynchronous operations. If the completion queue
+   * was created with several underlying queues, each thread is assigned one of
+   * them in round-robin order.
    */
   void Run();
 
-  /// Terminate the completion queue event loop.
+  /**
+   * Terminate the completion queue event loop.
+   *
+   * Any pending operations are cancelled and the threads blocked in `Run()`
+   * return promptly. The callbacks for the cancelled operations are called from
+   * those threads, reporting the cancellation. Operations started after
+   * calling this function, including from those callbacks, are not started at
+   * all: they are cancelled right away and their callbacks (or futures) are
+   * notified in the calling thread.
+   */
   void Shutdown();
 
   /**
@@ -107,9 +138,12 @@ class CompletionQueue {
       std::unique_ptr<grpc::ClientContext> context) {
     auto op =
         std::make_shared<internal::AsyncUnaryRpcFuture<Request, Response>>();
-    void* tag = impl_->RegisterOperation(op);
-    op->Start(async_call, std::move(context), request, &impl_->cq(), tag);
-    return op->GetFuture();
+    auto f = op->GetFuture();
+    impl_->StartOperation(
+        *this, op, [&](grpc::CompletionQueue& cq, void* tag) {
+          op->Start(async_call, std::move(context), request, &cq, tag);
+        });
+    return f;
   }
 
   //@{
@@ -136,9 +170,9 @@ class CompletionQueue {
   std::shared_ptr<AsyncOperation> MakeDeadlineTimer(
       std::chrono::system_clock::time_point deadline, Functor&& functor) {
     auto op = std::make_shared<internal::AsyncTimerFunctor<Functor>>(
-        std::forward<Functor>(functor), impl_->CreateAlarm());
-    void* tag = impl_->RegisterOperation(op);
-    op->Set(impl_->cq(), deadline, tag);
+        std::forward<Functor>(functor), deadline, impl_->CreateAlarm());
+    impl_->StartOperation(*this, op, [&](grpc::CompletionQueue& cq,
+                                         void* tag) { op->Set(cq, tag); });
     return op;
   }
 
@@ -218,8 +252,10 @@ class CompletionQueue {
     auto op = std::make_shared<internal::AsyncUnaryRpcFunctor<
         typename Sig::RequestType, typename Sig::ResponseType, Functor>>(
         std::forward<Functor>(f));
-    void* tag = impl_->RegisterOperation(op);
-    op->Set(client, call, std::move(context), request, &impl_->cq(), tag);
+    impl_->StartOperation(
+        *this, op, [&](grpc::CompletionQueue& cq, void* tag) {
+          op->Set(client, call, std::move(context), request, &cq, tag);
+        });
     return op;
   }
 
@@ -247,6 +283,9 @@ class CompletionQueue {
    *         DataFunctor, CompletionQueue&, const grpc::ClientContext&,
    *         ResponseType&>)
    *     @endcode
+   *     If the callback returns `future<bool>` the next response is not
+   *     requested until that future is satisfied, and a `false` value cancels
+   *     the stream.
    * @tparam FinishedFunctor the type of the callback provided by the
    *     application. It must satisfy (using C++17 classes):
    *     @code
@@ -285,8 +324,10 @@ class CompletionQueue {
         typename Sig::RequestType, typename Sig::ResponseType, DataFunctor,
         FinishedFunctor>>(std::forward<DataFunctor>(data_functor),
                           std::forward<FinishedFunctor>(finished_functor));
-    void* tag = impl_->RegisterOperation(op);
-    op->Set(client, call, std::move(context), request, &impl_->cq(), tag);
+    impl_->StartOperation(
+        *this, op, [&](grpc::CompletionQueue& cq, void* tag) {
+          op->Set(client, call, std::move(context), request, &cq, tag);
+        });
     return op;
   }
 
@@ -314,7 +355,9 @@ class CompletionQueue {
   }
 
  private:
+  friend class internal::AsyncGrpcOperation;
   std::shared_ptr<internal::CompletionQueueImpl> impl_;
+  std::shared_ptr<void> owner_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -22,6 +22,11 @@
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <gmock/gmock.h>
 #include <future>
+#include <thread>
+#if defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#endif  // defined(__linux__)
 
 using namespace google::cloud::testing_util::chrono_literals;
 namespace btproto = google::bigtable::v2;
@@ -418,6 +423,262 @@ TEST(CompletionQueueTest, AsyncRpcStreamNotCreated) {
   EXPECT_TRUE(completion_called);
 }
 
+/// @test Verify that Shutdown() completes a stream paused by the application.
+TEST(CompletionQueueTest, AsyncRpcStreamShutdownWhilePaused) {
+  MockClient client;
+
+  MockClientAsyncReaderInterface<btproto::MutateRowsResponse>* reader =
+      new MockClientAsyncReaderInterface<btproto::MutateRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::MutateRowsResponse>>
+      reader_deleter(reader);
+
+  // Only the first response is requested, the stream must not be resumed after
+  // Shutdown().
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r, void*) {
+        r->add_entries()->set_index(0);
+      }));
+  EXPECT_CALL(*reader, Finish(_, _)).Times(0);
+
+  EXPECT_CALL(client, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::MutateRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  auto impl = std::make_shared<testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  btproto::MutateRowsRequest request;
+  auto context = google::cloud::internal::make_unique<grpc::ClientContext>();
+
+  promise<bool> more;
+  int data_count = 0;
+  grpc::StatusCode finished_status = grpc::StatusCode::OK;
+  int finished_count = 0;
+  auto op = cq.MakeUnaryStreamRpc(
+      client, &MockClient::AsyncMutateRows, request, std::move(context),
+      [&more, &data_count](CompletionQueue&, const grpc::ClientContext&,
+                           btproto::MutateRowsResponse&) {
+        ++data_count;
+        return more.get_future();
+      },
+      [&finished_status, &finished_count](CompletionQueue&,
+                                          grpc::ClientContext&,
+                                          grpc::Status& status) {
+        finished_status = status.error_code();
+        ++finished_count;
+      });
+  impl->SimulateCompletion(cq, op.get(), true);  // the stream is created
+  impl->SimulateCompletion(cq, op.get(), true);  // the first response
+  EXPECT_EQ(1, data_count);
+  EXPECT_EQ(0, finished_count);
+
+  // The application holds the future, there is no pending Read(), yet
+  // Shutdown() must complete the stream.
+  cq.Shutdown();
+  EXPECT_EQ(1, finished_count);
+  EXPECT_EQ(grpc::StatusCode::CANCELLED, finished_status);
+  EXPECT_TRUE(impl->empty());
+
+  // Resuming the stream later does not touch the reader.
+  more.set_value(true);
+  EXPECT_EQ(1, data_count);
+  EXPECT_EQ(1, finished_count);
+}
+
+/// @test Verify that a completion queue with several queues runs all timers.
+TEST(CompletionQueueTest, MultipleQueuesLifeCycle) {
+  int const queue_count = 4;
+  CompletionQueue cq(queue_count);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != queue_count; ++i) {
+    threads.emplace_back([&cq]() { cq.Run(); });
+  }
+
+  int const timer_count = 100;
+  std::vector<future<void>> timers;
+  for (int i = 0; i != timer_count; ++i) {
+    timers.emplace_back(cq.MakeRelativeTimer(2_ms).then(
+        [](future<std::chrono::system_clock::time_point>) {}));
+  }
+  for (auto& f : timers) {
+    EXPECT_EQ(std::future_status::ready, f.wait_for(500_ms));
+  }
+
+  cq.Shutdown();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+/// @test Verify operations started from a callback complete in the same thread.
+TEST(CompletionQueueTest, MultipleQueuesAffinity) {
+  int const queue_count = 4;
+  CompletionQueue cq(queue_count);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != queue_count; ++i) {
+    threads.emplace_back([&cq]() { cq.Run(); });
+  }
+
+  promise<std::pair<std::thread::id, std::thread::id>> done;
+  cq.MakeRelativeTimer(2_ms).then(
+      [&cq, &done](future<std::chrono::system_clock::time_point>) {
+        auto first = std::this_thread::get_id();
+        cq.MakeRelativeTimer(2_ms).then(
+            [&done, first](future<std::chrono::system_clock::time_point>) {
+              done.set_value(std::make_pair(first, std::this_thread::get_id()));
+            });
+      });
+
+  auto f = done.get_future();
+  ASSERT_EQ(std::future_status::ready, f.wait_for(500_ms));
+  auto ids = f.get();
+  EXPECT_EQ(ids.first, ids.second);
+
+  cq.Shutdown();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+/// @test Verify that Shutdown() does not wait for pending timers.
+TEST(CompletionQueueTest, ShutdownLatency) {
+  CompletionQueue cq;
+
+  std::thread t([&cq]() { cq.Run(); });
+
+  // Make sure the thread is blocked in Run() before shutting down.
+  promise<void> running;
+  cq.RunAsync([&running](CompletionQueue&) { running.set_value(); });
+  running.get_future().get();
+
+  // Shutdown() must not wait for this timer to expire.
+  auto timer = cq.MakeRelativeTimer(1_h);
+
+  auto start = std::chrono::steady_clock::now();
+  cq.Shutdown();
+  t.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, 500_ms);
+}
+
+#if defined(__linux__)
+/// Return the CPU time consumed by @p t.
+std::chrono::nanoseconds ThreadCpuTime(std::thread& t) {
+  clockid_t clock;
+  if (pthread_getcpuclockid(t.native_handle(), &clock) != 0) {
+    ADD_FAILURE() << "cannot get the CPU clock for a thread";
+    return std::chrono::nanoseconds(0);
+  }
+  timespec ts;
+  clock_gettime(clock, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/// @test Verify that idle threads in Run() do not consume CPU.
+TEST(CompletionQueueTest, IdleCpu) {
+  int const queue_count = 8;
+  CompletionQueue cq(queue_count);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != queue_count; ++i) {
+    threads.emplace_back([&cq]() { cq.Run(); });
+  }
+  // Let the threads reach Run() before measuring.
+  std::this_thread::sleep_for(50_ms);
+
+  // Only count the CPU time used by the runner threads, so other activity in
+  // the process (or the machine) does not affect the result.
+  auto cpu_used = [&threads] {
+    std::chrono::nanoseconds total(0);
+    for (auto& t : threads) {
+      total += ThreadCpuTime(t);
+    }
+    return total;
+  };
+  auto const cpu_start = cpu_used();
+  std::this_thread::sleep_for(500_ms);
+  auto const idle_cpu = cpu_used() - cpu_start;
+  // A polling loop would burn most of the interval, a blocked loop uses
+  // virtually nothing.
+  EXPECT_LT(idle_cpu, 100_ms);
+
+  cq.Shutdown();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+#endif  // defined(__linux__)
+
+/// @test Verify that Shutdown() notifies the cancelled operations.
+TEST(CompletionQueueTest, ShutdownNotifiesCancelled) {
+  CompletionQueue cq;
+
+  std::thread t([&cq]() { cq.Run(); });
+
+  promise<bool> cancelled;
+  cq.MakeRelativeTimer(1_h, [&cancelled](CompletionQueue&,
+                                         AsyncTimerResult& result) {
+    cancelled.set_value(result.cancelled);
+  });
+
+  cq.Shutdown();
+  t.join();
+  auto f = cancelled.get_future();
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_TRUE(f.get());
+}
+
+/// @test Verify that operations started after Shutdown() fail immediately.
+TEST(CompletionQueueTest, ShutdownRejectsNewOperations) {
+  MockClient client;
+  EXPECT_CALL(client, AsyncGetTable(_, _, _)).Times(0);
+  EXPECT_CALL(client, AsyncMutateRows(_, _, _, _)).Times(0);
+
+  CompletionQueue cq;
+  std::thread t([&cq]() { cq.Run(); });
+  cq.Shutdown();
+  t.join();
+
+  bool cancelled = false;
+  cq.MakeRelativeTimer(1_h, [&cancelled](CompletionQueue&,
+                                         AsyncTimerResult& result) {
+    cancelled = result.cancelled;
+  });
+  EXPECT_TRUE(cancelled);
+
+  auto timer = cq.MakeRelativeTimer(1_h);
+  EXPECT_TRUE(timer.is_ready());
+
+  btadmin::GetTableRequest get_request;
+  auto unary = cq.MakeUnaryRpc(
+      [&client](grpc::ClientContext* context,
+                btadmin::GetTableRequest const& request,
+                grpc::CompletionQueue* cq) {
+        return client.AsyncGetTable(context, request, cq);
+      },
+      get_request, google::cloud::internal::make_unique<grpc::ClientContext>());
+  ASSERT_TRUE(unary.is_ready());
+  EXPECT_EQ(StatusCode::kCancelled, unary.get().status().code());
+
+  btproto::MutateRowsRequest mutate_request;
+  grpc::StatusCode stream_status = grpc::StatusCode::OK;
+  cq.MakeUnaryStreamRpc(
+      client, &MockClient::AsyncMutateRows, mutate_request,
+      google::cloud::internal::make_unique<grpc::ClientContext>(),
+      [](CompletionQueue&, const grpc::ClientContext&,
+         btproto::MutateRowsResponse&) { ADD_FAILURE(); },
+      [&stream_status](CompletionQueue&, grpc::ClientContext&,
+                       grpc::Status& status) {
+        stream_status = status.error_code();
+      });
+  EXPECT_EQ(grpc::StatusCode::CANCELLED, stream_status);
+}
+
 TEST(CompletionQueueTest, Noop) {
   bigtable::CompletionQueue cq;
 
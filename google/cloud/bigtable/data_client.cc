@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/internal/leased_reader.h"
 
 namespace btproto = google::bigtable::v2;
 
@@ -44,6 +45,7 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
+        retry_budget_(options.retry_budget()),
         impl_(std::move(options)) {}
 
   DefaultDataClient(std::string project, std::string instance)
@@ -56,6 +58,23 @@ class DefaultDataClient : public DataClient {
   std::shared_ptr<grpc::Channel> Channel() override { return impl_.Channel(); }
   void reset() override { impl_.reset(); }
 
+  std::shared_ptr<bigtable::BackgroundThreads> BackgroundThreads() override {
+    return impl_.BackgroundThreads();
+  }
+
+  std::vector<ChannelStats> GetChannelStats() override {
+    return impl_.GetChannelStats();
+  }
+
+  void ResizeConnectionPool(std::size_t min_size,
+                            std::size_t max_size) override {
+    impl_.ResizeConnectionPool(min_size, max_size);
+  }
+
+  std::shared_ptr<RetryBudget> GetRetryBudget() override {
+    return retry_budget_;
+  }
+
   grpc::Status MutateRow(grpc::ClientContext* context,
                          btproto::MutateRowRequest const& request,
                          btproto::MutateRowResponse* response) override {
@@ -67,7 +86,9 @@ class DefaultDataClient : public DataClient {
   AsyncMutateRow(grpc::ClientContext* context,
                  btproto::MutateRowRequest const& request,
                  grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncMutateRow(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncMutateRow(context, request, cq), stub);
   }
 
   grpc::Status CheckAndMutateRow(
@@ -83,7 +104,9 @@ class DefaultDataClient : public DataClient {
       grpc::ClientContext* context,
       const google::bigtable::v2::CheckAndMutateRowRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCheckAndMutateRow(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncCheckAndMutateRow(context, request, cq), stub);
   }
 
   grpc::Status ReadModifyWriteRow(
@@ -99,26 +122,33 @@ class DefaultDataClient : public DataClient {
       grpc::ClientContext* context,
       google::bigtable::v2::ReadModifyWriteRowRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncReadModifyWriteRow(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncReadModifyWriteRow(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            btproto::ReadRowsRequest const& request) override {
-    return impl_.Stub()->ReadRows(context, request);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(stub->ReadRows(context, request), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
                 grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncReadRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncReadRows(context, request, cq, tag), stub);
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
   SampleRowKeys(grpc::ClientContext* context,
                 btproto::SampleRowKeysRequest const& request) override {
-    return impl_.Stub()->SampleRowKeys(context, request);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(stub->SampleRowKeys(context, request),
+                                      stub);
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
@@ -126,28 +156,38 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       const ::google::bigtable::v2::SampleRowKeysRequest& request,
       ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncSampleRowKeys(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncSampleRowKeys(context, request, cq, tag), stub);
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              btproto::MutateRowsRequest const& request) override {
-    return impl_.Stub()->MutateRows(context, request);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(stub->MutateRows(context, request), stub);
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
                   const ::google::bigtable::v2::MutateRowsRequest& request,
                   ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncMutateRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncMutateRows(context, request, cq, tag), stub);
   }
 
  private:
   std::string project_;
   std::string instance_;
+  std::shared_ptr<RetryBudget> retry_budget_;
   Impl impl_;
 };
 
+std::shared_ptr<BackgroundThreads> DataClient::BackgroundThreads() {
+  return internal::DefaultBackgroundThreads();
+}
+
 std::string const& DefaultDataClient::project_id() const { return project_; }
 
 std::string const& DefaultDataClient::instance_id() const { return instance_; }
@@ -15,8 +15,11 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_DATA_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_DATA_CLIENT_H_
 
+#include "google/cloud/bigtable/background_threads.h"
+#include "google/cloud/bigtable/channel_selection_policy.h"
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/internal/completion_queue_impl.h"
+#include "google/cloud/bigtable/retry_budget.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/version.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
@@ -32,6 +35,7 @@ class Table;
 }  // namespace noex
 namespace internal {
 class AsyncBulkMutator;
+class AsyncReadRowsFuture;
 class AsyncSampleRowKeys;
 class BulkMutator;
 template <typename ReadRowCallback,
@@ -84,6 +88,43 @@ class DataClient {
    */
   virtual void reset() = 0;
 
+  /**
+   * Return the threads running asynchronous operations for this client.
+   *
+   * Applications that do not want to create and run their own
+   * `CompletionQueue` can use the queue from these threads. The default
+   * implementation returns a pool shared by the whole process, the clients
+   * created with `ClientOptions` create their own pool on first use.
+   */
+  virtual std::shared_ptr<bigtable::BackgroundThreads> BackgroundThreads();
+
+  /**
+   * Return the load and state of each channel in the connection pool.
+   *
+   * The default implementation returns an empty vector, for clients that do
+   * not use a connection pool.
+   */
+  virtual std::vector<ChannelStats> GetChannelStats() { return {}; }
+
+  /**
+   * Change the bounds of the connection pool while the client is in use.
+   *
+   * The pool grows or shrinks towards the new bounds, and then follows the
+   * load as configured by `ClientOptions::set_connection_pool_size_bounds()`.
+   * New channels are only used once they are connected. The default
+   * implementation does nothing, for clients that do not use a connection pool.
+   */
+  virtual void ResizeConnectionPool(std::size_t min_size,
+                                    std::size_t max_size) {}
+
+  /**
+   * Return the retry budget shared by the operations using this client.
+   *
+   * The default implementation returns null, the operations retry as allowed
+   * by their own retry policy.
+   */
+  virtual std::shared_ptr<RetryBudget> GetRetryBudget() { return {}; }
+
   // The member functions of this class are not intended for general use by
   // application developers (they are simply a dependency injection point). Make
   // them protected, so the mock classes can override them, and then make the
@@ -92,6 +133,7 @@ class DataClient {
   friend class Table;
   friend class noex::Table;
   friend class internal::AsyncBulkMutator;
+  friend class internal::AsyncReadRowsFuture;
   friend class internal::AsyncSampleRowKeys;
   friend class internal::BulkMutator;
   friend class RowReader;
@@ -13,8 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/data_client.h"
-
+#include "google/cloud/internal/make_unique.h"
 #include <gmock/gmock.h>
+#include <future>
 
 namespace bigtable = google::cloud::bigtable;
 
@@ -37,3 +38,43 @@ TEST(DataClientTest, Default) {
   EXPECT_TRUE(channel1);
   EXPECT_NE(channel0.get(), channel1.get());
 }
+
+TEST(DataClientTest, RetryBudget) {
+  auto data_client = bigtable::CreateDefaultDataClient(
+      "test-project", "test-instance",
+      bigtable::ClientOptions().set_connection_pool_size(1));
+  EXPECT_FALSE(data_client->GetRetryBudget());
+
+  auto budget = std::make_shared<bigtable::RetryBudget>();
+  data_client = bigtable::CreateDefaultDataClient(
+      "test-project", "test-instance",
+      bigtable::ClientOptions().set_connection_pool_size(1).set_retry_budget(
+          budget));
+  EXPECT_EQ(budget, data_client->GetRetryBudget());
+}
+
+TEST(DataClientTest, DropLastReferenceWithOperationInFlight) {
+  auto data_client = bigtable::CreateDefaultDataClient(
+      "test-project", "test-instance",
+      bigtable::ClientOptions()
+          .set_connection_pool_size(1)
+          .set_background_thread_pool_size(2));
+  auto cq = google::cloud::internal::make_unique<bigtable::CompletionQueue>(
+      bigtable::internal::BackgroundCompletionQueue(
+          data_client->BackgroundThreads()));
+
+  // The queue is still served after the client is gone.
+  data_client.reset();
+
+  // The callback drops the last reference to the queue, and thus to the
+  // background threads, from one of those threads.
+  std::promise<void> done;
+  cq->MakeRelativeTimer(std::chrono::milliseconds(2))
+      .then([&cq, &done](google::cloud::future<
+                         std::chrono::system_clock::time_point>) {
+        cq.reset();
+        done.set_value();
+      });
+  EXPECT_EQ(std::future_status::ready,
+            done.get_future().wait_for(std::chrono::milliseconds(500)));
+}
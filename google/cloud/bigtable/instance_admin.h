@@ -82,6 +82,19 @@ class InstanceAdmin {
   /// The project id, i.e., `project_name()` without the `projects/` prefix.
   std::string const& project_id() const { return impl_.project_id(); }
 
+  /**
+   * Return a completion queue run by the client's background threads.
+   *
+   * Applications that do not create and run their own `CompletionQueue` can
+   * use this queue with the asynchronous member functions of this class. The
+   * threads keep running while a copy of the queue exists, even after the
+   * client is destroyed.
+   */
+  CompletionQueue background_completion_queue() const {
+    return internal::BackgroundCompletionQueue(
+        impl_.client_->BackgroundThreads());
+  }
+
   /// Return the fully qualified name of the given instance_id.
   std::string InstanceName(std::string const& instance_id) const {
     return impl_.InstanceName(instance_id);
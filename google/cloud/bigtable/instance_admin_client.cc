@@ -14,6 +14,7 @@
 
 #include "google/cloud/bigtable/instance_admin_client.h"
 #include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/internal/leased_reader.h"
 #include <google/longrunning/operations.grpc.pb.h>
 
 namespace google {
@@ -58,6 +59,10 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
   Impl::ChannelPtr Channel() override { return impl_.Channel(); }
   void reset() override { return impl_.reset(); }
 
+  std::shared_ptr<bigtable::BackgroundThreads> BackgroundThreads() override {
+    return impl_.BackgroundThreads();
+  }
+
   grpc::Status ListInstances(
       grpc::ClientContext* context,
       google::bigtable::admin::v2::ListInstancesRequest const& request,
@@ -196,7 +201,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::ListInstancesRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncListInstances(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncListInstances(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -205,7 +212,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::GetInstanceRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetInstance(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncGetInstance(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -213,7 +222,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
   AsyncGetCluster(grpc::ClientContext* context,
                   google::bigtable::admin::v2::GetClusterRequest const& request,
                   grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetCluster(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncGetCluster(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -222,7 +233,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DeleteClusterRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDeleteCluster(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncDeleteCluster(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -231,7 +244,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::CreateClusterRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCreateCluster(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncCreateCluster(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -240,7 +255,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::CreateInstanceRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCreateInstance(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncCreateInstance(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -249,7 +266,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::PartialUpdateInstanceRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncPartialUpdateInstance(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncPartialUpdateInstance(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -257,7 +276,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
   AsyncUpdateCluster(grpc::ClientContext* context,
                      const google::bigtable::admin::v2::Cluster& request,
                      grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncUpdateCluster(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncUpdateCluster(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -266,7 +287,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DeleteInstanceRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDeleteInstance(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncDeleteInstance(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -275,7 +298,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::ListClustersRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncListClusters(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncListClusters(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -284,7 +309,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::GetAppProfileRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetAppProfile(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncGetAppProfile(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -293,7 +320,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::DeleteAppProfileRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncDeleteAppProfile(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncDeleteAppProfile(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -302,7 +331,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       google::bigtable::admin::v2::CreateAppProfileRequest const& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncCreateAppProfile(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncCreateAppProfile(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -311,7 +342,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::UpdateAppProfileRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncUpdateAppProfile(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncUpdateAppProfile(context, request, cq), stub);
   }
 
   std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
@@ -320,7 +353,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
       grpc::ClientContext* context,
       const google::bigtable::admin::v2::ListAppProfilesRequest& request,
       grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncListAppProfiles(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncListAppProfiles(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -328,7 +363,9 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
   AsyncGetIamPolicy(grpc::ClientContext* context,
                     google::iam::v1::GetIamPolicyRequest const& request,
                     grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->AsyncGetIamPolicy(context, request, cq);
+    auto stub = impl_.Stub();
+    return internal::MakeLeasedReader(
+        stub->AsyncGetIamPolicy(context, request, cq), stub);
   }
 
   std::unique_ptr<
@@ -352,6 +389,10 @@ class DefaultInstanceAdminClient : public InstanceAdminClient {
 };
 }  // anonymous namespace
 
+std::shared_ptr<BackgroundThreads> InstanceAdminClient::BackgroundThreads() {
+  return internal::DefaultBackgroundThreads();
+}
+
 std::shared_ptr<InstanceAdminClient> CreateDefaultInstanceAdminClient(
     std::string project, ClientOptions options) {
   return std::make_shared<DefaultInstanceAdminClient>(std::move(project),
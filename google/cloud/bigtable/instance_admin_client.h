@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INSTANCE_ADMIN_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INSTANCE_ADMIN_CLIENT_H_
 
+#include "google/cloud/bigtable/background_threads.h"
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/internal/poll_longrunning_operation.h"
 #include "google/cloud/bigtable/version.h"
@@ -87,6 +88,16 @@ class InstanceAdminClient {
    */
   virtual void reset() = 0;
 
+  /**
+   * Return the threads running asynchronous operations for this client.
+   *
+   * Applications that do not want to create and run their own
+   * `CompletionQueue` can use the queue from these threads. The default
+   * implementation returns a pool shared by the whole process, the clients
+   * created with `ClientOptions` create their own pool on first use.
+   */
+  virtual std::shared_ptr<bigtable::BackgroundThreads> BackgroundThreads();
+
   // The member functions of this class are not intended for general use by
   // application developers (they are simply a dependency injection point). Make
   // them protected, so the mock classes can override them, and then make the
@@ -0,0 +1,155 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/async_read_rows_future.h"
+#include "google/cloud/bigtable/internal/async_retry_op.h"
+#include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/table.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::int64_t constexpr AsyncReadRowsFuture::NO_ROWS_LIMIT;
+
+future<Status> AsyncReadRowsFuture::Create(
+    CompletionQueue cq, std::shared_ptr<DataClient> client,
+    bigtable::AppProfileId app_profile_id, bigtable::TableId table_name,
+    RowSet row_set, std::int64_t rows_limit, Filter filter,
+    std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<ReadRowsParserFactory> parser_factory, RowFunctor on_row) {
+  auto state = std::make_shared<State>(
+      std::move(client), std::move(app_profile_id), std::move(table_name),
+      std::move(row_set), rows_limit, std::move(filter),
+      std::move(parser_factory), std::move(on_row));
+
+  auto final_result = std::make_shared<promise<Status>>();
+  auto f = final_result->get_future();
+  auto done = [final_result](CompletionQueue&, bool&, grpc::Status& status) {
+    final_result->set_value(status.ok() ? Status()
+                                        : MakeStatusFromRpcError(status));
+  };
+  using Retry =
+      AsyncRetryOp<ConstantIdempotencyPolicy, decltype(done),
+                   AsyncReadRowsFuture>;
+  auto op = std::make_shared<Retry>(
+      __func__, std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      ConstantIdempotencyPolicy(true), std::move(metadata_update_policy),
+      std::move(done), AsyncReadRowsFuture(std::move(state)));
+  op->Start(cq);
+  return f;
+}
+
+AsyncReadRowsFuture::Request AsyncReadRowsFuture::MakeRequest(State& state) {
+  Request request;
+  SetCommonTableOperationRequest<Request>(request, state.app_profile_id.get(),
+                                          state.table_name.get());
+  *request.mutable_rows() = state.row_set.as_proto();
+  *request.mutable_filter() = state.filter.as_proto();
+  if (state.rows_limit != NO_ROWS_LIMIT) {
+    request.set_rows_limit(state.rows_limit - state.rows_count);
+  }
+
+  state.parser = state.parser_factory->Create();
+  state.rows.clear();
+  state.parser_status = grpc::Status::OK;
+  return request;
+}
+
+future<bool> AsyncReadRowsFuture::OnResponse(
+    std::shared_ptr<State> state, google::bigtable::v2::ReadRowsResponse& r) {
+  for (auto& chunk : *r.mutable_chunks()) {
+    state->parser->HandleChunk(std::move(chunk), state->parser_status);
+    if (!state->parser_status.ok()) {
+      // Cancel the stream, OnFinish() reports the parser error.
+      return make_ready_future(false);
+    }
+    if (state->parser->HasNext()) {
+      state->rows.emplace_back(state->parser->Next(state->parser_status));
+      if (!state->parser_status.ok()) {
+        return make_ready_future(false);
+      }
+    }
+  }
+  return DeliverRows(std::move(state));
+}
+
+future<bool> AsyncReadRowsFuture::DeliverRows(std::shared_ptr<State> state) {
+  while (!state->rows.empty()) {
+    Row row = std::move(state->rows.front());
+    state->rows.pop_front();
+    ++state->rows_count;
+    state->last_read_row_key.assign(row.row_key());
+
+    auto more = state->on_row(std::move(row));
+    if (!more.is_ready()) {
+      return more.then([state](future<bool> f) {
+        if (!f.get()) {
+          state->stopped = true;
+          return make_ready_future(false);
+        }
+        return DeliverRows(state);
+      });
+    }
+    if (!more.get()) {
+      state->stopped = true;
+      return make_ready_future(false);
+    }
+  }
+  return make_ready_future(true);
+}
+
+void AsyncReadRowsFuture::OnFinish(State& state, grpc::Status& status) {
+  if (state.stopped) {
+    // The application stopped the scan, the status is not interesting.
+    status = grpc::Status::OK;
+    return;
+  }
+  if (!state.parser_status.ok()) {
+    status = state.parser_status;
+  } else if (status.ok()) {
+    state.parser->HandleEndOfStream(status);
+  }
+  if (status.ok()) {
+    return;
+  }
+
+  // In the unlikely case when we have already reached the requested number of
+  // rows and still receive an error there is no need to retry.
+  if (state.rows_limit != NO_ROWS_LIMIT &&
+      state.rows_limit <= state.rows_count) {
+    status = grpc::Status::OK;
+    return;
+  }
+  if (!state.last_read_row_key.empty()) {
+    // We've returned some rows and need to make sure we don't request them
+    // again.
+    state.row_set =
+        state.row_set.Intersect(RowRange::Open(state.last_read_row_key, ""));
+  }
+  // If we receive an error, but the retriable set is empty, stop.
+  if (state.row_set.IsEmpty()) {
+    status = grpc::Status::OK;
+  }
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
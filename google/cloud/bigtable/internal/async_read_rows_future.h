@@ -0,0 +1,191 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_READ_ROWS_FUTURE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_READ_ROWS_FUTURE_H_
+
+#include "google/cloud/bigtable/async_operation.h"
+#include "google/cloud/bigtable/bigtable_strong_types.h"
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/table_strong_types.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/status.h"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Read rows asynchronously, with retries and flow control.
+ *
+ * `Create()` returns a future<> that becomes satisfied when all the rows are
+ * delivered, when the operation fails with a non-retryable error or the retry
+ * policy expires, or when the application stops the scan.
+ *
+ * Each row is passed to a callback that returns `future<bool>`. The next row is
+ * not delivered, and no more data is requested from the stream, until that
+ * future is satisfied. If its value is `false` the stream is cancelled and the
+ * operation completes successfully. Like `RowReader`, retries resume after the
+ * last row delivered to the application.
+ *
+ * The retry loop is implemented by `AsyncRetryOp`, this class satisfies the
+ * requirements for its `Operation` parameter. Each call to `Start()` makes a
+ * new ReadRows request, skipping the rows already delivered. The state is
+ * shared with the callbacks, as the futures returned by the application may
+ * be satisfied after the retry loop finishes.
+ */
+class AsyncReadRowsFuture {
+ public:
+  using RowFunctor = std::function<future<bool>(Row)>;
+  using Request = google::bigtable::v2::ReadRowsRequest;
+  using Response = bool;
+
+  /// A constant for the magic value that means "no limit, get all rows".
+  static std::int64_t constexpr NO_ROWS_LIMIT = 0;
+
+  /**
+   * Start the asynchronous read loop.
+   *
+   * @param cq the completion queue where the read loop is executed.
+   * @param on_row the callback to receive the rows.
+   * @return a future that becomes satisfied when the read loop finishes.
+   */
+  static future<Status> Create(
+      CompletionQueue cq, std::shared_ptr<DataClient> client,
+      bigtable::AppProfileId app_profile_id, bigtable::TableId table_name,
+      RowSet row_set, std::int64_t rows_limit, Filter filter,
+      std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::unique_ptr<ReadRowsParserFactory> parser_factory,
+      RowFunctor on_row);
+
+  /**
+   * Start a ReadRows request for the rows not yet delivered.
+   *
+   * @param cq the completion queue to run the asynchronous operations.
+   * @param context the gRPC context used for this request.
+   * @param callback the functor called when the stream finishes. The status
+   *     is OK if the application stopped the scan, or if there are no more
+   *     rows to retry.
+   */
+  template <typename Functor,
+            typename std::enable_if<
+                google::cloud::internal::is_invocable<Functor, CompletionQueue&,
+                                                      grpc::Status&>::value,
+                int>::type valid_callback_type = 0>
+  std::shared_ptr<AsyncOperation> Start(
+      CompletionQueue& cq, std::unique_ptr<grpc::ClientContext> context,
+      Functor&& callback) {
+    auto state = state_;
+    typename std::decay<Functor>::type finished(
+        std::forward<Functor>(callback));
+    return cq.MakeUnaryStreamRpc(
+        *state->client, &DataClient::AsyncReadRows, MakeRequest(*state),
+        std::move(context),
+        [state](CompletionQueue&, grpc::ClientContext const&,
+                google::bigtable::v2::ReadRowsResponse& response) {
+          return OnResponse(state, response);
+        },
+        [state, finished](CompletionQueue& cq, grpc::ClientContext&,
+                          grpc::Status& status) mutable {
+          OnFinish(*state, status);
+          finished(cq, status);
+        });
+  }
+
+  bool AccumulatedResult() { return true; }
+
+ private:
+  struct State {
+    State(std::shared_ptr<DataClient> c, bigtable::AppProfileId a,
+          bigtable::TableId t, RowSet rs, std::int64_t rl, Filter f,
+          std::unique_ptr<ReadRowsParserFactory> pf, RowFunctor r)
+        : client(std::move(c)),
+          app_profile_id(std::move(a)),
+          table_name(std::move(t)),
+          row_set(std::move(rs)),
+          rows_limit(rl),
+          filter(std::move(f)),
+          parser_factory(std::move(pf)),
+          on_row(std::move(r)),
+          stopped(false),
+          rows_count(0) {}
+
+    std::shared_ptr<DataClient> client;
+    bigtable::AppProfileId app_profile_id;
+    bigtable::TableId table_name;
+    RowSet row_set;
+    std::int64_t rows_limit;
+    Filter filter;
+    std::unique_ptr<ReadRowsParserFactory> parser_factory;
+    RowFunctor on_row;
+
+    std::unique_ptr<ReadRowsParser> parser;
+    /// Rows parsed from the current response and not yet delivered.
+    std::deque<Row> rows;
+    /// The first parser error in the current stream.
+    grpc::Status parser_status;
+    /// Set when the application stops the scan.
+    bool stopped;
+
+    /// Number of rows delivered so far, used to set row_limit in retries.
+    std::int64_t rows_count;
+    /// Holds the last delivered row key, for retries.
+    std::string last_read_row_key;
+  };
+
+  explicit AsyncReadRowsFuture(std::shared_ptr<State> state)
+      : state_(std::move(state)) {}
+
+  /// Prepare a new stream, skipping the rows already delivered.
+  static Request MakeRequest(State& state);
+
+  /// Parse a response, the stream is paused until the returned future is
+  /// satisfied.
+  static future<bool> OnResponse(std::shared_ptr<State> state,
+                                 google::bigtable::v2::ReadRowsResponse& r);
+
+  /// Deliver the parsed rows, one at a time.
+  static future<bool> DeliverRows(std::shared_ptr<State> state);
+
+  /// Adjust the final status of a stream before the retry loop sees it.
+  static void OnFinish(State& state, grpc::Status& status);
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_READ_ROWS_FUTURE_H_
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/internal/async_poll_op.h"
 #include "google/cloud/bigtable/internal/conjunction.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/polling_policy.h"
 #include "google/cloud/bigtable/version.h"
@@ -292,10 +293,15 @@ class AsyncRetryMultiPageFuture {
           self->DetailedStatus(context, result.status()));
       return;
     }
-    self->cq_
-        .MakeRelativeTimer(
-            self->rpc_backoff_policy_->OnCompletion(result.status()))
-        .then([self](future<std::chrono::system_clock::time_point>) {
+    auto status = result.status();
+    AsyncBackoffBeforeRetry(self->cq_, *self->rpc_retry_policy_,
+                            self->rpc_backoff_policy_->OnCompletion(status))
+        .then([self, status](future<bool> f) {
+          if (!f.get()) {
+            self->final_result_.set_value(
+                self->DetailedStatus("retry deadline exhausted", status));
+            return;
+          }
           self->StartIteration(self);
         });
   }
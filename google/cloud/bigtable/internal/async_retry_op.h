@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/internal/async_loop_op.h"
 #include "google/cloud/bigtable/internal/async_op_traits.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
@@ -124,7 +125,8 @@ class RetriableLoopAdapter {
         idempotent_policy_(std::move(idempotent_policy)),
         metadata_update_policy_(std::move(metadata_update_policy)),
         user_callback_(std::move(callback)),
-        operation_(std::move(operation)) {}
+        operation_(std::move(operation)),
+        delay_(0) {}
 
   template <typename AttemptFunctor>
   std::shared_ptr<AsyncOperation> Start(
@@ -142,9 +144,7 @@ class RetriableLoopAdapter {
         });
   }
 
-  std::chrono::milliseconds WaitPeriod() {
-    return rpc_backoff_policy_->OnCompletion(status_);
-  }
+  std::chrono::milliseconds WaitPeriod() { return delay_; }
 
   void Cancel(CompletionQueue& cq) {
     auto res = operation_.AccumulatedResult();
@@ -195,7 +195,19 @@ class RetriableLoopAdapter {
       attempt_completed_callback(cq, true);
       return;
     }
-    status_ = status;
+    auto delay = rpc_backoff_policy_->OnCompletion(status);
+    if (!BackoffWithinDeadline(*rpc_retry_policy_, delay)) {
+      // The retry policy would expire before the next attempt starts.
+      grpc::Status res_status(
+          status.error_code(),
+          FullErrorMessageUnlocked("retry deadline exhausted", status),
+          status.error_details());
+      auto res = operation_.AccumulatedResult();
+      user_callback_(cq, res, res_status);
+      attempt_completed_callback(cq, true);
+      return;
+    }
+    delay_ = delay;
     attempt_completed_callback(cq, false);
   }
 
@@ -221,7 +233,8 @@ class RetriableLoopAdapter {
   MetadataUpdatePolicy metadata_update_policy_;
   UserFunctor user_callback_;
   Operation operation_;
-  grpc::Status status_;
+  /// The backoff before the next attempt, computed when an attempt fails.
+  std::chrono::milliseconds delay_;
 };
 
 /**
@@ -333,6 +333,61 @@ TEST_F(NoexTableAsyncRetryOpTest, TestRealTimerCancellation) {
   pool.join();
 }
 
+TEST_F(NoexTableAsyncRetryOpTest, BackoffExceedsRetryDeadline) {
+  // The backoff would end long after the retry policy expires, the loop must
+  // report the last error instead of waiting for it.
+  auto rpc_retry_policy = bigtable::LimitedTimeRetryPolicy(10_ms).clone();
+  auto rpc_backoff_policy =
+      bigtable::ExponentialBackoffPolicy(1_h, 2_h).clone();
+  MetadataUpdatePolicy metadata_update_policy(kTableId,
+                                              MetadataParamTypes::TABLE_NAME);
+
+  auto cq_impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  CompletionQueue cq(cq_impl);
+
+  auto dummy_op_mock = std::make_shared<DummyOperationMock>();
+
+  Functor on_dummy_op_finished;
+  bool user_op_completed = false;
+  auto user_callback = [&user_op_completed](CompletionQueue&, int& response,
+                                            grpc::Status& status) {
+    EXPECT_EQ(grpc::StatusCode::UNAVAILABLE, status.error_code());
+    EXPECT_THAT(status.error_message(), HasSubstr("retry deadline exhausted"));
+    EXPECT_THAT(status.error_message(), HasSubstr("try-again"));
+    EXPECT_EQ(27, response);
+    user_op_completed = true;
+  };
+
+  auto async_op = std::make_shared<
+      internal::AsyncRetryOp<internal::ConstantIdempotencyPolicy,
+                             decltype(user_callback), DummyOperation>>(
+      __func__, std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      internal::ConstantIdempotencyPolicy(true), metadata_update_policy,
+      std::move(user_callback), DummyOperation(dummy_op_mock));
+
+  EXPECT_CALL(*dummy_op_mock, Start(_, _, _))
+      .WillOnce(
+          Invoke([&on_dummy_op_finished](CompletionQueue&,
+                                         std::unique_ptr<grpc::ClientContext>&,
+                                         Functor const& callback) {
+            on_dummy_op_finished = callback;
+            return std::shared_ptr<AsyncOperation>(new AsyncOperationMock);
+          }));
+  EXPECT_CALL(*dummy_op_mock, AccumulatedResult()).WillOnce(Invoke([]() {
+    return 27;
+  }));
+
+  async_op->Start(cq);
+  ASSERT_TRUE(on_dummy_op_finished);
+
+  grpc::Status status(grpc::StatusCode::UNAVAILABLE, "try-again");
+  on_dummy_op_finished(cq, status);
+
+  // No timer was scheduled, the operation completed right away.
+  EXPECT_TRUE(cq_impl->empty());
+  EXPECT_TRUE(user_op_completed);
+}
+
 class NoexTableAsyncRetryOpCancelInTimerTest
     : public bigtable::testing::internal::TableTestFixture,
       public WithParamInterface<bool> {};
@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/internal/async_retry_op.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
@@ -279,9 +280,15 @@ class RetryAsyncUnaryRpcFuture {
           self->DetailedStatus(context, result.status()));
       return;
     }
-    cq.MakeRelativeTimer(
-          self->rpc_backoff_policy_->OnCompletion(result.status()))
-        .then([self, cq](future<std::chrono::system_clock::time_point>) {
+    auto status = result.status();
+    AsyncBackoffBeforeRetry(cq, *self->rpc_retry_policy_,
+                            self->rpc_backoff_policy_->OnCompletion(status))
+        .then([self, cq, status](future<bool> f) {
+          if (!f.get()) {
+            self->final_result_.set_value(
+                self->DetailedStatus("retry deadline exhausted", status));
+            return;
+          }
           self->StartIteration(self, cq);
         });
   }
@@ -242,6 +242,64 @@ TEST(AsyncRetryUnaryRpcTest, TooManyTransientFailures) {
   EXPECT_EQ(StatusCode::kUnavailable, result.status().code());
 }
 
+/// @test Verify that a retry loop in backoff stops when the queue shuts down.
+TEST(AsyncRetryUnaryRpcTest, ShutdownDuringBackoff) {
+  using namespace google::cloud::testing_util::chrono_literals;
+
+  MockClient client;
+
+  using ReaderType =
+      ::google::cloud::bigtable::testing::MockAsyncResponseReader<
+          btadmin::Table>;
+  auto reader = google::cloud::internal::make_unique<ReaderType>();
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce(Invoke([](btadmin::Table*, grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+      }));
+
+  // Only the first attempt reaches the client, the attempt after the backoff
+  // must not be handed to a queue that is shut down.
+  EXPECT_CALL(client, AsyncGetTable(_, _, _))
+      .WillOnce(Invoke([&reader](grpc::ClientContext*,
+                                 btadmin::GetTableRequest const&,
+                                 grpc::CompletionQueue*) {
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            // This is safe, see comments in MockAsyncResponseReader.
+            btadmin::Table>>(reader.get());
+      }));
+
+  auto impl = std::make_shared<testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  btadmin::GetTableRequest request;
+  request.set_name("fake/table/name/request");
+
+  auto fut = StartRetryAsyncUnaryRpc(
+      __func__, LimitedErrorCountRetryPolicy(3).clone(),
+      ExponentialBackoffPolicy(10_us, 40_us).clone(),
+      ConstantIdempotencyPolicy(true),
+      MetadataUpdatePolicy("resource", MetadataParamTypes::RESOURCE),
+      [&client](grpc::ClientContext* context,
+                btadmin::GetTableRequest const& request,
+                grpc::CompletionQueue* cq) {
+        return client.AsyncGetTable(context, request, cq);
+      },
+      request, cq);
+
+  EXPECT_EQ(1U, impl->size());  // simulate the call completing
+  impl->SimulateCompletion(cq, true);
+  EXPECT_EQ(1U, impl->size());  // the loop is now in backoff
+
+  cq.Shutdown();
+  impl->SimulateCompletion(cq, false);  // the timer is cancelled
+  EXPECT_TRUE(impl->empty());
+
+  EXPECT_EQ(std::future_status::ready, fut.wait_for(0_us));
+  auto result = fut.get();
+  EXPECT_FALSE(result);
+  EXPECT_EQ(StatusCode::kCancelled, result.status().code());
+}
+
 TEST(AsyncRetryUnaryRpcTest, VoidReturnImmediatelySucceeds) {
   using namespace google::cloud::testing_util::chrono_literals;
 
@@ -26,6 +26,17 @@
 #define BIGTABLE_CLIENT_DEFAULT_CHANNELS_PER_CPU 2
 #endif  // BIGTABLE_CLIENT_DEFAULT_CHANNELS_PER_CPU
 
+// Used when std::thread::hardware_concurrency() cannot compute the core count.
+#ifndef BIGTABLE_CLIENT_DEFAULT_BACKGROUND_THREAD_POOL_SIZE
+#define BIGTABLE_CLIENT_DEFAULT_BACKGROUND_THREAD_POOL_SIZE 4
+#endif  // BIGTABLE_CLIENT_DEFAULT_BACKGROUND_THREAD_POOL_SIZE
+
+// Grow a resizable connection pool when the channels average more outstanding
+// RPCs than this, about half the streams allowed on each HTTP/2 connection.
+#ifndef BIGTABLE_CLIENT_DEFAULT_TARGET_OUTSTANDING_RPCS_PER_CHANNEL
+#define BIGTABLE_CLIENT_DEFAULT_TARGET_OUTSTANDING_RPCS_PER_CHANNEL 50
+#endif  // BIGTABLE_CLIENT_DEFAULT_TARGET_OUTSTANDING_RPCS_PER_CHANNEL
+
 #ifndef BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH
 #define BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH (256 * 1024L * 1024L)
 #endif  // BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH
@@ -15,9 +15,18 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COMMON_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COMMON_CLIENT_H_
 
+#include "google/cloud/bigtable/background_threads.h"
+#include "google/cloud/bigtable/channel_selection_policy.h"
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/make_unique.h"
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -25,6 +34,15 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Create a grpc::Channel based on the client options.
+ *
+ * Channels with different @p id values do not share their connections.
+ */
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    int id);
+
 /// Create a pool of grpc::Channel objects based on the client options.
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
@@ -33,10 +51,26 @@ std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
  * Refactor implementation of `bigtable::{Data,Admin,InstanceAdmin}Client`.
  *
  * All the clients need to keep a collection (sometimes with a single element)
- * of channels, update the collection when needed and round-robin across the
- * channels. At least `bigtable::DataClient` needs to optimize the creation of
+ * of channels, update the collection when needed and select a channel for each
+ * call. At least `bigtable::DataClient` needs to optimize the creation of
  * the stub objects.
  *
+ * The channel for each call is picked by the `ChannelSelectionPolicy` in the
+ * client options. To support load-aware policies each channel tracks the
+ * number of outstanding RPCs: the stubs returned by `Stub()` count as one RPC
+ * until they are released. The clients keep the stub for streaming and
+ * asynchronous RPCs in the reader they return (see `MakeLeasedReader()`), so
+ * those RPCs count until the reader is destroyed.
+ *
+ * `Stub()` and `Channel()` are called for every RPC, once the pool is created
+ * they do not lock any mutex: they read an immutable snapshot of the pool
+ * through an atomic pointer.
+ *
+ * If the client options allow it, the pool grows and shrinks with the load,
+ * and replaces channels older than `max_channel_age()`. This maintenance runs
+ * in the calling thread, at most once per period, and new channels only join
+ * the pool once they are connected.
+ *
  * The class exposes the channels because they are needed for clients that
  * use more than one type of Stub.
  *
@@ -54,7 +88,45 @@ class CommonClient {
   //@}
 
   CommonClient(bigtable::ClientOptions options)
-      : options_(std::move(options)), current_index_(0) {}
+      : options_(std::move(options)),
+        policy_(options_.channel_selection_policy()),
+        current_(nullptr),
+        min_size_(options_.min_connection_pool_size()),
+        max_size_(options_.max_connection_pool_size()),
+        maintenance_enabled_(min_size_ != max_size_ ||
+                             options_.max_channel_age().count() > 0),
+        next_maintenance_(0),
+        next_channel_id_(0) {
+    auto const timeout = options_.connection_pool_prewarm_timeout();
+    if (timeout.count() > 0) {
+      PrewarmChannels(timeout);
+    }
+  }
+
+  /**
+   * Create the pool and connect all its channels.
+   *
+   * Blocks until all the channels are connected or @p timeout expires, and
+   * returns the number of connected channels.
+   */
+  std::size_t PrewarmChannels(std::chrono::milliseconds timeout) {
+    auto const deadline = std::chrono::system_clock::now() + timeout;
+    if (current_.load() == nullptr) {
+      CheckConnections();
+    }
+    auto slots = CurrentSlots();
+    // Start connecting all the channels before waiting for any of them.
+    for (auto const& slot : slots) {
+      slot->channel->GetState(true);
+    }
+    std::size_t connected = 0;
+    for (auto const& slot : slots) {
+      if (slot->channel->WaitForConnected(deadline)) {
+        ++connected;
+      }
+    }
+    return connected;
+  }
 
   /**
    * Reset the channel and stub.
@@ -64,73 +136,428 @@ class CommonClient {
    * and/or when the credentials require explicit refresh.
    */
   void reset() {
-    std::lock_guard<std::mutex> lk(mu_);
-    stubs_.clear();
+    std::unique_lock<std::mutex> lk(mu_);
+    warming_.clear();
+    Publish(lk, nullptr);
   }
 
-  /// Return the next Stub to make a call.
+  /**
+   * Change the bounds of the connection pool.
+   *
+   * The pool starts moving towards the new bounds immediately, and then
+   * follows the load as configured in the client options. New channels are
+   * used once they are connected. The pool always keeps at least one channel.
+   */
+  void ResizeConnectionPool(std::size_t min_size, std::size_t max_size) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      min_size_ = std::max(min_size, std::size_t(1));
+      max_size_ = std::max(min_size_, max_size);
+    }
+    maintenance_enabled_.store(true);
+    MaintainPool();
+  }
+
+  /**
+   * Return the Stub to make the next call.
+   *
+   * The call is counted as outstanding on the selected channel until the
+   * returned pointer, and all its copies, are released.
+   */
   StubPtr Stub() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto stub = stubs_[GetIndex(lk)];
-    return stub;
+    auto slot = SelectSlot();
+    ++slot->outstanding_rpcs;
+    ++slot->total_rpcs;
+    // The stub is owned by `slot`, the deleter only ends the RPC.
+    using Stub = typename Interface::StubInterface;
+    return StubPtr(slot->stub.get(),
+                   [slot](Stub*) { --slot->outstanding_rpcs; });
   }
 
   /// Return the next Channel to make a call.
-  ChannelPtr Channel() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto channel = channels_[GetIndex(lk)];
-    return channel;
+  ChannelPtr Channel() { return SelectSlot()->channel; }
+
+  /// Return the background threads, creating them on the first call.
+  std::shared_ptr<bigtable::BackgroundThreads> BackgroundThreads() {
+    std::call_once(background_threads_once_, [this] {
+      background_threads_ = MakeBackgroundThreads(options_);
+    });
+    return background_threads_;
+  }
+
+  /// Return the load and state of each channel, empty if none was created.
+  std::vector<ChannelStats> GetChannelStats() {
+    auto slots = CurrentSlots();
+    std::vector<ChannelStats> stats;
+    stats.reserve(slots.size());
+    for (auto const& slot : slots) {
+      stats.push_back(ChannelStats{slot->outstanding_rpcs.load(),
+                                   slot->total_rpcs.load(),
+                                   slot->channel->GetState(false)});
+    }
+    return stats;
   }
 
  private:
-  /// Make sure the connections exit, and create them if needed.
-  void CheckConnections(std::unique_lock<std::mutex>& lk) {
-    if (!stubs_.empty()) {
-      return;
+  /// A channel, its stub, and its load.
+  struct ChannelSlot {
+    explicit ChannelSlot(ChannelPtr ch)
+        : channel(std::move(ch)),
+          stub(Interface::NewStub(channel)),
+          created(std::chrono::steady_clock::now()),
+          outstanding_rpcs(0),
+          total_rpcs(0) {}
+
+    ChannelPtr channel;
+    StubPtr stub;
+    std::chrono::steady_clock::time_point created;
+    std::atomic<std::int64_t> outstanding_rpcs;
+    std::atomic<std::uint64_t> total_rpcs;
+  };
+  using SlotPtr = std::shared_ptr<ChannelSlot>;
+
+  /// A new channel that joins the pool once it is connected.
+  struct WarmingSlot {
+    SlotPtr slot;
+    /// The channel to replace, null if the new channel grows the pool.
+    SlotPtr replaces;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  /**
+   * An immutable view of the connection pool.
+   *
+   * `Stub()` reads the current snapshot without locking `mu_`. To make this
+   * safe, readers announce themselves in `readers` before using `slots`, and
+   * `Publish()` waits for them before clearing the slots of a retired snapshot.
+   * The snapshot objects themselves are reused, never deleted, while the client
+   * is alive, so a reader may always touch `readers`.
+   */
+  struct Snapshot {
+    Snapshot() : readers(0) {}
+
+    std::vector<SlotPtr> slots;
+    std::atomic<int> readers;
+  };
+
+  /// Present the slots to the `ChannelSelectionPolicy`.
+  class SlotsLoad : public ChannelLoad {
+   public:
+    explicit SlotsLoad(std::vector<SlotPtr> const& slots) : slots_(slots) {}
+
+    std::size_t size() const override { return slots_.size(); }
+    std::int64_t outstanding_rpcs(std::size_t index) const override {
+      return slots_[index]->outstanding_rpcs.load();
+    }
+    bool healthy(std::size_t index) const override {
+      auto const state = slots_[index]->channel->GetState(false);
+      return state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+             state != GRPC_CHANNEL_SHUTDOWN;
+    }
+
+   private:
+    std::vector<SlotPtr> const& slots_;
+  };
+
+  /// Return a copy of the channels in the pool, empty if none was created.
+  std::vector<SlotPtr> CurrentSlots() {
+    std::lock_guard<std::mutex> lk(mu_);
+    // Only `Publish()` modifies the snapshots, and it holds `mu_`.
+    if (auto* snapshot = current_.load()) {
+      return snapshot->slots;
+    }
+    return {};
+  }
+
+  /// Select the channel for the next call, without locking in the common case.
+  SlotPtr SelectSlot() {
+    for (;;) {
+      auto* snapshot = current_.load();
+      if (snapshot == nullptr) {
+        CheckConnections();
+        continue;
+      }
+      ++snapshot->readers;
+      // The snapshot may have been retired before `readers` was incremented,
+      // in that case its slots may be cleared at any time.
+      if (current_.load() != snapshot) {
+        --snapshot->readers;
+        continue;
+      }
+      auto slot = snapshot->slots[policy_->Select(SlotsLoad(snapshot->slots))];
+      --snapshot->readers;
+      MaybeMaintainPool();
+      return slot;
     }
-    // Release the lock while making remote calls.  gRPC uses the current
+  }
+
+  /// Make sure the connections exit, and create them if needed.
+  void CheckConnections() {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto const size = std::min(
+        std::max(options_.connection_pool_size(), min_size_), max_size_);
+    auto const first_id = next_channel_id_;
+    next_channel_id_ += static_cast<int>(size);
+    lk.unlock();
+    // Do not hold the lock while making remote calls.  gRPC uses the current
     // thread to make remote connections (and probably authenticate), holding
-    // a lock for long operations like that is a bad practice.  Releasing
-    // the lock here can result in wasted work, but that is a smaller problem
-    // than a deadlock or an unbounded priority inversion.
+    // a lock for long operations like that is a bad practice.  Creating the
+    // pool without the lock can result in wasted work, but that is a smaller
+    // problem than a deadlock or an unbounded priority inversion.
     // Note that only one connection per application is created by gRPC, even
     // if multiple threads are calling this function at the same time. gRPC
     // only opens one socket per destination+attributes combo, we artificially
-    // introduce attributes in the implementation of CreateChannelPool() to
-    // create one socket per element in the pool.
+    // introduce attributes in the implementation of CreateChannel() to create
+    // one socket per element in the pool.
+    std::vector<SlotPtr> tmp;
+    for (std::size_t i = 0; i != size; ++i) {
+      tmp.push_back(std::make_shared<ChannelSlot>(
+          CreateChannel(Traits::Endpoint(options_), options_,
+                        first_id + static_cast<int>(i))));
+    }
+    lk.lock();
+    if (current_.load() == nullptr) {
+      Publish(lk, &tmp);
+    }
+  }
+
+  /// Resize and refresh the pool, at most once per maintenance period.
+  void MaybeMaintainPool() {
+    if (!maintenance_enabled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    using std::chrono::steady_clock;
+    auto const now = steady_clock::now().time_since_epoch().count();
+    auto next = next_maintenance_.load();
+    if (now < next) {
+      return;
+    }
+    auto const period = std::chrono::duration_cast<steady_clock::duration>(
+        options_.channel_pool_maintenance_period());
+    // Only one of the threads that observe an expired period runs it.
+    auto const deadline = now + period.count();
+    if (!next_maintenance_.compare_exchange_strong(next, deadline)) {
+      return;
+    }
+    MaintainPool();
+  }
+
+  /**
+   * Resize the pool to the current load and refresh its oldest channel.
+   *
+   * New channels start connecting here, but only join the pool in a later
+   * call, once they are connected, so no RPC waits for a connection.
+   */
+  void MaintainPool() {
+    auto const now = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lk(mu_);
+    auto* snapshot = current_.load();
+    if (snapshot == nullptr) {
+      // The next call creates the pool, already within the bounds.
+      return;
+    }
+    auto slots = snapshot->slots;
+    bool changed = PromoteWarmChannels(now, slots);
+
+    // The channels replaced by new channels, null entries grow the pool.
+    std::vector<SlotPtr> replaces;
+    auto const desired = DesiredPoolSize(slots);
+    if (desired > slots.size()) {
+      auto growing = std::count_if(
+          warming_.begin(), warming_.end(),
+          [](WarmingSlot const& w) { return w.replaces == nullptr; });
+      for (auto size = slots.size() + growing; size < desired; ++size) {
+        replaces.emplace_back(nullptr);
+      }
+    } else {
+      warming_.erase(
+          std::remove_if(
+              warming_.begin(), warming_.end(),
+              [](WarmingSlot const& w) { return w.replaces == nullptr; }),
+          warming_.end());
+      if (desired < slots.size()) {
+        RemoveLeastLoaded(slots);
+        changed = true;
+      }
+    }
+    auto oldest = ChannelToRefresh(now, slots);
+    if (oldest != nullptr) {
+      replaces.push_back(std::move(oldest));
+    }
+    if (changed) {
+      Publish(lk, &slots);
+    }
+    if (replaces.empty()) {
+      return;
+    }
+    auto const first_id = next_channel_id_;
+    next_channel_id_ += static_cast<int>(replaces.size());
     lk.unlock();
-    auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
-    std::vector<StubPtr> tmp;
-    std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
-                   [](std::shared_ptr<grpc::Channel> ch) {
-                     return Interface::NewStub(ch);
-                   });
+
+    // As in `CheckConnections()`, do not hold the lock while creating the
+    // channels. A concurrent call may start redundant channels,
+    // `PromoteWarmChannels()` discards those that would exceed the pool bounds
+    // or replace a channel that was already replaced.
+    // How long a new channel may take to connect before it is discarded.
+    auto const warmup_timeout = std::chrono::seconds(30);
+    std::vector<WarmingSlot> started;
+    for (auto& r : replaces) {
+      auto channel =
+          CreateChannel(Traits::Endpoint(options_), options_,
+                        first_id + static_cast<int>(started.size()));
+      // Start connecting, `PromoteWarmChannels()` checks the result.
+      channel->GetState(true);
+      started.push_back(
+          WarmingSlot{std::make_shared<ChannelSlot>(std::move(channel)),
+                      std::move(r), now + warmup_timeout});
+    }
     lk.lock();
-    if (stubs_.empty()) {
-      channels.swap(channels_);
-      tmp.swap(stubs_);
-      current_index_ = 0;
+    if (current_.load() == nullptr) {
+      // The pool was reset, the new channels are not needed.
+      return;
+    }
+    warming_.insert(warming_.end(), std::make_move_iterator(started.begin()),
+                    std::make_move_iterator(started.end()));
+  }
+
+  /// Move the connected channels in `warming_` to @p slots.
+  bool PromoteWarmChannels(std::chrono::steady_clock::time_point now,
+                           std::vector<SlotPtr>& slots) {
+    bool changed = false;
+    std::vector<WarmingSlot> pending;
+    for (auto& w : warming_) {
+      if (w.slot->channel->GetState(true) != GRPC_CHANNEL_READY) {
+        // Channels that do not connect in time are discarded, a later call
+        // starts a new one if it is still needed.
+        if (now < w.deadline) {
+          pending.push_back(std::move(w));
+        }
+        continue;
+      }
+      if (w.replaces == nullptr) {
+        if (slots.size() < max_size_) {
+          slots.push_back(std::move(w.slot));
+          changed = true;
+        }
+        continue;
+      }
+      auto loc = std::find(slots.begin(), slots.end(), w.replaces);
+      if (loc != slots.end()) {
+        *loc = std::move(w.slot);
+        changed = true;
+      }
+    }
+    warming_.swap(pending);
+    return changed;
+  }
+
+  /// The pool size for the current load, within the configured bounds.
+  std::size_t DesiredPoolSize(std::vector<SlotPtr> const& slots) const {
+    auto desired = slots.size();
+    auto const target = options_.target_outstanding_rpcs_per_channel();
+    if (target != 0) {
+      std::int64_t outstanding = 0;
+      for (auto const& slot : slots) {
+        outstanding += slot->outstanding_rpcs.load();
+      }
+      desired = (static_cast<std::size_t>(outstanding) + target - 1) / target;
     }
+    return std::min(std::max(desired, min_size_), max_size_);
   }
 
-  /// Get the current index for round-robin over connections.
-  std::size_t GetIndex(std::unique_lock<std::mutex>& lk) {
-    std::size_t current = current_index_++;
-    // Round robin through the connections.
-    if (current_index_ >= stubs_.size()) {
-      current_index_ = 0;
+  /// Remove the channel with the fewest outstanding RPCs from @p slots.
+  void RemoveLeastLoaded(std::vector<SlotPtr>& slots) {
+    auto loc = std::min_element(slots.begin(), slots.end(),
+                                [](SlotPtr const& a, SlotPtr const& b) {
+                                  return a->outstanding_rpcs.load() <
+                                         b->outstanding_rpcs.load();
+                                });
+    auto removed = *loc;
+    slots.erase(loc);
+    warming_.erase(std::remove_if(warming_.begin(), warming_.end(),
+                                  [&removed](WarmingSlot const& w) {
+                                    return w.replaces == removed;
+                                  }),
+                   warming_.end());
+  }
+
+  /// Return the oldest channel in @p slots if it is due for a refresh.
+  SlotPtr ChannelToRefresh(std::chrono::steady_clock::time_point now,
+                           std::vector<SlotPtr> const& slots) const {
+    auto const max_age = options_.max_channel_age();
+    if (max_age.count() == 0 || slots.empty()) {
+      return nullptr;
+    }
+    // Refresh one channel at a time, reconnecting the whole pool at once
+    // would be as disruptive as not refreshing it.
+    for (auto const& w : warming_) {
+      if (w.replaces != nullptr) {
+        return nullptr;
+      }
+    }
+    auto oldest = std::min_element(slots.begin(), slots.end(),
+                                   [](SlotPtr const& a, SlotPtr const& b) {
+                                     return a->created < b->created;
+                                   });
+    if (now - (*oldest)->created < max_age) {
+      return nullptr;
+    }
+    return *oldest;
+  }
+
+  /**
+   * Replace the current snapshot with one containing @p slots.
+   *
+   * If @p slots is `nullptr` the pool is emptied, and recreated on the next
+   * call. The slots of the previous snapshot are released once no reader is
+   * using them, the RPCs using those channels keep them alive until they
+   * complete.
+   */
+  void Publish(std::unique_lock<std::mutex>&, std::vector<SlotPtr>* slots) {
+    auto* old = current_.load();
+    Snapshot* next = nullptr;
+    if (slots != nullptr) {
+      // Any snapshot other than the current one is idle, at most two are ever
+      // needed.
+      for (auto& s : snapshots_) {
+        if (s.get() != old) {
+          next = s.get();
+          break;
+        }
+      }
+      if (next == nullptr) {
+        snapshots_.push_back(google::cloud::internal::make_unique<Snapshot>());
+        next = snapshots_.back().get();
+      }
+      next->slots.swap(*slots);
+    }
+    current_.store(next);
+    if (old == nullptr) {
+      return;
+    }
+    // New readers see that `old` is retired and do not use its slots. Wait
+    // for any readers that started earlier, they only hold it for a few
+    // instructions.
+    while (old->readers.load() != 0) {
+      std::this_thread::yield();
     }
-    return current;
+    old->slots.clear();
   }
 
  private:
   std::mutex mu_;
   ClientOptions options_;
-  std::vector<ChannelPtr> channels_;
-  std::vector<StubPtr> stubs_;
-  std::size_t current_index_;
+  std::unique_ptr<ChannelSelectionPolicy> policy_;
+  std::atomic<Snapshot*> current_;
+  std::vector<std::unique_ptr<Snapshot>> snapshots_;
+  std::size_t min_size_;
+  std::size_t max_size_;
+  std::atomic<bool> maintenance_enabled_;
+  std::atomic<std::chrono::steady_clock::rep> next_maintenance_;
+  int next_channel_id_;
+  std::vector<WarmingSlot> warming_;
+  std::once_flag background_threads_once_;
+  std::shared_ptr<bigtable::BackgroundThreads> background_threads_;
 };
 
 }  // namespace internal
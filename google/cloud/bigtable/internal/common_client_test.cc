@@ -0,0 +1,281 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/internal/leased_reader.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/internal/make_unique.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+struct TestTraits {
+  static std::string const& Endpoint(bigtable::ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using TestClient = CommonClient<TestTraits, google::bigtable::v2::Bigtable>;
+
+ClientOptions TestOptions(ChannelSelectionPolicy const& policy) {
+  // The channels connect lazily, the tests never make an RPC.
+  return ClientOptions(grpc::InsecureChannelCredentials())
+      .set_data_endpoint("localhost:1")
+      .set_connection_pool_size(2)
+      .set_channel_selection_policy(policy);
+}
+
+std::int64_t TotalOutstanding(std::vector<ChannelStats> const& stats) {
+  std::int64_t total = 0;
+  for (auto const& s : stats) {
+    total += s.outstanding_rpcs;
+  }
+  return total;
+}
+
+/// @test Verify that stubs count as outstanding RPCs until released.
+TEST(CommonClientTest, StubsTrackOutstandingRpcs) {
+  TestClient client(TestOptions(RoundRobinChannelSelection()));
+  EXPECT_TRUE(client.GetChannelStats().empty());
+
+  auto s1 = client.Stub();
+  auto s2 = client.Stub();
+  auto stats = client.GetChannelStats();
+  ASSERT_EQ(2U, stats.size());
+  EXPECT_EQ(1, stats[0].outstanding_rpcs);
+  EXPECT_EQ(1, stats[1].outstanding_rpcs);
+
+  auto copy = s1;
+  s1.reset();
+  EXPECT_EQ(2, TotalOutstanding(client.GetChannelStats()));
+  copy.reset();
+  s2.reset();
+  stats = client.GetChannelStats();
+  EXPECT_EQ(0, TotalOutstanding(stats));
+  EXPECT_EQ(1U, stats[0].total_rpcs);
+  EXPECT_EQ(1U, stats[1].total_rpcs);
+}
+
+/// @test Verify that asynchronous unary RPCs hold the stub until completed.
+TEST(CommonClientTest, AsyncResponseReaderHoldsLease) {
+  using Reader = bigtable::testing::MockAsyncResponseReader<
+      google::bigtable::v2::MutateRowResponse>;
+  TestClient client(TestOptions(RoundRobinChannelSelection()));
+
+  auto stub = client.Stub();
+  auto reader = MakeLeasedReader(
+      std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+          google::bigtable::v2::MutateRowResponse>>(
+          google::cloud::internal::make_unique<Reader>()),
+      stub);
+  stub.reset();
+  EXPECT_EQ(1, TotalOutstanding(client.GetChannelStats()));
+
+  reader.reset();
+  EXPECT_EQ(0, TotalOutstanding(client.GetChannelStats()));
+}
+
+/// @test Verify that the least loaded channel is used.
+TEST(CommonClientTest, LeastOutstandingRpcs) {
+  TestClient client(TestOptions(LeastOutstandingRpcsChannelSelection()));
+
+  // Keep a long-lived "scan" on one channel, all other calls should use the
+  // other channel.
+  auto scan = client.Stub();
+  for (int i = 0; i != 10; ++i) {
+    auto stub = client.Stub();
+    EXPECT_NE(scan.get(), stub.get());
+  }
+  auto stats = client.GetChannelStats();
+  ASSERT_EQ(2U, stats.size());
+  EXPECT_EQ(1, TotalOutstanding(stats));
+  EXPECT_EQ(11U, stats[0].total_rpcs + stats[1].total_rpcs);
+}
+
+/// @test Verify that stubs outlive a reset() of the client.
+TEST(CommonClientTest, StubOutlivesReset) {
+  TestClient client(TestOptions(RoundRobinChannelSelection()));
+  auto stub = client.Stub();
+  client.reset();
+  EXPECT_NE(nullptr, stub.get());
+  stub.reset();
+  EXPECT_TRUE(client.GetChannelStats().empty());
+}
+
+/// @test Verify that Stub() is safe while the pool is replaced.
+TEST(CommonClientTest, StubConcurrentWithReset) {
+  TestClient client(TestOptions(PowerOfTwoChoicesChannelSelection()));
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([&client] {
+      for (int j = 0; j != 1000; ++j) {
+        auto stub = client.Stub();
+        EXPECT_NE(nullptr, stub.get());
+      }
+    });
+  }
+  for (int i = 0; i != 10; ++i) {
+    client.reset();
+    std::this_thread::yield();
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(0, TotalOutstanding(client.GetChannelStats()));
+}
+
+/// A server that accepts connections, the channels can connect to it.
+class LocalServer {
+ public:
+  LocalServer() {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                             &port_);
+    // gRPC requires at least one service, the tests never make any RPCs.
+    builder.RegisterAsyncGenericService(&service_);
+    cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    // The server does not accept connections unless its queue is polled.
+    poller_ = std::thread([this] {
+      void* tag;
+      bool ok;
+      while (cq_->Next(&tag, &ok)) {
+      }
+    });
+  }
+  ~LocalServer() {
+    server_->Shutdown();
+    cq_->Shutdown();
+    poller_.join();
+  }
+
+  std::string endpoint() const { return "localhost:" + std::to_string(port_); }
+
+ private:
+  int port_ = 0;
+  grpc::AsyncGenericService service_;
+  std::unique_ptr<grpc::ServerCompletionQueue> cq_;
+  std::unique_ptr<grpc::Server> server_;
+  std::thread poller_;
+};
+
+ClientOptions ResizableOptions(LocalServer const& server) {
+  return ClientOptions(grpc::InsecureChannelCredentials())
+      .set_data_endpoint(server.endpoint())
+      .set_connection_pool_size(1)
+      .set_connection_pool_size_bounds(1, 4)
+      .set_target_outstanding_rpcs_per_channel(1)
+      .set_channel_pool_maintenance_period(std::chrono::milliseconds(0));
+}
+
+/// Call `Stub()` until @p predicate is true, or give up after a few seconds.
+template <typename Predicate>
+bool WaitFor(TestClient& client, Predicate predicate) {
+  for (int i = 0; i != 500; ++i) {
+    client.Stub();
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+/// @test Verify that the pool grows with the load and shrinks after it.
+TEST(CommonClientTest, PoolFollowsLoad) {
+  LocalServer server;
+  TestClient client(ResizableOptions(server));
+
+  std::vector<TestClient::StubPtr> scans;
+  for (int i = 0; i != 4; ++i) {
+    scans.push_back(client.Stub());
+  }
+  EXPECT_TRUE(WaitFor(
+      client, [&client] { return client.GetChannelStats().size() == 4; }));
+
+  scans.clear();
+  EXPECT_TRUE(WaitFor(
+      client, [&client] { return client.GetChannelStats().size() == 1; }));
+}
+
+/// @test Verify that ResizeConnectionPool() changes the bounds.
+TEST(CommonClientTest, ResizeConnectionPool) {
+  LocalServer server;
+  TestClient client(ResizableOptions(server));
+  client.Stub();
+  EXPECT_EQ(1U, client.GetChannelStats().size());
+
+  client.ResizeConnectionPool(3, 8);
+  EXPECT_TRUE(WaitFor(
+      client, [&client] { return client.GetChannelStats().size() == 3; }));
+
+  client.ResizeConnectionPool(2, 2);
+  EXPECT_TRUE(WaitFor(
+      client, [&client] { return client.GetChannelStats().size() == 2; }));
+}
+
+/// @test Verify that old channels are replaced, without shrinking the pool.
+TEST(CommonClientTest, RefreshOldChannels) {
+  LocalServer server;
+  TestClient client(
+      ClientOptions(grpc::InsecureChannelCredentials())
+          .set_data_endpoint(server.endpoint())
+          .set_connection_pool_size(1)
+          .set_max_channel_age(std::chrono::milliseconds(1))
+          .set_channel_pool_maintenance_period(std::chrono::milliseconds(0)));
+  auto initial = client.Channel();
+  EXPECT_TRUE(WaitFor(
+      client, [&client, &initial] { return client.Channel() != initial; }));
+  EXPECT_EQ(1U, client.GetChannelStats().size());
+}
+
+/// @test Verify that the channels can be connected when the client is created.
+TEST(CommonClientTest, PrewarmChannels) {
+  LocalServer server;
+  TestClient client(
+      ClientOptions(grpc::InsecureChannelCredentials())
+          .set_data_endpoint(server.endpoint())
+          .set_connection_pool_size(3)
+          .set_connection_pool_prewarm_timeout(std::chrono::seconds(10)));
+  auto stats = client.GetChannelStats();
+  ASSERT_EQ(3U, stats.size());
+  for (auto const& s : stats) {
+    EXPECT_EQ(GRPC_CHANNEL_READY, s.state);
+    EXPECT_EQ(0U, s.total_rpcs);
+  }
+}
+
+/// @test Verify that prewarming gives up after the timeout.
+TEST(CommonClientTest, PrewarmChannelsTimeout) {
+  TestClient client(TestOptions(RoundRobinChannelSelection()));
+  EXPECT_EQ(0U, client.PrewarmChannels(std::chrono::milliseconds(10)));
+  EXPECT_EQ(2U, client.GetChannelStats().size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
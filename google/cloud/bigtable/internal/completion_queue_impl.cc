@@ -13,35 +13,83 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/internal/completion_queue_impl.h"
+#include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
-
-// There is no wait to unblock the gRPC event loop, not even calling Shutdown(),
-// so we periodically wake up from the loop to check if the application has
-// shutdown the run.
-constexpr std::chrono::milliseconds LOOP_TIMEOUT(50);
+#include <thread>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+namespace {
+/// The completion queue served by the current thread, if any.
+struct RunnerAffinity {
+  CompletionQueueImpl const* impl;
+  std::size_t index;
+};
+
+thread_local RunnerAffinity current_runner = {nullptr, 0};
+
+/// Set the affinity of the current thread, restoring it on destruction.
+class RunnerAffinityGuard {
+ public:
+  RunnerAffinityGuard(CompletionQueueImpl const* impl, std::size_t index)
+      : saved_(current_runner) {
+    current_runner = RunnerAffinity{impl, index};
+  }
+  ~RunnerAffinityGuard() { current_runner = saved_; }
+
+ private:
+  RunnerAffinity saved_;
+};
+}  // namespace
+
+bool AsyncGrpcOperation::IsShutdown(CompletionQueue& cq) {
+  return cq.impl_->IsShutdown();
+}
+
+std::shared_ptr<CompletionQueue> AsyncGrpcOperation::ShareQueue(
+    CompletionQueue& cq) {
+  return std::make_shared<CompletionQueue>(cq);
+}
+
+constexpr std::size_t CompletionQueueImpl::kShardCount;
+
+CompletionQueueImpl::CompletionQueueImpl(std::size_t num_queues)
+    : next_runner_(0), next_queue_(0), shutdown_(false), starting_(0) {
+  if (num_queues == 0) {
+    num_queues = 1;
+  }
+  queues_.reserve(num_queues);
+  for (std::size_t i = 0; i != num_queues; ++i) {
+    queues_.emplace_back(
+        google::cloud::internal::make_unique<grpc::CompletionQueue>());
+  }
+}
+
 void CompletionQueueImpl::Run(CompletionQueue& cq) {
-  while (!shutdown_.load()) {
-    void* tag;
-    bool ok;
-    auto deadline = std::chrono::system_clock::now() + LOOP_TIMEOUT;
-    auto status = cq_.AsyncNext(&tag, &ok, deadline);
-    if (status == grpc::CompletionQueue::SHUTDOWN) {
-      break;
-    }
-    if (status == grpc::CompletionQueue::TIMEOUT) {
+  auto const index = next_runner_.fetch_add(1) % queues_.size();
+  RunnerAffinityGuard guard(this, index);
+  auto& queue = *queues_[index];
+  void* tag;
+  bool ok;
+  // Block until there is an event, Next() returns false once the queue is shut
+  // down and drained. Timers (including the ones created by RunAsync()) wake
+  // the loop through their own events, so there is no need to poll.
+  while (queue.Next(&tag, &ok)) {
+    if (shutdown_.load()) {
+      // Shutdown() cancelled this operation, notify it without letting it
+      // start new operations on a queue that is already shut down. The
+      // operation may have completed before it was cancelled, so `ok` is
+      // still meaningful.
+      auto op = TakeOperation(tag);
+      if (op) {
+        op->NotifyShutdown(cq, ok);
+      }
       continue;
     }
-    if (status != grpc::CompletionQueue::GOT_EVENT) {
-      google::cloud::internal::ThrowRuntimeError(
-          "unexpected status from AsyncNext()");
-    }
     auto op = FindOperation(tag);
     if (op->Notify(cq, ok)) {
       ForgetOperation(tag);
@@ -49,9 +97,59 @@ void CompletionQueueImpl::Run(CompletionQueue& cq) {
   }
 }
 
-void CompletionQueueImpl::Shutdown() {
+void CompletionQueueImpl::Shutdown(CompletionQueue& cq) {
   shutdown_.store(true);
-  cq_.Shutdown();
+  // Operations started after this point are rejected by StartOperation(), wait
+  // for any operation that is already being handed to gRPC.
+  while (starting_.load() != 0) {
+    std::this_thread::yield();
+  }
+  // The queues are drained only after all the pending operations complete,
+  // cancel them so the threads blocked in Run() return promptly. Operations
+  // without a pending gRPC event would never be drained, complete them here,
+  // before the queues are shut down under the feet of a stream resuming in
+  // another thread.
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> ops;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    for (auto&& kv : shard.pending_ops) {
+      ops.push_back(kv.second);
+    }
+  }
+  for (auto& op : ops) {
+    op->Cancel();
+    if (op->NotifyShutdownIfIdle(cq)) {
+      TakeOperation(op.get());
+    }
+  }
+  for (auto& queue : queues_) {
+    queue->Shutdown();
+  }
+}
+
+grpc::CompletionQueue& CompletionQueueImpl::cq() {
+  if (queues_.size() == 1) {
+    return *queues_.front();
+  }
+  if (current_runner.impl == this) {
+    return *queues_[current_runner.index];
+  }
+  return *queues_[next_queue_.fetch_add(1) % queues_.size()];
+}
+
+std::size_t CompletionQueueImpl::size() const {
+  std::size_t count = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    count += shard.pending_ops.size();
+  }
+  return count;
+}
+
+CompletionQueueImpl::Shard& CompletionQueueImpl::ShardFor(void* tag) {
+  // The low bits of the tag are always zero due to alignment, discard them.
+  auto const key = reinterpret_cast<std::uintptr_t>(tag) >> 4;
+  return shards_[key % kShardCount];
 }
 
 std::unique_ptr<grpc::Alarm> CompletionQueueImpl::CreateAlarm() const {
@@ -61,9 +159,10 @@ std::unique_ptr<grpc::Alarm> CompletionQueueImpl::CreateAlarm() const {
 void* CompletionQueueImpl::RegisterOperation(
     std::shared_ptr<AsyncGrpcOperation> op) {
   void* tag = op.get();
-  std::unique_lock<std::mutex> lk(mu_);
-  auto ins =
-      pending_ops_.emplace(reinterpret_cast<std::intptr_t>(tag), std::move(op));
+  auto& shard = ShardFor(tag);
+  std::unique_lock<std::mutex> lk(shard.mu);
+  auto ins = shard.pending_ops.emplace(reinterpret_cast<std::intptr_t>(tag),
+                                       std::move(op));
   // After this point we no longer need the lock, so release it.
   lk.unlock();
   if (ins.second) {
@@ -75,9 +174,10 @@ void* CompletionQueueImpl::RegisterOperation(
 
 std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::FindOperation(
     void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto loc = pending_ops_.find(reinterpret_cast<std::intptr_t>(tag));
-  if (pending_ops_.end() == loc) {
+  auto& shard = ShardFor(tag);
+  std::lock_guard<std::mutex> lk(shard.mu);
+  auto loc = shard.pending_ops.find(reinterpret_cast<std::intptr_t>(tag));
+  if (shard.pending_ops.end() == loc) {
     google::cloud::internal::ThrowRuntimeError(
         "assertion failure: searching for async op tag");
   }
@@ -85,9 +185,10 @@ std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::FindOperation(
 }
 
 void CompletionQueueImpl::ForgetOperation(void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
+  auto& shard = ShardFor(tag);
+  std::lock_guard<std::mutex> lk(shard.mu);
   auto const num_erased =
-      pending_ops_.erase(reinterpret_cast<std::intptr_t>(tag));
+      shard.pending_ops.erase(reinterpret_cast<std::intptr_t>(tag));
   if (1U != num_erased) {
     google::cloud::internal::ThrowRuntimeError(
         "assertion failure: searching for async op tag when trying to "
@@ -95,6 +196,19 @@ void CompletionQueueImpl::ForgetOperation(void* tag) {
   }
 }
 
+std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::TakeOperation(
+    void* tag) {
+  auto& shard = ShardFor(tag);
+  std::lock_guard<std::mutex> lk(shard.mu);
+  auto loc = shard.pending_ops.find(reinterpret_cast<std::intptr_t>(tag));
+  if (shard.pending_ops.end() == loc) {
+    return nullptr;
+  }
+  auto op = std::move(loc->second);
+  shard.pending_ops.erase(loc);
+  return op;
+}
+
 // This function is used in unit tests to simulate the completion of an
 // operation. The unit test is expected to create a class derived from
 // `CompletionQueueImpl`, wrap it in a `CompletionQueue` and call this function
@@ -112,10 +226,9 @@ void CompletionQueueImpl::SimulateCompletion(CompletionQueue& cq,
 void CompletionQueueImpl::SimulateCompletion(CompletionQueue& cq, bool ok) {
   // Make a copy to avoid race conditions or iterator invalidation.
   std::vector<void*> tags;
-  {
-    std::lock_guard<std::mutex> lk(mu_);
-    tags.reserve(pending_ops_.size());
-    for (auto&& kv : pending_ops_) {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    for (auto&& kv : shard.pending_ops) {
       tags.push_back(reinterpret_cast<void*>(kv.first));
     }
   }
@@ -128,14 +241,16 @@ void CompletionQueueImpl::SimulateCompletion(CompletionQueue& cq, bool ok) {
   }
 
   // Discard any pending events.
-  grpc::CompletionQueue::NextStatus status;
-  do {
-    void* tag;
-    bool ok;
-    auto deadline =
-        std::chrono::system_clock::now() + std::chrono::milliseconds(1);
-    status = cq_.AsyncNext(&tag, &ok, deadline);
-  } while (status == grpc::CompletionQueue::GOT_EVENT);
+  for (auto& queue : queues_) {
+    grpc::CompletionQueue::NextStatus status;
+    do {
+      void* tag;
+      bool ok;
+      auto deadline =
+          std::chrono::system_clock::now() + std::chrono::milliseconds(1);
+      status = queue->AsyncNext(&tag, &ok, deadline);
+    } while (status == grpc::CompletionQueue::GOT_EVENT);
+  }
 }
 
 }  // namespace internal
@@ -20,14 +20,18 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/future.h"
 #include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/status_or.h"
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
+#include <array>
 #include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -64,6 +68,36 @@ class AsyncGrpcOperation : public AsyncOperation {
    *   response, it would return true only after the stream is finished).
    */
   virtual bool Notify(CompletionQueue& cq, bool ok) = 0;
+
+  /**
+   * Notifies the application that the operation completed after `Shutdown()`.
+   *
+   * The queue is shut down, so the operation must not start any new work. The
+   * @p ok parameter has the same semantics as in `Notify()`, it is `false` for
+   * operations started after `Shutdown()`, which are never handed to gRPC. The
+   * default implementation is `Notify(cq, ok)`, operations that would react to
+   * the notification by starting another gRPC operation override this
+   * function.
+   */
+  virtual void NotifyShutdown(CompletionQueue& cq, bool ok) { Notify(cq, ok); }
+
+  /**
+   * Notifies an operation without a pending gRPC event of `Shutdown()`.
+   *
+   * Operations waiting for the application, such as paused streams, are never
+   * drained from the queue, so they must complete here. The default
+   * implementation does nothing.
+   *
+   * @return true if the operation completed.
+   */
+  virtual bool NotifyShutdownIfIdle(CompletionQueue&) { return false; }
+
+ protected:
+  /// Return true if `Shutdown()` was called on @p cq.
+  static bool IsShutdown(CompletionQueue& cq);
+
+  /// Return a copy of @p cq, for callbacks that outlive the current call.
+  static std::shared_ptr<CompletionQueue> ShareQueue(CompletionQueue& cq);
 };
 
 /**
@@ -101,7 +135,11 @@ class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
     rpc->Finish(&response_, &status_, tag);
   }
 
-  void Cancel() override { context_->TryCancel(); }
+  void Cancel() override {
+    if (context_) {
+      context_->TryCancel();
+    }
+  }
 
  private:
   bool Notify(CompletionQueue&, bool ok) override {
@@ -122,6 +160,17 @@ class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
     return true;
   }
 
+  void NotifyShutdown(CompletionQueue& cq, bool ok) override {
+    if (!ok) {
+      // The RPC was never started, the queue was already shut down.
+      promise_.set_value(
+          ::google::cloud::Status(google::cloud::StatusCode::kCancelled,
+                                  "the completion queue was shut down"));
+      return;
+    }
+    Notify(cq, ok);
+  }
+
   // These are the parameters for the RPC, most of them have obvious semantics.
   // `context_` is stored as a `unique_ptr` because (a) we need to receive it
   // as a parameter, otherwise the caller could not set timeouts, metadata, or
@@ -162,15 +211,16 @@ template <
 class AsyncTimerFunctor : public AsyncGrpcOperation {
  public:
   explicit AsyncTimerFunctor(Functor functor,
+                             std::chrono::system_clock::time_point deadline,
                              std::unique_ptr<grpc::Alarm> alarm)
-      : functor_(std::move(functor)), alarm_(std::move(alarm)) {}
+      : functor_(std::move(functor)), alarm_(std::move(alarm)) {
+    timer_.deadline = deadline;
+  }
 
-  void Set(grpc::CompletionQueue& cq,
-           std::chrono::system_clock::time_point deadline, void* tag) {
+  void Set(grpc::CompletionQueue& cq, void* tag) {
     std::unique_lock<std::mutex> lk(mu_);
-    timer_.deadline = deadline;
     if (alarm_) {
-      alarm_->Set(&cq, deadline, tag);
+      alarm_->Set(&cq, timer_.deadline, tag);
     }
   }
 
@@ -261,7 +311,9 @@ class AsyncUnaryRpcFunctor : public AsyncGrpcOperation {
   void Cancel() override {
     // Make sure context_ is visible in this thread.
     static_cast<void>(sync_.load(std::memory_order_acquire));
-    context_->TryCancel();
+    if (context_) {
+      context_->TryCancel();
+    }
   }
 
  private:
@@ -278,6 +330,17 @@ class AsyncUnaryRpcFunctor : public AsyncGrpcOperation {
     return true;
   }
 
+  void NotifyShutdown(CompletionQueue& cq, bool ok) override {
+    if (!ok) {
+      // The RPC was never started, the queue was already shut down.
+      status_ = grpc::Status(grpc::StatusCode::CANCELLED,
+                             "the completion queue was shut down");
+      functor_(cq, response_, status_);
+      return;
+    }
+    Notify(cq, ok);
+  }
+
   // sync_ doesn't have any semantics. It is used to generate proper barriers
   // for synchronization.
   std::atomic<bool> sync_;
@@ -300,6 +363,8 @@ class AsyncUnaryRpcFunctor : public AsyncGrpcOperation {
  * @tparam Request the type of the RPC request.
  * @tparam Response the type of the RPC response piece.
  * @tparam DataFunctor the callback type for notifying about data protions.
+ *     If it returns `future<bool>` the stream is paused until that future is
+ *     satisfied.
  * @tparam FinishedFunctor the callback type for notifying about end of stream.
  */
 template <typename Request, typename Response, typename DataFunctor,
@@ -310,12 +375,16 @@ template <typename Request, typename Response, typename DataFunctor,
           typename std::enable_if<CheckUnaryStreamRpcFinishedCallback<
                                       FinishedFunctor, Response>::value,
                                   int>::type = 0>
-class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
+class AsyncUnaryStreamRpcFunctor
+    : public AsyncGrpcOperation,
+      public std::enable_shared_from_this<AsyncUnaryStreamRpcFunctor<
+          Request, Response, DataFunctor, FinishedFunctor>> {
  public:
   explicit AsyncUnaryStreamRpcFunctor(DataFunctor data_functor,
                                       FinishedFunctor finished_functor)
       : tag_(nullptr),
         state_(CREATING),
+        paused_(false),
         data_functor_(std::move(data_functor)),
         finished_functor_(std::move(finished_functor)) {}
 
@@ -332,7 +401,9 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
 
   void Cancel() override {
     std::unique_lock<std::mutex> lk(mu_);
-    context_->TryCancel();
+    if (context_) {
+      context_->TryCancel();
+    }
   }
 
  private:
@@ -357,16 +428,7 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
           lk.unlock();
           // The simple way to assure that we don't reorder callbacks is not
           // submitting the next Read() until the user callback finishes.
-          data_functor_(cq, *context_, received);
-          lk.lock();
-          // We must hold the lock while calling Read(): this operation may
-          // trigger a callback in other threads running the completion event
-          // queue, and those should be blocked until this function returns.  On
-          // the other hand, Read() should not block for a long time: gRPC says
-          // that this is an asynchronous operation, blocking for a long time
-          // would make it impossible to write asynchronous applications
-          // efficiently.
-          response_reader_->Read(&response_, tag_);
+          OnData(cq, received, IsFlowControlled{});
         } else {
           response_reader_->Finish(&status_, tag_);
           state_ = FINISHING;
@@ -382,6 +444,112 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
         std::to_string(state_));
   }
 
+  void NotifyShutdown(CompletionQueue& cq, bool) override {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (state_ != FINISHING) {
+      // Calling Finish() on a queue that is shut down is not allowed, report
+      // the cancellation directly.
+      status_ = grpc::Status(grpc::StatusCode::CANCELLED,
+                             "the completion queue was shut down");
+      state_ = FINISHING;
+    }
+    if (!context_) {
+      // The stream was never started, there is no context to report.
+      context_ = google::cloud::internal::make_unique<grpc::ClientContext>();
+    }
+    lk.unlock();
+    finished_functor_(cq, *context_, status_);
+  }
+
+  bool NotifyShutdownIfIdle(CompletionQueue& cq) override {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!paused_ || state_ == FINISHING) {
+      return false;
+    }
+    // A paused stream has no pending Read(), report the cancellation now
+    // instead of waiting for the application to resume it.
+    FinishCancelled(cq, std::move(lk));
+    return true;
+  }
+
+  /// Data functors returning `future<bool>` control when to read more data.
+  using IsFlowControlled = std::is_same<
+      future<bool>, google::cloud::internal::invoke_result_t<
+                        DataFunctor, CompletionQueue&,
+                        grpc::ClientContext const&, Response&>>;
+
+  /// Call the data functor and request the next response right away.
+  void OnData(CompletionQueue& cq, Response& received, std::false_type) {
+    data_functor_(cq, *context_, received);
+    ReadNext(cq, true);
+  }
+
+  /**
+   * Call the data functor and request the next response when it is ready.
+   *
+   * The stream is paused until the future returned by the functor is
+   * satisfied. If its value is `false` the stream is cancelled, and the
+   * finished functor receives the final status as usual.
+   */
+  void OnData(CompletionQueue& cq, Response& received, std::true_type) {
+    auto more = data_functor_(cq, *context_, received);
+    if (more.is_ready()) {
+      ReadNext(cq, more.get());
+      return;
+    }
+    // There is no pending Read() while the application holds the future, so
+    // `Shutdown()` cannot drain this stream. It completes paused streams
+    // directly, unless it already looked at this one before it paused.
+    std::unique_lock<std::mutex> lk(mu_);
+    paused_ = true;
+    if (IsShutdown(cq)) {
+      FinishCancelled(cq, std::move(lk));
+      return;
+    }
+    lk.unlock();
+    // The continuation keeps this operation alive until it resumes the stream.
+    auto self = this->shared_from_this();
+    auto queue = ShareQueue(cq);
+    more.then([self, queue](future<bool> f) {
+      self->ReadNext(*queue, f.get());
+    });
+  }
+
+  /// Request the next response, cancelling the stream unless @p keep_reading.
+  void ReadNext(CompletionQueue& cq, bool keep_reading) {
+    std::unique_lock<std::mutex> lk(mu_);
+    paused_ = false;
+    if (state_ == FINISHING) {
+      // `Shutdown()` completed the stream while it was paused.
+      return;
+    }
+    if (IsShutdown(cq)) {
+      // Calling Read() on a queue that is shut down is not allowed.
+      FinishCancelled(cq, std::move(lk));
+      return;
+    }
+    if (!keep_reading) {
+      context_->TryCancel();
+    }
+    // We must hold the lock while calling Read(): this operation may
+    // trigger a callback in other threads running the completion event
+    // queue, and those should be blocked until this function returns.  On
+    // the other hand, Read() should not block for a long time: gRPC says
+    // that this is an asynchronous operation, blocking for a long time
+    // would make it impossible to write asynchronous applications
+    // efficiently.
+    response_reader_->Read(&response_, tag_);
+  }
+
+  /// Report the cancellation by `Shutdown()`, @p lk must hold `mu_`.
+  void FinishCancelled(CompletionQueue& cq, std::unique_lock<std::mutex> lk) {
+    status_ = grpc::Status(grpc::StatusCode::CANCELLED,
+                           "the completion queue was shut down");
+    state_ = FINISHING;
+    lk.unlock();
+    finished_functor_(cq, *context_, status_);
+  }
+
   // It is not obvious why the mutex is used. There are 4 reasons:
   //
   // Cancel() might be called after Start() in a different thread. We need a
@@ -402,6 +570,8 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
   std::mutex mu_;
   void* tag_;
   State state_;
+  /// Set while the application holds the future returned by the data functor.
+  bool paused_;
   grpc::Status status_;
   DataFunctor data_functor_;
   FinishedFunctor finished_functor_;
@@ -536,29 +706,83 @@ using AsyncCallResponseType = AsyncCallResponseTypeUnwrap<
  */
 class CompletionQueueImpl {
  public:
-  CompletionQueueImpl() : cq_(), shutdown_(false) {}
+  CompletionQueueImpl() : CompletionQueueImpl(1) {}
+
+  /**
+   * Create an implementation using @p num_queues gRPC completion queues.
+   *
+   * Each thread calling `Run()` serves one of the queues, assigned in
+   * round-robin order, so at least @p num_queues threads must call `Run()`.
+   */
+  explicit CompletionQueueImpl(std::size_t num_queues);
   virtual ~CompletionQueueImpl() = default;
 
   /**
    * Run the event loop until Shutdown() is called.
    *
+   * The loop blocks until an operation completes, it does not wake up
+   * periodically. After Shutdown() it returns once all the cancelled
+   * operations are drained from the queue, each one is notified of its
+   * cancellation.
+   *
    * @param cq the completion queue wrapping this implementation class, used to
    *   notify any asynchronous operation that completes.
    */
   void Run(CompletionQueue& cq);
 
-  /// Terminate the event loop.
-  void Shutdown();
+  /**
+   * Terminate the event loop, cancelling any pending operations.
+   *
+   * @param cq the completion queue wrapping this implementation class, used to
+   *   notify operations that complete without a gRPC event.
+   */
+  void Shutdown(CompletionQueue& cq);
+
+  /// Return true once `Shutdown()` was called.
+  bool IsShutdown() const { return shutdown_.load(); }
 
   /// Create a new alarm object.
   virtual std::unique_ptr<grpc::Alarm> CreateAlarm() const;
 
-  /// The underlying gRPC completion queue.
-  grpc::CompletionQueue& cq() { return cq_; }
+  /**
+   * The underlying gRPC completion queue for a new operation.
+   *
+   * When called from a thread running the event loop this is the queue served
+   * by that thread, so operations started from callbacks complete in the same
+   * thread. Otherwise the queues are used in round-robin order.
+   */
+  grpc::CompletionQueue& cq();
+
+  /// The number of underlying gRPC completion queues.
+  std::size_t num_queues() const { return queues_.size(); }
 
   /// Add a new asynchronous operation to the completion queue.
   void* RegisterOperation(std::shared_ptr<AsyncGrpcOperation> op);
 
+  /**
+   * Register @p op and hand it to gRPC by calling @p start.
+   *
+   * @p start is invoked with the underlying gRPC queue and the tag for @p op.
+   * After `Shutdown()` the operation is not handed to gRPC, it is notified of
+   * its cancellation right away, in the calling thread.
+   *
+   * @param cq the completion queue wrapping this implementation class, used to
+   *   notify the operation if it is rejected.
+   */
+  template <typename Start>
+  void StartOperation(CompletionQueue& cq,
+                      std::shared_ptr<AsyncGrpcOperation> op, Start&& start) {
+    {
+      StartGuard guard(starting_);
+      if (!shutdown_.load()) {
+        void* tag = RegisterOperation(std::move(op));
+        start(this->cq(), tag);
+        return;
+      }
+    }
+    op->NotifyShutdown(cq, false);
+  }
+
  protected:
   /// Return the asynchronous operation associated with @p tag.
   std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
@@ -573,22 +797,52 @@ class CompletionQueueImpl {
   /// unit tests.
   void SimulateCompletion(CompletionQueue& cq, bool ok);
 
-  bool empty() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.empty();
-  }
+  bool empty() const { return size() == 0; }
 
-  std::size_t size() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.size();
-  }
+  std::size_t size() const;
 
  private:
-  grpc::CompletionQueue cq_;
+  /**
+   * A shard of the pending operations registry.
+   *
+   * The pending operations are distributed across several maps, each with its
+   * own mutex, so threads running the event loop rarely contend on a lock.
+   */
+  struct Shard {
+    mutable std::mutex mu;
+    std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
+        pending_ops;
+  };
+
+  static constexpr std::size_t kShardCount = 32;
+
+  /// Return the shard for @p tag.
+  Shard& ShardFor(void* tag);
+
+  /// Unregister and return the operation for @p tag, if it is registered.
+  std::shared_ptr<AsyncGrpcOperation> TakeOperation(void* tag);
+
+  /// Count an operation being started, `Shutdown()` waits for these.
+  class StartGuard {
+   public:
+    explicit StartGuard(std::atomic<std::size_t>& counter) : counter_(counter) {
+      counter_.fetch_add(1);
+    }
+    ~StartGuard() { counter_.fetch_sub(1); }
+
+   private:
+    std::atomic<std::size_t>& counter_;
+  };
+
+  std::vector<std::unique_ptr<grpc::CompletionQueue>> queues_;
+  /// Assign a queue to each thread calling `Run()`.
+  std::atomic<std::size_t> next_runner_;
+  /// Pick a queue for operations started outside the event loop.
+  std::atomic<std::size_t> next_queue_;
   std::atomic<bool> shutdown_;
-  mutable std::mutex mu_;
-  std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
-      pending_ops_;
+  /// The number of operations being handed to gRPC right now.
+  std::atomic<std::size_t> starting_;
+  std::array<Shard, kShardCount> shards_;
 };
 
 }  // namespace internal
@@ -0,0 +1,143 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LEASED_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LEASED_READER_H_
+
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/make_unique.h"
+#include <grpcpp/grpcpp.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A streaming reader that holds a lease until it is destroyed.
+ *
+ * `CommonClient` counts an RPC as outstanding on a channel while the stub it
+ * returned is alive. Streaming and asynchronous RPCs outlive the call that
+ * creates them, so the data client wraps their readers in this class (and the
+ * related classes below) to hold on to the stub until the RPC is done.
+ */
+template <typename Response>
+class LeasedClientReader : public grpc::ClientReaderInterface<Response> {
+ public:
+  LeasedClientReader(
+      std::unique_ptr<grpc::ClientReaderInterface<Response>> reader,
+      std::shared_ptr<void> lease)
+      : reader_(std::move(reader)), lease_(std::move(lease)) {}
+
+  bool NextMessageSize(std::uint32_t* sz) override {
+    return reader_->NextMessageSize(sz);
+  }
+  bool Read(Response* msg) override { return reader_->Read(msg); }
+  void WaitForInitialMetadata() override { reader_->WaitForInitialMetadata(); }
+  grpc::Status Finish() override { return reader_->Finish(); }
+
+ private:
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> reader_;
+  std::shared_ptr<void> lease_;
+};
+
+/// An asynchronous streaming reader that holds a lease until it is destroyed.
+template <typename Response>
+class LeasedClientAsyncReader
+    : public grpc::ClientAsyncReaderInterface<Response> {
+ public:
+  LeasedClientAsyncReader(
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader,
+      std::shared_ptr<void> lease)
+      : reader_(std::move(reader)), lease_(std::move(lease)) {}
+
+  void StartCall(void* tag) override { reader_->StartCall(tag); }
+  void ReadInitialMetadata(void* tag) override {
+    reader_->ReadInitialMetadata(tag);
+  }
+  void Finish(grpc::Status* status, void* tag) override {
+    reader_->Finish(status, tag);
+  }
+  void Read(Response* msg, void* tag) override { reader_->Read(msg, tag); }
+
+ private:
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader_;
+  std::shared_ptr<void> lease_;
+};
+
+/**
+ * An asynchronous unary reader that holds a lease until it is destroyed.
+ *
+ * The completion queue keeps the reader until the RPC completes, so the RPC
+ * counts as outstanding until then.
+ */
+template <typename Response>
+class LeasedClientAsyncResponseReader
+    : public grpc::ClientAsyncResponseReaderInterface<Response> {
+ public:
+  LeasedClientAsyncResponseReader(
+      std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>>
+          reader,
+      std::shared_ptr<void> lease)
+      : reader_(std::move(reader)), lease_(std::move(lease)) {}
+
+  void StartCall() override { reader_->StartCall(); }
+  void ReadInitialMetadata(void* tag) override {
+    reader_->ReadInitialMetadata(tag);
+  }
+  void Finish(Response* msg, grpc::Status* status, void* tag) override {
+    reader_->Finish(msg, status, tag);
+  }
+
+ private:
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>> reader_;
+  std::shared_ptr<void> lease_;
+};
+
+/// Wrap @p reader to hold @p lease until the stream is destroyed.
+template <typename Response>
+std::unique_ptr<grpc::ClientReaderInterface<Response>> MakeLeasedReader(
+    std::unique_ptr<grpc::ClientReaderInterface<Response>> reader,
+    std::shared_ptr<void> lease) {
+  return google::cloud::internal::make_unique<LeasedClientReader<Response>>(
+      std::move(reader), std::move(lease));
+}
+
+/// Wrap @p reader to hold @p lease until the stream is destroyed.
+template <typename Response>
+std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> MakeLeasedReader(
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader,
+    std::shared_ptr<void> lease) {
+  return google::cloud::internal::make_unique<
+      LeasedClientAsyncReader<Response>>(std::move(reader), std::move(lease));
+}
+
+/// Wrap @p reader to hold @p lease until the RPC is destroyed.
+template <typename Response>
+std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>>
+MakeLeasedReader(
+    std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>> reader,
+    std::shared_ptr<void> lease) {
+  return google::cloud::internal::make_unique<
+      LeasedClientAsyncResponseReader<Response>>(std::move(reader),
+                                                 std::move(lease));
+}
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_LEASED_READER_H_
@@ -0,0 +1,87 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MPSC_QUEUE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MPSC_QUEUE_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A lock-free queue with many producers and a single consumer.
+ *
+ * Producers push elements onto an intrusive linked list with a
+ * compare-and-swap loop, they never block each other on a mutex. The consumer
+ * removes all the elements at once, with a single atomic exchange, and gets
+ * them in the order they were pushed. Because elements are never removed one
+ * at a time, the queue is not subject to the ABA problem.
+ *
+ * @tparam T the type of the elements, it must be move constructible.
+ */
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(nullptr) {}
+  ~MpscQueue() { PopAll(); }
+
+  MpscQueue(MpscQueue const&) = delete;
+  MpscQueue& operator=(MpscQueue const&) = delete;
+
+  /// Add @p value to the queue, this is safe to call from multiple threads.
+  void Push(T value) {
+    auto node = new Node{std::move(value), head_.load()};
+    while (!head_.compare_exchange_weak(node->next, node)) {
+    }
+  }
+
+  /// Remove all the elements in the queue, in the order they were pushed.
+  std::vector<T> PopAll() {
+    Node* list = head_.exchange(nullptr);
+    std::vector<T> result;
+    while (list != nullptr) {
+      result.emplace_back(std::move(list->value));
+      Node* next = list->next;
+      delete list;
+      list = next;
+    }
+    // The list is in LIFO order, reverse it to return the oldest first.
+    std::reverse(result.begin(), result.end());
+    return result;
+  }
+
+  /// Return true if the queue is empty, the result may be stale immediately.
+  bool empty() const { return head_.load() == nullptr; }
+
+ private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+  std::atomic<Node*> head_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_MPSC_QUEUE_H_
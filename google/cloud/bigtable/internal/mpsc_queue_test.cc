@@ -0,0 +1,94 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/mpsc_queue.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(MpscQueueTest, Simple) {
+  MpscQueue<std::string> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.PopAll().empty());
+
+  queue.Push("a");
+  queue.Push("b");
+  EXPECT_FALSE(queue.empty());
+  queue.Push("c");
+  EXPECT_THAT(queue.PopAll(), ElementsAre("a", "b", "c"));
+  EXPECT_TRUE(queue.empty());
+
+  queue.Push("d");
+  EXPECT_THAT(queue.PopAll(), ElementsAre("d"));
+}
+
+TEST(MpscQueueTest, MoveOnly) {
+  MpscQueue<std::unique_ptr<int>> queue;
+  queue.Push(std::unique_ptr<int>(new int(42)));
+  // The destructor releases any elements left in the queue.
+  queue.Push(std::unique_ptr<int>(new int(7)));
+  auto values = queue.PopAll();
+  ASSERT_EQ(2U, values.size());
+  EXPECT_EQ(42, *values[0]);
+  EXPECT_EQ(7, *values[1]);
+  queue.Push(std::unique_ptr<int>(new int(3)));
+}
+
+TEST(MpscQueueTest, ManyProducers) {
+  int const producer_count = 8;
+  int const values_per_producer = 10000;
+  MpscQueue<std::pair<int, int>> queue;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p != producer_count; ++p) {
+    producers.emplace_back([&queue, p, values_per_producer] {
+      for (int i = 0; i != values_per_producer; ++i) {
+        queue.Push(std::make_pair(p, i));
+      }
+    });
+  }
+
+  // Consume concurrently with the producers, the elements from each producer
+  // must be received in order.
+  std::vector<int> next(producer_count, 0);
+  int received = 0;
+  while (received != producer_count * values_per_producer) {
+    for (auto const& v : queue.PopAll()) {
+      EXPECT_EQ(next[v.first], v.second);
+      next[v.first] = v.second + 1;
+      ++received;
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,124 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+PrefetchingReadRowsReader::PrefetchingReadRowsReader(
+    std::unique_ptr<Stream> stream, grpc::ClientContext* context,
+    std::size_t max_responses, std::size_t max_bytes)
+    : stream_(std::move(stream)),
+      context_(context),
+      max_responses_(max_responses),
+      max_bytes_(max_bytes),
+      buffered_bytes_(0),
+      done_(false),
+      shutdown_(false) {
+  // Start the thread last, it uses all the other members.
+  reader_ = std::thread(&PrefetchingReadRowsReader::ReadLoop, this);
+}
+
+PrefetchingReadRowsReader::~PrefetchingReadRowsReader() {
+  bool done;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    done = done_;
+  }
+  cv_.notify_all();
+  if (!done) {
+    // Unblock the background thread if it is waiting for a response.
+    context_->TryCancel();
+  }
+  reader_.join();
+}
+
+bool PrefetchingReadRowsReader::Read(
+    google::bigtable::v2::ReadRowsResponse* response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return done_ || !buffer_.empty(); });
+  if (buffer_.empty()) {
+    return false;
+  }
+  response->Swap(&buffer_.front());
+  buffered_bytes_ -= response->ByteSizeLong();
+  buffer_.pop_front();
+  lk.unlock();
+  cv_.notify_all();
+  return true;
+}
+
+grpc::Status PrefetchingReadRowsReader::Finish() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return done_; });
+  return status_;
+}
+
+bool PrefetchingReadRowsReader::NextMessageSize(std::uint32_t* sz) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (buffer_.empty()) {
+    return false;
+  }
+  *sz = static_cast<std::uint32_t>(buffer_.front().ByteSizeLong());
+  return true;
+}
+
+void PrefetchingReadRowsReader::WaitForInitialMetadata() {
+  // The background thread owns the wrapped stream, and the initial metadata is
+  // received with its first `Read()`.
+}
+
+std::size_t PrefetchingReadRowsReader::buffered_responses() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return buffer_.size();
+}
+
+void PrefetchingReadRowsReader::ReadLoop() {
+  google::bigtable::v2::ReadRowsResponse response;
+  while (stream_->Read(&response)) {
+    auto const size = response.ByteSizeLong();
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this, size] {
+      return shutdown_ || buffer_.empty() ||
+             (buffer_.size() < max_responses_ &&
+              buffered_bytes_ + size <= max_bytes_);
+    });
+    if (shutdown_) {
+      break;
+    }
+    buffered_bytes_ += size;
+    buffer_.emplace_back();
+    buffer_.back().Swap(&response);
+    lk.unlock();
+    cv_.notify_all();
+  }
+  auto status = stream_->Finish();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    status_ = std::move(status);
+    done_ = true;
+  }
+  cv_.notify_all();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,104 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Reads a ReadRows stream ahead of its consumer.
+ *
+ * Wraps the stream returned by `DataClient::ReadRows()`. A background thread
+ * reads the responses into a buffer, so the next response is usually available
+ * by the time the consumer has parsed the previous one. Only the reads move to
+ * the background thread, the consumer still parses the responses into rows.
+ * The background thread stops reading when the buffer holds `max_responses`
+ * responses or `max_bytes` bytes, whichever comes first. The buffer always
+ * accepts at least one response, regardless of its size.
+ *
+ * Once the wrapped stream has no more responses the background thread calls
+ * `Finish()` on it. `Read()` returns the buffered responses before reporting
+ * the end of the stream, and `Finish()` returns the status of the wrapped
+ * stream.
+ *
+ * The destructor cancels @p context, which must outlive this object, if the
+ * wrapped stream is still open.
+ */
+class PrefetchingReadRowsReader
+    : public grpc::ClientReaderInterface<
+          google::bigtable::v2::ReadRowsResponse> {
+ public:
+  using Stream =
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>;
+
+  PrefetchingReadRowsReader(std::unique_ptr<Stream> stream,
+                            grpc::ClientContext* context,
+                            std::size_t max_responses, std::size_t max_bytes);
+  ~PrefetchingReadRowsReader() override;
+
+  PrefetchingReadRowsReader(PrefetchingReadRowsReader const&) = delete;
+  PrefetchingReadRowsReader& operator=(PrefetchingReadRowsReader const&) =
+      delete;
+
+  bool Read(google::bigtable::v2::ReadRowsResponse* response) override;
+  grpc::Status Finish() override;
+  bool NextMessageSize(std::uint32_t* sz) override;
+  void WaitForInitialMetadata() override;
+
+  /// The number of responses received but not yet returned by `Read()`.
+  std::size_t buffered_responses() const;
+
+ private:
+  /// The body of the background thread.
+  void ReadLoop();
+
+  std::unique_ptr<Stream> stream_;
+  grpc::ClientContext* context_;
+  std::size_t const max_responses_;
+  std::size_t const max_bytes_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<google::bigtable::v2::ReadRowsResponse> buffer_;
+  std::size_t buffered_bytes_;
+  /// Set when the wrapped stream is finished, `status_` is valid afterwards.
+  bool done_;
+  /// Set by the destructor to stop the background thread.
+  bool shutdown_;
+  grpc::Status status_;
+
+  std::thread reader_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H_
@@ -0,0 +1,175 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/internal/make_unique.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <functional>
+#include <future>
+
+using google::bigtable::v2::ReadRowsResponse;
+using google::cloud::bigtable::internal::PrefetchingReadRowsReader;
+using google::cloud::bigtable::testing::MockReadRowsReader;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+namespace {
+/**
+ * Create a mock stream that returns @p count responses and then @p status.
+ *
+ * @p on_read is called, in the background thread, before each `Read()` with
+ * the number of previous calls.
+ */
+std::unique_ptr<MockReadRowsReader> MakeStream(
+    int count, grpc::Status status, std::atomic<int>& reads,
+    std::function<void(int)> on_read = [](int) {}) {
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*stream, Read(_))
+      .WillRepeatedly(Invoke([count, &reads, on_read](ReadRowsResponse* r) {
+        int n = reads++;
+        on_read(n);
+        if (n >= count) {
+          return false;
+        }
+        r->add_chunks()->set_row_key("r" + std::to_string(n));
+        return true;
+      }));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(status));
+  return stream;
+}
+
+/**
+ * Verify that the background thread never buffers more than @p max responses.
+ *
+ * The background thread only calls `Read()` on the wrapped stream once the
+ * previous response is in the buffer, so checking the buffer size before each
+ * call catches any response buffered over the limit. The consumer only starts
+ * once the buffer is full, when the background thread holds one more response
+ * that does not fit.
+ */
+void CheckBufferLimit(std::size_t max, std::size_t max_bytes) {
+  std::atomic<int> reads(0);
+  grpc::ClientContext context;
+  std::promise<PrefetchingReadRowsReader*> created;
+  auto reader_future = created.get_future().share();
+  std::promise<void> buffer_full;
+  auto on_read = [&](int n) {
+    auto* reader = reader_future.get();
+    EXPECT_GE(max, reader->buffered_responses()) << "n=" << n;
+    if (static_cast<std::size_t>(n) == max) {
+      buffer_full.set_value();
+    }
+  };
+  PrefetchingReadRowsReader reader(
+      MakeStream(5, grpc::Status::OK, reads, on_read), &context, max,
+      max_bytes);
+  created.set_value(&reader);
+  buffer_full.get_future().wait();
+
+  ReadRowsResponse response;
+  int count = 0;
+  while (reader.Read(&response)) {
+    ++count;
+  }
+  EXPECT_EQ(5, count);
+  EXPECT_TRUE(reader.Finish().ok());
+}
+}  // anonymous namespace
+
+/// @test Verify that all the responses are returned in order.
+TEST(PrefetchingReadRowsReaderTest, ReturnsResponsesInOrder) {
+  std::atomic<int> reads(0);
+  grpc::ClientContext context;
+  PrefetchingReadRowsReader reader(MakeStream(3, grpc::Status::OK, reads),
+                                   &context, 10, 1024 * 1024);
+  ReadRowsResponse response;
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_TRUE(reader.Read(&response));
+    ASSERT_EQ(1, response.chunks_size());
+    EXPECT_EQ("r" + std::to_string(i), response.chunks(0).row_key());
+  }
+  EXPECT_FALSE(reader.Read(&response));
+  EXPECT_TRUE(reader.Finish().ok());
+}
+
+/// @test Verify that the responses are read before the consumer asks for them.
+TEST(PrefetchingReadRowsReaderTest, ReadsAhead) {
+  std::atomic<int> reads(0);
+  grpc::ClientContext context;
+  PrefetchingReadRowsReader reader(MakeStream(3, grpc::Status::OK, reads),
+                                   &context, 10, 1024 * 1024);
+  // `Finish()` blocks until the wrapped stream is finished, all the responses
+  // fit in the buffer.
+  EXPECT_TRUE(reader.Finish().ok());
+  EXPECT_EQ(3U, reader.buffered_responses());
+
+  ReadRowsResponse response;
+  int count = 0;
+  while (reader.Read(&response)) {
+    ++count;
+  }
+  EXPECT_EQ(3, count);
+}
+
+/// @test Verify that the number of buffered responses is bounded.
+TEST(PrefetchingReadRowsReaderTest, LimitsBufferedResponses) {
+  CheckBufferLimit(2, 1024 * 1024);
+}
+
+/// @test Verify that the buffered bytes are bounded, but one response fits.
+TEST(PrefetchingReadRowsReaderTest, LimitsBufferedBytes) {
+  CheckBufferLimit(1, 1);
+}
+
+/// @test Verify that errors are returned after the buffered responses.
+TEST(PrefetchingReadRowsReaderTest, ReturnsError) {
+  std::atomic<int> reads(0);
+  grpc::ClientContext context;
+  PrefetchingReadRowsReader reader(
+      MakeStream(2, grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again"),
+                 reads),
+      &context, 10, 1024 * 1024);
+  ReadRowsResponse response;
+  EXPECT_TRUE(reader.Read(&response));
+  EXPECT_TRUE(reader.Read(&response));
+  EXPECT_FALSE(reader.Read(&response));
+  auto status = reader.Finish();
+  EXPECT_EQ(grpc::StatusCode::UNAVAILABLE, status.error_code());
+  EXPECT_EQ("try-again", status.error_message());
+}
+
+/// @test Verify that the destructor stops a blocked background thread.
+TEST(PrefetchingReadRowsReaderTest, DestructorStopsReading) {
+  std::atomic<int> reads(0);
+  grpc::ClientContext context;
+  {
+    // The second call starts once the first response is buffered.
+    std::promise<void> second_read;
+    auto on_read = [&second_read](int n) {
+      if (n == 1) {
+        second_read.set_value();
+      }
+    };
+    PrefetchingReadRowsReader reader(
+        MakeStream(100, grpc::Status::OK, reads, on_read), &context, 1,
+        1024 * 1024);
+    second_read.get_future().wait();
+  }
+  // The wrapped stream is finished without reading all the responses.
+  EXPECT_GT(100, reads.load());
+}
@@ -0,0 +1,75 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/read_rows_arena_pool.h"
+#include "google/cloud/internal/make_unique.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::size_t constexpr ReadRowsArenaPool::kDefaultBlockSize;
+std::size_t constexpr ReadRowsArenaPool::kMaxBlockSize;
+
+google::bigtable::v2::ReadRowsResponse* ReadRowsArenaPool::NewResponse() {
+  if (free_.empty()) {
+    in_use_.emplace_back(MakeEntry());
+  } else {
+    in_use_.emplace_back(std::move(free_.back()));
+    free_.pop_back();
+  }
+  return google::protobuf::Arena::CreateMessage<
+      google::bigtable::v2::ReadRowsResponse>(in_use_.back().arena.get());
+}
+
+void ReadRowsArenaPool::Release(std::size_t keep) {
+  while (in_use_.size() > keep) {
+    Entry entry = std::move(in_use_.front());
+    in_use_.pop_front();
+    auto const allocated =
+        static_cast<std::size_t>(entry.arena->SpaceAllocated());
+    if (allocated > block_size_ && block_size_ < kMaxBlockSize) {
+      // The response did not fit in the initial block, use larger blocks for
+      // new arenas.
+      block_size_ = (std::min)(kMaxBlockSize, allocated);
+    }
+    if (entry.block_size < block_size_) {
+      // Discard the arenas created with smaller blocks.
+      continue;
+    }
+    entry.arena->Reset();
+    free_.emplace_back(std::move(entry));
+  }
+}
+
+ReadRowsArenaPool::Entry ReadRowsArenaPool::MakeEntry() const {
+  Entry entry;
+  entry.block.reset(new char[block_size_]);
+  entry.block_size = block_size_;
+  google::protobuf::ArenaOptions options;
+  options.initial_block = entry.block.get();
+  options.initial_block_size = block_size_;
+  entry.arena =
+      google::cloud::internal::make_unique<google::protobuf::Arena>(options);
+  return entry;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
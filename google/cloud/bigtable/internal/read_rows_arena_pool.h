@@ -0,0 +1,89 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_ARENA_POOL_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_ARENA_POOL_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <google/protobuf/arena.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Recycles the `google::protobuf::Arena` objects used to receive ReadRows
+ * responses.
+ *
+ * Each arena is created with an initial block owned by the pool. Resetting an
+ * arena keeps that block, so once the blocks are large enough to hold the
+ * typical response, receiving a response does not allocate any message
+ * objects. With this version of protobuf the string fields, including the cell
+ * values, are still allocated on the heap. The size of new blocks tracks the
+ * largest response seen so far, up to `kMaxBlockSize`.
+ *
+ * The arenas are used in FIFO order: rows may span multiple responses, so
+ * several responses may be in use at the same time.
+ */
+class ReadRowsArenaPool {
+ public:
+  /// The initial block size for a new pool.
+  static std::size_t constexpr kDefaultBlockSize = 64 * 1024;
+
+  /// The maximum size for the initial block of each arena.
+  static std::size_t constexpr kMaxBlockSize = 4 * 1024 * 1024;
+
+  explicit ReadRowsArenaPool(std::size_t block_size = kDefaultBlockSize)
+      : block_size_(block_size) {}
+
+  /// Create a new response, its arena is in use until it is released.
+  google::bigtable::v2::ReadRowsResponse* NewResponse();
+
+  /// Recycle the arenas in use, except for the @p keep most recent ones.
+  void Release(std::size_t keep);
+
+  /// The number of arenas in use.
+  std::size_t in_use() const { return in_use_.size(); }
+
+  /// The size of the initial block for new arenas.
+  std::size_t block_size() const { return block_size_; }
+
+ private:
+  struct Entry {
+    // The block must outlive the arena, keep it first.
+    std::unique_ptr<char[]> block;
+    std::size_t block_size;
+    std::unique_ptr<google::protobuf::Arena> arena;
+  };
+
+  Entry MakeEntry() const;
+
+  std::deque<Entry> in_use_;
+  std::vector<Entry> free_;
+  std::size_t block_size_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_ROWS_ARENA_POOL_H_
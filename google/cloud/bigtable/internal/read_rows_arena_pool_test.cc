@@ -0,0 +1,70 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/read_rows_arena_pool.h"
+#include <gtest/gtest.h>
+
+using google::cloud::bigtable::internal::ReadRowsArenaPool;
+
+/// @test Verify that arenas are recycled in FIFO order.
+TEST(ReadRowsArenaPoolTest, RecycleArenas) {
+  ReadRowsArenaPool pool;
+  auto* r1 = pool.NewResponse();
+  auto* r2 = pool.NewResponse();
+  ASSERT_NE(nullptr, r1);
+  ASSERT_NE(nullptr, r2);
+  EXPECT_NE(r1->GetArena(), r2->GetArena());
+  EXPECT_EQ(2U, pool.in_use());
+
+  // Release all but the most recent, the oldest arena is reused first.
+  auto* arena = r1->GetArena();
+  pool.Release(1);
+  EXPECT_EQ(1U, pool.in_use());
+  auto* r3 = pool.NewResponse();
+  EXPECT_EQ(arena, r3->GetArena());
+  EXPECT_EQ(2U, pool.in_use());
+
+  pool.Release(0);
+  EXPECT_EQ(0U, pool.in_use());
+}
+
+/// @test Verify that the blocks grow to fit large responses.
+TEST(ReadRowsArenaPoolTest, BlocksGrow) {
+  ReadRowsArenaPool pool(1024);
+  EXPECT_EQ(1024U, pool.block_size());
+
+  auto* response = pool.NewResponse();
+  for (int i = 0; i != 1000; ++i) {
+    response->add_chunks()->set_commit_row(true);
+  }
+  pool.Release(0);
+  EXPECT_LT(1024U, pool.block_size());
+  auto const grown = pool.block_size();
+
+  // Responses that fit in the blocks do not change the size.
+  response = pool.NewResponse();
+  response->add_chunks()->set_commit_row(true);
+  pool.Release(0);
+  EXPECT_EQ(grown, pool.block_size());
+
+  // The blocks never grow beyond the maximum size.
+  response = pool.NewResponse();
+  while (response->GetArena()->SpaceAllocated() <
+         2 * ReadRowsArenaPool::kMaxBlockSize) {
+    response->add_chunks()->set_commit_row(true);
+  }
+  pool.Release(0);
+  EXPECT_EQ(ReadRowsArenaPool::kMaxBlockSize, pool.block_size());
+}
@@ -22,6 +22,24 @@ inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 using google::bigtable::v2::ReadRowsResponse_CellChunk;
 
+namespace {
+// There are rarely more than a few column families in a table.
+std::size_t constexpr kMaxInternedFamilies = 128;
+// Wide rows often use a fixed set of column qualifiers, but some schemas use
+// data in the qualifiers, in that case the pool is just reset periodically.
+std::size_t constexpr kMaxInternedColumns = 4096;
+
+SharedCell::StringPtr const& EmptyString() {
+  static auto const* const kEmpty =
+      new SharedCell::StringPtr(std::make_shared<std::string const>());
+  return *kEmpty;
+}
+
+std::string const& ValueOrEmpty(std::string const* value) {
+  return value == nullptr ? *EmptyString() : *value;
+}
+}  // namespace
+
 void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                                  grpc::Status& status) {
   if (end_of_stream_) {
@@ -50,11 +68,23 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "New column family must specify qualifier");
       return;
     }
-    chunk.mutable_family_name()->mutable_value()->swap(cell_.family);
+    auto& family = *chunk.mutable_family_name()->mutable_value();
+    if (share_strings_) {
+      cell_.shared_family =
+          Intern(families_, std::move(family), kMaxInternedFamilies);
+    } else {
+      family.swap(cell_.family);
+    }
   }
 
   if (chunk.has_qualifier()) {
-    chunk.mutable_qualifier()->mutable_value()->swap(cell_.column);
+    auto& column = *chunk.mutable_qualifier()->mutable_value();
+    if (share_strings_) {
+      cell_.shared_column =
+          Intern(columns_, std::move(column), kMaxInternedColumns);
+    } else {
+      column.swap(cell_.column);
+    }
   }
 
   if (cell_first_chunk_) {
@@ -80,7 +110,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   // Last chunk in the cell has zero for value size
   if (chunk.value_size() == 0) {
-    if (cells_.empty()) {
+    if (!HasCells()) {
       if (cell_.row.empty()) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Missing row key at last chunk in cell");
@@ -94,12 +124,21 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
         return;
       }
     }
-    cells_.emplace_back(MovePartialToCell());
+    if (share_strings_) {
+      if (!shared_row_key_) {
+        shared_row_key_ = std::make_shared<std::string const>(row_key_);
+      }
+      shared_cells_.emplace_back(MovePartialToSharedCell());
+    } else {
+      cells_.emplace_back(MovePartialToCell());
+    }
     cell_first_chunk_ = true;
   }
 
   if (chunk.reset_row()) {
     cells_.clear();
+    shared_cells_.clear();
+    shared_row_key_.reset();
     cell_ = {};
     if (!cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -112,7 +151,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "Commit row with an unfinished cell");
       return;
     }
-    if (cells_.empty()) {
+    if (!HasCells()) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Commit row missing the row key");
       return;
@@ -137,7 +176,7 @@ void ReadRowsParser::HandleEndOfStream(grpc::Status& status) {
     return;
   }
 
-  if (cells_.begin() != cells_.end() && !row_ready_) {
+  if ((HasCells() || !view_cells_.empty()) && !row_ready_) {
     status = grpc::Status(grpc::StatusCode::INTERNAL,
                           "end of stream with unfinished row");
     return;
@@ -152,14 +191,206 @@ Row ReadRowsParser::Next(grpc::Status& status) {
         grpc::Status(grpc::StatusCode::INTERNAL, "Next with row not ready");
     return Row("", {});
   }
+  if (share_strings_) {
+    return NextShared(status).ToRow();
+  }
   row_ready_ = false;
 
   Row row(std::move(row_key_), std::move(cells_));
   row_key_.clear();
+  cells_.clear();
 
   return row;
 }
 
+SharedRow ReadRowsParser::NextShared(grpc::Status& status) {
+  if (!row_ready_) {
+    status =
+        grpc::Status(grpc::StatusCode::INTERNAL, "Next with row not ready");
+    return SharedRow(EmptyString(), {});
+  }
+  row_ready_ = false;
+
+  if (!share_strings_) {
+    // The cells were built for `Next()`, copy them into the shared format.
+    auto key = std::make_shared<std::string const>(std::move(row_key_));
+    std::vector<SharedCell> cells;
+    cells.reserve(cells_.size());
+    for (auto const& c : cells_) {
+      cells.emplace_back(key,
+                         std::make_shared<std::string const>(c.family_name()),
+                         std::make_shared<std::string const>(
+                             c.column_qualifier()),
+                         c.timestamp().count(), c.value(), c.labels());
+    }
+    row_key_.clear();
+    cells_.clear();
+    return SharedRow(std::move(key), std::move(cells));
+  }
+
+  SharedRow row(std::move(shared_row_key_), std::move(shared_cells_));
+  row_key_.clear();
+  shared_row_key_.reset();
+  shared_cells_.clear();
+
+  return row;
+}
+
+void ReadRowsParser::HandleChunkView(ReadRowsResponse_CellChunk const& chunk,
+                                     grpc::Status& status) {
+  if (end_of_stream_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleChunk after end of stream");
+    return;
+  }
+  if (HasNext()) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "HandleChunk called before taking the previous row");
+    return;
+  }
+
+  if (!chunk.row_key().empty()) {
+    if (last_seen_row_key_.compare(chunk.row_key()) >= 0) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Row keys are expected in increasing order");
+      return;
+    }
+    view_cell_.row = &chunk.row_key();
+  }
+
+  if (chunk.has_family_name()) {
+    if (!chunk.has_qualifier()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "New column family must specify qualifier");
+      return;
+    }
+    view_cell_.family = &chunk.family_name().value();
+  }
+
+  if (chunk.has_qualifier()) {
+    view_cell_.column = &chunk.qualifier().value();
+  }
+
+  if (cell_first_chunk_) {
+    // Labels are only set in the first chunk of each cell.
+    view_cell_.timestamp = chunk.timestamp_micros();
+    view_cell_.labels = &chunk.labels();
+    if (chunk.value_size() == 0) {
+      // Most common case, the value is in a single chunk.
+      view_cell_.value = &chunk.value();
+    } else {
+      view_value_ = &NextSplitValue();
+      view_value_->reserve(chunk.value_size());
+      view_value_->assign(chunk.value());
+      view_cell_.value = view_value_;
+    }
+  } else {
+    view_value_->append(chunk.value());
+  }
+
+  cell_first_chunk_ = false;
+
+  // Last chunk in the cell has zero for value size
+  if (chunk.value_size() == 0) {
+    if (view_cells_.empty()) {
+      if (view_cell_.row == nullptr) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL,
+                              "Missing row key at last chunk in cell");
+        return;
+      }
+      view_row_key_ = view_cell_.row;
+    } else {
+      if (*view_row_key_ != *view_cell_.row) {
+        status = grpc::Status(grpc::StatusCode::INTERNAL,
+                              "Different row key in cell chunk");
+        return;
+      }
+    }
+    view_cells_.emplace_back(*view_row_key_, ValueOrEmpty(view_cell_.family),
+                             ValueOrEmpty(view_cell_.column),
+                             view_cell_.timestamp, *view_cell_.value,
+                             *view_cell_.labels);
+    cell_first_chunk_ = true;
+  }
+
+  if (chunk.reset_row()) {
+    view_cells_.clear();
+    view_cell_ = {};
+    split_values_used_ = 0;
+    if (!cell_first_chunk_) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Reset row with an unfinished cell");
+      return;
+    }
+  } else if (chunk.commit_row()) {
+    if (!cell_first_chunk_) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Commit row with an unfinished cell");
+      return;
+    }
+    if (view_cells_.empty()) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Commit row missing the row key");
+      return;
+    }
+    row_ready_ = true;
+    last_seen_row_key_ = *view_row_key_;
+    view_cell_.row = nullptr;
+  }
+}
+
+RowView ReadRowsParser::NextView(grpc::Status& status) {
+  if (!row_ready_) {
+    status =
+        grpc::Status(grpc::StatusCode::INTERNAL, "Next with row not ready");
+    returned_view_cells_.clear();
+    return RowView(*EmptyString(), returned_view_cells_);
+  }
+  row_ready_ = false;
+
+  // The buffers are swapped, so the returned row remains valid while the
+  // parser receives the chunks for the next row.
+  view_cells_.swap(returned_view_cells_);
+  view_cells_.clear();
+  split_values_.swap(returned_split_values_);
+  split_values_used_ = 0;
+
+  carried_index_ = 1 - carried_index_;
+  if (view_cell_.family != nullptr) {
+    carried_family_[carried_index_] = *view_cell_.family;
+    view_cell_.family = &carried_family_[carried_index_];
+  }
+  if (view_cell_.column != nullptr) {
+    carried_column_[carried_index_] = *view_cell_.column;
+    view_cell_.column = &carried_column_[carried_index_];
+  }
+
+  return RowView(*view_row_key_, returned_view_cells_);
+}
+
+std::string& ReadRowsParser::NextSplitValue() {
+  if (split_values_used_ == split_values_.size()) {
+    split_values_.emplace_back();
+  }
+  return split_values_[split_values_used_++];
+}
+
+ReadRowsParser::StringPtr ReadRowsParser::Intern(
+    std::unordered_map<std::string, StringPtr>& pool, std::string&& value,
+    std::size_t max_size) {
+  auto loc = pool.find(value);
+  if (loc != pool.end()) {
+    return loc->second;
+  }
+  if (pool.size() >= max_size) {
+    pool.clear();
+  }
+  // The map needs its own key, this is the only copy of the string.
+  auto shared = std::make_shared<std::string const>(value);
+  pool.emplace(std::move(value), shared);
+  return shared;
+}
+
 Cell ReadRowsParser::MovePartialToCell() {
   // The row, family, and column are explicitly copied because the
   // ReadRows v2 may reuse them in future chunks. See the CellChunk
@@ -169,6 +400,20 @@ Cell ReadRowsParser::MovePartialToCell() {
   cell_.value.clear();
   return cell;
 }
+
+SharedCell ReadRowsParser::MovePartialToSharedCell() {
+  // The row, family, and column are shared because the ReadRows v2 may reuse
+  // them in future chunks. See the CellChunk message comments in
+  // bigtable.proto.
+  SharedCell cell(shared_row_key_,
+                  cell_.shared_family ? cell_.shared_family : EmptyString(),
+                  cell_.shared_column ? cell_.shared_column : EmptyString(),
+                  cell_.timestamp, std::move(cell_.value),
+                  std::move(cell_.labels));
+  cell_.value.clear();
+  cell_.labels.clear();
+  return cell;
+}
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
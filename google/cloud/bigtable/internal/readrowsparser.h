@@ -20,6 +20,9 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <array>
+#include <deque>
+#include <unordered_map>
 #include <vector>
 
 namespace google {
@@ -54,11 +57,17 @@ class ReadRowsParser {
   ReadRowsParser()
       : row_key_(""),
         cells_(),
+        share_strings_(false),
         cell_first_chunk_(true),
         cell_(),
         last_seen_row_key_(""),
         row_ready_(false),
-        end_of_stream_(false) {}
+        end_of_stream_(false),
+        view_cell_(),
+        view_row_key_(nullptr),
+        view_value_(nullptr),
+        split_values_used_(0),
+        carried_index_(0) {}
 
   virtual ~ReadRowsParser() = default;
 
@@ -98,17 +107,73 @@ class ReadRowsParser {
    */
   virtual Row Next(grpc::Status& status);
 
+  /**
+   * Extract the data in a row, sharing the row key, family and column storage.
+   *
+   * This is the same as `Next()`, but the cells in the returned row share the
+   * row key. If `set_share_strings(true)` was called before the first chunk,
+   * the column families and qualifiers are also interned for the lifetime of
+   * the parser, otherwise each cell gets its own copy.
+   */
+  virtual SharedRow NextShared(grpc::Status& status);
+
+  /**
+   * Build the cells with shared strings, optimized for `NextShared()`.
+   *
+   * By default the parser builds `Cell` objects, optimized for `Next()`. Call
+   * this before the first call to `HandleChunk()`. Either extraction function
+   * works in both modes, but converting between the representations copies
+   * the data.
+   */
+  void set_share_strings(bool v) { share_strings_ = v; }
+
+  /**
+   * Pass an input chunk proto to the parser, referring to its data in place.
+   *
+   * This is an alternative to `HandleChunk()` that does not copy the chunk
+   * data into `Cell` objects. The cells returned by `NextView()` refer to the
+   * data in @p chunk, so the chunk must remain valid and unmodified until that
+   * row is consumed. Only the values split across multiple chunks are copied,
+   * into buffers owned (and recycled) by the parser. Do not mix calls to this
+   * function and `HandleChunk()`.
+   */
+  virtual void HandleChunkView(
+      google::bigtable::v2::ReadRowsResponse_CellChunk const& chunk,
+      grpc::Status& status);
+
+  /**
+   * Return a view of the next row received via `HandleChunkView()`.
+   *
+   * The returned view is valid until the next call to `NextView()`.
+   */
+  virtual RowView NextView(grpc::Status& status);
+
  private:
+  using StringPtr = SharedCell::StringPtr;
+
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
     std::string row;
     std::string family;
     std::string column;
+    /// The interned family and column, only used if `share_strings_` is set.
+    StringPtr shared_family;
+    StringPtr shared_column;
     int64_t timestamp;
     std::string value;
     std::vector<std::string> labels;
   };
 
+  /**
+   * Returns a shared copy of @p value, reusing a previous copy if possible.
+   *
+   * Column families and qualifiers are repeated in every row of a stream, the
+   * pool is cleared if it grows beyond @p max_size entries, to bound the
+   * memory used by streams with many distinct columns.
+   */
+  static StringPtr Intern(std::unordered_map<std::string, StringPtr>& pool,
+                          std::string&& value, std::size_t max_size);
+
   /**
    * Moves partial results into a Cell class.
    *
@@ -118,12 +183,48 @@ class ReadRowsParser {
    */
   Cell MovePartialToCell();
 
+  /**
+   * Moves partial results into a SharedCell class.
+   *
+   * The value is moved when converting to a result cell, while the key, family
+   * and column are shared, because they are possibly reused by following
+   * cells.
+   */
+  SharedCell MovePartialToSharedCell();
+
+  /// True if the current row has any complete cells.
+  bool HasCells() const { return !cells_.empty() || !shared_cells_.empty(); }
+
+  /// Holds references to the partially formed data in HandleChunkView().
+  struct ViewCell {
+    std::string const* row;
+    std::string const* family;
+    std::string const* column;
+    std::int64_t timestamp;
+    std::string const* value;
+    CellView::Labels const* labels;
+  };
+
+  /// Returns a buffer to assemble a value split across chunks.
+  std::string& NextSplitValue();
+
   /// Row key for the current row.
   std::string row_key_;
 
   /// Parsed cells of a yet unfinished row.
   std::vector<Cell> cells_;
 
+  //@{
+  /// @name State used when `share_strings_` is set.
+  bool share_strings_;
+  StringPtr shared_row_key_;
+  std::vector<SharedCell> shared_cells_;
+  //@}
+
+  /// Interned column families and qualifiers seen in this stream.
+  std::unordered_map<std::string, StringPtr> families_;
+  std::unordered_map<std::string, StringPtr> columns_;
+
   /// Is the next incoming chunk the first in a cell?
   bool cell_first_chunk_;
 
@@ -138,6 +239,31 @@ class ReadRowsParser {
 
   /// Have we received the end of stream call?
   bool end_of_stream_;
+
+  //@{
+  /// @name State used by HandleChunkView() and NextView().
+  ViewCell view_cell_;
+  std::string const* view_row_key_;
+  std::vector<CellView> view_cells_;
+  std::vector<CellView> returned_view_cells_;
+
+  /// The value being assembled from multiple chunks, if any.
+  std::string* view_value_;
+  std::deque<std::string> split_values_;
+  std::deque<std::string> returned_split_values_;
+  std::size_t split_values_used_;
+
+  /**
+   * Copies of the last column family and qualifier.
+   *
+   * The next row may omit them, but the chunks where they were received may be
+   * recycled once the current row is consumed. The cells in the returned row
+   * may refer to the previous copy, so the copies are double buffered.
+   */
+  std::array<std::string, 2> carried_family_;
+  std::array<std::string, 2> carried_column_;
+  int carried_index_;
+  //@}
 };
 
 /// Factory for creating parser instances, defined for testability.
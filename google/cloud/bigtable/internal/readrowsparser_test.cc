@@ -133,6 +133,189 @@ TEST(ReadRowsParserTest, NextWithNoDataThrows) {
   EXPECT_FALSE(status.ok());
 }
 
+TEST(ReadRowsParserTest, NextSharedInternsStrings) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  parser.set_share_strings(true);
+  std::vector<std::string> chunks = {
+      R"(
+    row_key: "RK1"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    value: "V1"
+    )",
+      R"(
+    qualifier: < value: "C2">
+    timestamp_micros: 42
+    value: "V2"
+    commit_row: true
+    )",
+      R"(
+    row_key: "RK2"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    value: "V3"
+    commit_row: true
+    )",
+  };
+
+  grpc::Status status;
+  std::vector<google::cloud::bigtable::SharedRow> rows;
+  for (auto const& text : chunks) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_TRUE(status.ok());
+    if (parser.HasNext()) {
+      rows.emplace_back(parser.NextShared(status));
+      ASSERT_TRUE(status.ok());
+    }
+  }
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, rows.size());
+  ASSERT_EQ(2U, rows[0].cells().size());
+  ASSERT_EQ(1U, rows[1].cells().size());
+  auto const& c1 = rows[0].cells()[0];
+  auto const& c2 = rows[0].cells()[1];
+  auto const& c3 = rows[1].cells()[0];
+  EXPECT_EQ("RK1", c1.row_key());
+  EXPECT_EQ("C2", c2.column_qualifier());
+  EXPECT_EQ("V3", c3.value());
+
+  // The cells in a row share the row key, and the column families and
+  // qualifiers are shared across rows.
+  EXPECT_EQ(&rows[0].row_key(), &c1.row_key());
+  EXPECT_EQ(&c1.row_key(), &c2.row_key());
+  EXPECT_EQ(&c1.family_name(), &c2.family_name());
+  EXPECT_EQ(&c1.family_name(), &c3.family_name());
+  EXPECT_EQ(&c1.column_qualifier(), &c3.column_qualifier());
+  EXPECT_NE(&c1.column_qualifier(), &c2.column_qualifier());
+}
+
+TEST(ReadRowsParserTest, NextSharedWithoutSharing) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse_CellChunk chunk;
+  ASSERT_TRUE(TextFormat::ParseFromString(R"(
+    row_key: "RK1"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    labels: "L"
+    value: "V1"
+    commit_row: true
+    )",
+                                          &chunk));
+
+  grpc::Status status;
+  parser.HandleChunk(std::move(chunk), status);
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  // The parser built a `Cell`, it is converted to the shared representation.
+  auto row = parser.NextShared(status);
+  ASSERT_TRUE(status.ok());
+  ASSERT_EQ(1U, row.cells().size());
+  auto const& c = row.cells()[0];
+  EXPECT_EQ(&row.row_key(), &c.row_key());
+  EXPECT_EQ("F", c.family_name());
+  EXPECT_EQ("C1", c.column_qualifier());
+  EXPECT_EQ(42, c.timestamp().count());
+  EXPECT_EQ("V1", c.value());
+  EXPECT_EQ(std::vector<std::string>{"L"}, c.labels());
+}
+
+TEST(ReadRowsParserTest, NextViewDoesNotCopy) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  std::vector<std::string> text_chunks = {
+      R"(
+    row_key: "RK1"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    labels: "L"
+    value: "V1"
+    )",
+      R"(
+    qualifier: < value: "C2">
+    timestamp_micros: 42
+    value: "V2-"
+    value_size: 6
+    )",
+      R"(
+    value: "split"
+    commit_row: true
+    )",
+      R"(
+    row_key: "RK2"
+    timestamp_micros: 42
+    value: "V3"
+    commit_row: true
+    )",
+  };
+  std::vector<ReadRowsResponse_CellChunk> chunks(text_chunks.size());
+  for (std::size_t i = 0; i != chunks.size(); ++i) {
+    ASSERT_TRUE(TextFormat::ParseFromString(text_chunks[i], &chunks[i]));
+  }
+
+  grpc::Status status;
+  parser.HandleChunkView(chunks[0], status);
+  ASSERT_TRUE(status.ok());
+  parser.HandleChunkView(chunks[1], status);
+  ASSERT_TRUE(status.ok());
+  parser.HandleChunkView(chunks[2], status);
+  ASSERT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto r1 = parser.NextView(status);
+  ASSERT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, r1.cells().size());
+  auto const& c1 = r1.cells()[0];
+  auto const& c2 = r1.cells()[1];
+  EXPECT_EQ("RK1", r1.row_key());
+  EXPECT_EQ("F", c1.family_name());
+  EXPECT_EQ("C1", c1.column_qualifier());
+  EXPECT_EQ("V1", c1.value());
+  ASSERT_EQ(1, c1.labels().size());
+  EXPECT_EQ("L", c1.labels().Get(0));
+  EXPECT_EQ("C2", c2.column_qualifier());
+  EXPECT_EQ("V2-split", c2.value());
+
+  // The cells refer to the data in the chunks, except for split values.
+  EXPECT_EQ(&chunks[0].row_key(), &r1.row_key());
+  EXPECT_EQ(&chunks[0].row_key(), &c2.row_key());
+  EXPECT_EQ(&chunks[0].family_name().value(), &c2.family_name());
+  EXPECT_EQ(&chunks[1].qualifier().value(), &c2.column_qualifier());
+  EXPECT_EQ(&chunks[0].value(), &c1.value());
+
+  // The second row uses the family and qualifier of the first row, and the
+  // view of the first row is still valid while it is parsed.
+  parser.HandleChunkView(chunks[3], status);
+  ASSERT_TRUE(status.ok());
+  EXPECT_EQ("V2-split", c2.value());
+  ASSERT_TRUE(parser.HasNext());
+  auto r2 = parser.NextView(status);
+  ASSERT_TRUE(status.ok());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+
+  ASSERT_EQ(1U, r2.cells().size());
+  auto const& c3 = r2.cells()[0];
+  EXPECT_EQ("RK2", c3.row_key());
+  EXPECT_EQ("F", c3.family_name());
+  EXPECT_EQ("C2", c3.column_qualifier());
+  EXPECT_EQ(&chunks[3].value(), &c3.value());
+
+  auto row = r2.ToRow();
+  EXPECT_EQ("RK2", row.row_key());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("V3", row.cells()[0].value());
+}
+
 // **** Acceptance tests helpers ****
 
 namespace google {
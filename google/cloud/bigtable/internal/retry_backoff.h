@@ -0,0 +1,86 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RETRY_BACKOFF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RETRY_BACKOFF_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include <chrono>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Return true if a backoff of @p delay ends before the retry deadline.
+ *
+ * There is no point in waiting for the next attempt if the retry policy would
+ * give up before it starts, the retry loops report the last error instead.
+ */
+inline bool BackoffWithinDeadline(RPCRetryPolicy const& retry_policy,
+                                  std::chrono::milliseconds delay) {
+  return std::chrono::system_clock::now() + delay <
+         retry_policy.retry_deadline();
+}
+
+/**
+ * Wait for the backoff before the next attempt of a synchronous retry loop.
+ *
+ * Synchronous calls block the calling thread until they complete, so this
+ * function sleeps. The asynchronous loops use `AsyncBackoffBeforeRetry()`.
+ *
+ * @return false, without waiting, if the backoff would end after the retry
+ *     deadline of @p retry_policy. The caller should stop retrying.
+ */
+inline bool BackoffBeforeRetry(RPCRetryPolicy const& retry_policy,
+                               std::chrono::milliseconds delay) {
+  if (!BackoffWithinDeadline(retry_policy, delay)) {
+    return false;
+  }
+  std::this_thread::sleep_for(delay);
+  return true;
+}
+
+/**
+ * Start the backoff before the next attempt of an asynchronous retry loop.
+ *
+ * The backoff is a timer in @p cq, no thread is blocked while it runs.
+ *
+ * @return a future satisfied with true when the backoff expires, or satisfied
+ *     immediately with false if the backoff would end after the retry deadline
+ *     of @p retry_policy.
+ */
+inline future<bool> AsyncBackoffBeforeRetry(CompletionQueue& cq,
+                                            RPCRetryPolicy const& retry_policy,
+                                            std::chrono::milliseconds delay) {
+  if (!BackoffWithinDeadline(retry_policy, delay)) {
+    return make_ready_future(false);
+  }
+  return cq.MakeRelativeTimer(delay).then(
+      [](future<std::chrono::system_clock::time_point>) { return true; });
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RETRY_BACKOFF_H_
@@ -0,0 +1,78 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/retry_backoff.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+/// @test Verify that backoffs past the retry deadline are rejected.
+TEST(RetryBackoffTest, WithinDeadline) {
+  LimitedTimeRetryPolicy limited_time(1_s);
+  EXPECT_TRUE(BackoffWithinDeadline(limited_time, 10_ms));
+  EXPECT_FALSE(BackoffWithinDeadline(limited_time, 2_s));
+
+  LimitedErrorCountRetryPolicy error_count(3);
+  EXPECT_TRUE(BackoffWithinDeadline(error_count, 10_ms));
+  EXPECT_TRUE(BackoffWithinDeadline(error_count, 24_h));
+}
+
+/// @test Verify that the synchronous backoff only waits within the deadline.
+TEST(RetryBackoffTest, BackoffBeforeRetry) {
+  LimitedTimeRetryPolicy policy(1_s);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(BackoffBeforeRetry(policy, 10_ms));
+  EXPECT_LE(10_ms, std::chrono::steady_clock::now() - start);
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(BackoffBeforeRetry(policy, 60_s));
+  EXPECT_GT(30_s, std::chrono::steady_clock::now() - start);
+}
+
+/// @test Verify that the asynchronous backoff uses a timer.
+TEST(RetryBackoffTest, AsyncBackoffBeforeRetry) {
+  LimitedTimeRetryPolicy policy(1_s);
+  CompletionQueue cq;
+
+  // With no thread running the completion queue the timer cannot expire.
+  auto backoff = AsyncBackoffBeforeRetry(cq, policy, 10_ms);
+  EXPECT_EQ(std::future_status::timeout, backoff.wait_for(50_ms));
+
+  std::thread runner([&cq] { cq.Run(); });
+  EXPECT_TRUE(backoff.get());
+
+  auto expired = AsyncBackoffBeforeRetry(cq, policy, 60_s);
+  EXPECT_EQ(std::future_status::ready, expired.wait_for(0_ms));
+  EXPECT_FALSE(expired.get());
+
+  cq.Shutdown();
+  runner.join();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
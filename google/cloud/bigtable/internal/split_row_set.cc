@@ -0,0 +1,56 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/split_row_set.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::vector<RowSet> SplitRowSet(RowSet const& row_set,
+                                std::vector<RowKeySample> const& samples) {
+  std::vector<std::string> keys;
+  keys.reserve(samples.size());
+  for (auto const& s : samples) {
+    if (!s.row_key.empty()) {
+      keys.push_back(s.row_key);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<RowSet> result;
+  auto add_shard = [&row_set, &result](RowRange const& range) {
+    auto shard = row_set.Intersect(range);
+    if (!shard.IsEmpty()) {
+      result.emplace_back(std::move(shard));
+    }
+  };
+  std::string begin;
+  for (auto& key : keys) {
+    add_shard(RowRange::RightOpen(std::move(begin), key));
+    begin = std::move(key);
+  }
+  add_shard(RowRange::StartingAt(std::move(begin)));
+  return result;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,93 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/internal/split_row_set.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::RowKeySample;
+using bigtable::RowRange;
+using bigtable::RowSet;
+using bigtable::internal::SplitRowSet;
+
+namespace {
+std::vector<RowKeySample> MakeSamples(std::vector<std::string> keys) {
+  std::vector<RowKeySample> samples;
+  std::int64_t offset = 0;
+  for (auto& k : keys) {
+    samples.push_back(RowKeySample{std::move(k), offset += 1000});
+  }
+  return samples;
+}
+
+/// Return the only range in @p row_set.
+RowRange OnlyRange(RowSet const& row_set) {
+  EXPECT_EQ(0, row_set.as_proto().row_keys_size());
+  EXPECT_EQ(1, row_set.as_proto().row_ranges_size());
+  return RowRange(row_set.as_proto().row_ranges(0));
+}
+}  // anonymous namespace
+
+/// @test Verify that a full table scan is split at each sample.
+TEST(SplitRowSetTest, FullTable) {
+  auto shards = SplitRowSet(RowSet(), MakeSamples({"k1", "k2", ""}));
+  ASSERT_EQ(3U, shards.size());
+  EXPECT_EQ(RowRange::RightOpen("", "k1"), OnlyRange(shards[0]));
+  EXPECT_EQ(RowRange::RightOpen("k1", "k2"), OnlyRange(shards[1]));
+  EXPECT_EQ(RowRange::StartingAt("k2"), OnlyRange(shards[2]));
+}
+
+/// @test Verify that the samples are sorted and duplicates removed.
+TEST(SplitRowSetTest, UnsortedSamples) {
+  auto shards = SplitRowSet(RowSet(), MakeSamples({"k2", "k1", "k2"}));
+  ASSERT_EQ(3U, shards.size());
+  EXPECT_EQ(RowRange::RightOpen("", "k1"), OnlyRange(shards[0]));
+  EXPECT_EQ(RowRange::RightOpen("k1", "k2"), OnlyRange(shards[1]));
+  EXPECT_EQ(RowRange::StartingAt("k2"), OnlyRange(shards[2]));
+}
+
+/// @test Verify that a table without samples is a single shard.
+TEST(SplitRowSetTest, NoSamples) {
+  auto shards = SplitRowSet(RowSet(), {});
+  ASSERT_EQ(1U, shards.size());
+  EXPECT_EQ(RowRange::StartingAt(""), OnlyRange(shards[0]));
+}
+
+/// @test Verify that ranges are split and empty shards are omitted.
+TEST(SplitRowSetTest, SplitsRanges) {
+  auto shards = SplitRowSet(RowSet(RowRange::Range("c", "h")),
+                            MakeSamples({"b", "e", "x"}));
+  ASSERT_EQ(2U, shards.size());
+  EXPECT_EQ(RowRange::RightOpen("c", "e"), OnlyRange(shards[0]));
+  EXPECT_EQ(RowRange::RightOpen("e", "h"), OnlyRange(shards[1]));
+}
+
+/// @test Verify that row keys are assigned to their shards.
+TEST(SplitRowSetTest, SplitsRowKeys) {
+  auto shards =
+      SplitRowSet(RowSet("a", "m", "n", "z"), MakeSamples({"g", "p"}));
+  ASSERT_EQ(3U, shards.size());
+  EXPECT_THAT(shards[0].as_proto().row_keys(), ::testing::ElementsAre("a"));
+  EXPECT_THAT(shards[1].as_proto().row_keys(),
+              ::testing::ElementsAre("m", "n"));
+  EXPECT_THAT(shards[2].as_proto().row_keys(), ::testing::ElementsAre("z"));
+}
+
+/// @test Verify that an empty row set has no shards.
+TEST(SplitRowSetTest, EmptyRowSet) {
+  auto shards =
+      SplitRowSet(RowSet(RowRange::Empty()), MakeSamples({"g", "p"}));
+  EXPECT_TRUE(shards.empty());
+}
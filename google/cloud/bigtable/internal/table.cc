@@ -14,9 +14,9 @@
 
 #include "google/cloud/bigtable/internal/table.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/internal/make_unique.h"
-#include <thread>
 #include <type_traits>
 
 namespace btproto = ::google::bigtable::v2;
@@ -78,7 +78,15 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation mut) {
       return failures;
     }
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!BackoffBeforeRetry(*rpc_policy, delay)) {
+      google::rpc::Status rpc_status;
+      rpc_status.set_code(status.error_code());
+      rpc_status.set_message(status.error_message());
+      failures.emplace_back(rpc_status, 0);
+      status = grpc::Status(status.error_code(),
+                            "Retry deadline exhausted in Table::Apply()");
+      return failures;
+    }
   }
 }
 
@@ -106,8 +114,12 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut,
     if (!status.ok() && !retry_policy->OnFailure(status)) {
       break;
     }
+    // The mutations still pending after a partial success have no error to
+    // report yet, they are retried until the retry deadline.
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!BackoffBeforeRetry(*retry_policy, delay)) {
+      break;
+    }
   }
   auto failures = mutator.ExtractFinalFailures();
   if (!status.ok()) {
@@ -243,9 +255,13 @@ void Table::SampleRowsImpl(
                             "No more retries allowed as per policy.");
       return;
     }
-    clearer();
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!BackoffBeforeRetry(*retry_policy, delay)) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Retry deadline exhausted as per policy.");
+      return;
+    }
+    clearer();
   }
 }
 
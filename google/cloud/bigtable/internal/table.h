@@ -28,6 +28,7 @@
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/retry_budget.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -156,8 +157,9 @@ class Table {
       : client_(std::move(client)),
         app_profile_id_(std::move(app_profile_id)),
         table_name_(bigtable::TableId(TableName(client_, table_id))),
-        rpc_retry_policy_(
-            bigtable::DefaultRPCRetryPolicy(internal::kBigtableLimits)),
+        rpc_retry_policy_(bigtable::internal::MakeBudgetedRetryPolicy(
+            bigtable::DefaultRPCRetryPolicy(internal::kBigtableLimits),
+            client_->GetRetryBudget())),
         rpc_backoff_policy_(
             bigtable::DefaultRPCBackoffPolicy(internal::kBigtableLimits)),
         metadata_update_policy_(table_name(), MetadataParamTypes::TABLE_NAME),
@@ -685,7 +687,8 @@ class Table {
   //@{
   /// @name Helper functions to implement constructors with changed policies.
   void ChangePolicy(RPCRetryPolicy& policy) {
-    rpc_retry_policy_ = policy.clone();
+    rpc_retry_policy_ = bigtable::internal::MakeBudgetedRetryPolicy(
+        policy.clone(), client_->GetRetryBudget());
   }
 
   void ChangePolicy(RPCBackoffPolicy& policy) {
@@ -277,7 +277,7 @@ TEST_F(NoexTableAsyncApplyTest, TooManyTransientFailures) {
   EXPECT_THAT(capture_status.error_message(), HasSubstr("transient error"));
   EXPECT_THAT(capture_status.error_message(), HasSubstr("try-again"));
 
-  impl->Shutdown();
+  cq.Shutdown();
 }
 
 /// @test Verify that noex::Table::AsyncApply() fails on transient errors
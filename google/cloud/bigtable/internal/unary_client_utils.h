@@ -16,11 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_UNARY_CLIENT_UTILS_H_
 
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/version.h"
-#include <thread>
 
 namespace google {
 namespace cloud {
@@ -149,7 +149,9 @@ struct UnaryClientUtils {
       if (status.ok()) {
         break;
       }
-      if (!rpc_policy.OnFailure(status)) {
+      if (!rpc_policy.OnFailure(status) ||
+          !BackoffBeforeRetry(rpc_policy,
+                              backoff_policy.OnCompletion(status))) {
         std::string full_message = error_message;
         full_message += "(" + metadata_update_policy.value() + ") ";
         full_message += status.error_message();
@@ -157,8 +159,6 @@ struct UnaryClientUtils {
                               status.error_details());
         break;
       }
-      auto delay = backoff_policy.OnCompletion(status);
-      std::this_thread::sleep_for(delay);
     } while (retry_on_failure);
     return response;
   }
@@ -16,12 +16,29 @@
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
 #include "google/cloud/bigtable/internal/table.h"
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/**
+ * In adaptive mode, the number of successful batches needed to grow the number
+ * of mutations per batch from (nearly) zero to `max_mutations_per_batch`.
+ */
+constexpr std::size_t kAdditiveIncreaseSteps = 16;
+
+/// Errors which indicate that the service is overloaded.
+bool IsThrottlingError(grpc::StatusCode code) {
+  return code == grpc::StatusCode::UNAVAILABLE ||
+         code == grpc::StatusCode::RESOURCE_EXHAUSTED ||
+         code == grpc::StatusCode::DEADLINE_EXCEEDED;
+}
+}  // namespace
+
 MutationBatcher::Options::Options()
     :  // Cloud Bigtable doesn't accept more than this.
       max_mutations_per_batch(100000),
@@ -29,7 +46,12 @@ MutationBatcher::Options::Options()
       // miscalculations don't tip us over.
       max_size_per_batch(BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH * 9LL / 10),
       max_batches(8),
-      max_outstanding_size(BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH * 6) {}
+      max_outstanding_size(BIGTABLE_CLIENT_DEFAULT_MAX_MESSAGE_LENGTH * 6),
+      max_linger(0),
+      coalesce_rows(false),
+      adaptive(false),
+      target_batch_latency(0),
+      min_mutations_per_batch(1) {}
 
 std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     CompletionQueue& cq, SingleRowMutation mut) {
@@ -40,11 +62,11 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
   PendingSingleRowMutation pending(std::move(mut),
                                    std::move(completion_promise),
                                    std::move(admission_promise));
-  std::unique_lock<std::mutex> lk(mu_);
 
+  // IsValid() only depends on the options, which never change, so there is no
+  // need to lock the mutex.
   grpc::Status mutation_status = IsValid(pending);
   if (!mutation_status.ok()) {
-    lk.unlock();
     // Destroy the mutation before satisfying the admission promise so that we
     // can limit the memory usage.
     pending.mut.Clear();
@@ -56,32 +78,77 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     return res;
   }
   ++num_requests_pending_;
+  submitted_.Push(std::move(pending));
+  DrainSubmitted(cq);
+  return res;
+}
 
-  if (!CanAppendToBatch(pending)) {
-    pending_mutations_.push(std::move(pending));
-    return res;
+std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
+    SingleRowMutation mut) {
+  auto cq = table_.background_completion_queue();
+  return AsyncApply(cq, std::move(mut));
+}
+
+void MutationBatcher::DrainSubmitted(CompletionQueue& cq) {
+  // Only one thread at a time moves the submitted mutations into batches, the
+  // other threads return as soon as their mutations are in `submitted_`. The
+  // draining thread checks `submitted_` again after it is done, so mutations
+  // pushed in the meantime are not forgotten.
+  while (!submitted_.empty() && !draining_.exchange(true)) {
+    auto submitted = submitted_.PopAll();
+    std::unique_lock<std::mutex> lk(mu_);
+    std::vector<AdmissionPromise> admission_promises;
+    for (auto& pending : submitted) {
+      if (!CanAppendToBatch(pending)) {
+        pending_mutations_.push(std::move(pending));
+        continue;
+      }
+      admission_promises.emplace_back(std::move(pending.admission_promise));
+      Admit(cq, std::move(pending));
+      FlushIfPossible(cq);
+    }
+    if (!pending_mutations_.empty()) {
+      // The current batch may be lingering, but now it is full.
+      for (auto& p : TryAdmit(cq)) {
+        admission_promises.emplace_back(std::move(p));
+      }
+    }
+    draining_.store(false);
+    SatisfyPromises(std::move(admission_promises), lk);  // unlocks the lock
   }
-  std::vector<AdmissionPromise> admission_promises_to_satisfy;
-  admission_promises_to_satisfy.emplace_back(
-      std::move(pending.admission_promise));
-  Admit(std::move(pending));
-  FlushIfPossible(cq);
-  SatisfyPromises(std::move(admission_promises_to_satisfy), lk);
-  return res;
 }
 
 future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
   std::unique_lock<std::mutex> lk(mu_);
-  if (num_requests_pending_ == 0) {
+  if (num_requests_pending_ == 0 && num_linger_timers_ == 0) {
     // TODO(#2112): Use make_satisfied_future<> once it's implemented.
     promise<void> satisfied_promise;
     satisfied_promise.set_value();
     return satisfied_promise.get_future();
   }
+  if (linger_timer_) {
+    // Do not wait for the linger period, the timer callback sends the batch.
+    linger_timer_->Cancel();
+  }
   no_more_pending_promises_.emplace_back();
   return no_more_pending_promises_.back().get_future();
 }
 
+MutationBatcher::Stats MutationBatcher::GetStats() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Stats stats;
+  stats.max_mutations_per_batch = max_mutations_per_batch_;
+  stats.max_batches = max_batches_;
+  stats.num_outstanding_batches = num_outstanding_batches_;
+  stats.outstanding_size = outstanding_size_;
+  stats.num_requests_pending = num_requests_pending_.load();
+  stats.num_batches_sent = num_batches_sent_;
+  stats.num_batches_throttled = num_batches_throttled_;
+  stats.num_mutations_coalesced = num_mutations_coalesced_;
+  stats.last_batch_latency = last_batch_latency_;
+  return stats;
+}
+
 MutationBatcher::PendingSingleRowMutation::PendingSingleRowMutation(
     SingleRowMutation mut_arg, CompletionPromise completion_promise,
     AdmissionPromise admission_promise)
@@ -127,15 +194,35 @@ bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
              options_.max_outstanding_size &&
          cur_batch_->requests_size + mut.request_size <=
              options_.max_size_per_batch &&
-         cur_batch_->num_mutations + mut.num_mutations <=
-             options_.max_mutations_per_batch;
+         // In adaptive mode the limit may be lower than the size of a valid
+         // mutation, such mutations are sent in a batch of their own.
+         (cur_batch_->num_mutations == 0 ||
+          cur_batch_->num_mutations + mut.num_mutations <=
+              max_mutations_per_batch_);
+}
+
+bool MutationBatcher::CurBatchIsReady() const {
+  if (options_.max_linger.count() == 0 || cur_batch_->linger_expired) {
+    return true;
+  }
+  // Full batches are sent right away, and so are batches blocking mutations
+  // waiting for admission.
+  return !pending_mutations_.empty() ||
+         cur_batch_->num_mutations >= max_mutations_per_batch_ ||
+         cur_batch_->requests_size >= options_.max_size_per_batch;
 }
 
 bool MutationBatcher::FlushIfPossible(CompletionQueue& cq) {
   if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+      num_outstanding_batches_ < max_batches_ && CurBatchIsReady()) {
+    if (linger_timer_) {
+      linger_timer_->Cancel();
+      linger_timer_.reset();
+    }
     ++num_outstanding_batches_;
+    ++num_batches_sent_;
     auto batch = cur_batch_;
+    batch->sent_time = std::chrono::steady_clock::now();
     table_.impl_.StreamingAsyncBulkApply(
         cq,
         [this, batch](CompletionQueue& cq, std::vector<int> succeeded) {
@@ -144,8 +231,8 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue& cq) {
         [this, batch](CompletionQueue& cq, std::vector<FailedMutation> failed) {
           OnFailedMutations(cq, *batch, std::move(failed));
         },
-        [this, batch](CompletionQueue& cq, grpc::Status&) {
-          OnBulkApplyAttemptFinished(cq, *batch);
+        [this, batch](CompletionQueue& cq, grpc::Status& status) {
+          OnBulkApplyAttemptFinished(cq, *batch, status);
         },
         [this, batch](CompletionQueue& cq, std::vector<FailedMutation>& failed,
                       grpc::Status&) {
@@ -153,23 +240,52 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue& cq) {
           // final failed mutations are passed here.
           OnFailedMutations(cq, *batch, std::move(failed));
         },
-        std::move(cur_batch_->requests));
+        BulkMutation(std::make_move_iterator(cur_batch_->requests.begin()),
+                     std::make_move_iterator(cur_batch_->requests.end())));
     cur_batch_ = std::make_shared<Batch>();
     return true;
   }
   return false;
 }
 
+void MutationBatcher::StartLingerTimer(CompletionQueue& cq) {
+  ++num_linger_timers_;
+  auto batch = cur_batch_;
+  linger_timer_ = cq.MakeRelativeTimer(
+      options_.max_linger,
+      [this, batch](CompletionQueue& cq, AsyncTimerResult&) {
+        OnLingerTimer(cq, *batch);
+      });
+}
+
+void MutationBatcher::OnLingerTimer(CompletionQueue& cq,
+                                    MutationBatcher::Batch& batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  --num_linger_timers_;
+  // The timer is also cancelled when the batch is sent, in that case there is
+  // nothing to do other than (maybe) satisfying the no more pending promises.
+  if (&batch == cur_batch_.get()) {
+    batch.linger_expired = true;
+    linger_timer_.reset();
+    FlushIfPossible(cq);
+  }
+  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+}
+
 void MutationBatcher::OnSuccessfulMutations(CompletionQueue& cq,
                                             MutationBatcher::Batch& batch,
                                             std::vector<int> indices) {
-  size_t const num_mutations = indices.size();
+  size_t num_mutations = 0;
   size_t completed_size = 0;
 
   for (int idx : indices) {
     auto it = batch.mutation_data.find(idx);
     completed_size += it->second.request_size;
+    num_mutations += 1 + it->second.coalesced_promises.size();
     it->second.completion_promise.set_value(Status());
+    for (auto& promise : it->second.coalesced_promises) {
+      promise.set_value(Status());
+    }
     // Release resources as early as possible.
     batch.mutation_data.erase(it);
   }
@@ -183,14 +299,18 @@ void MutationBatcher::OnSuccessfulMutations(CompletionQueue& cq,
 void MutationBatcher::OnFailedMutations(CompletionQueue& cq,
                                         MutationBatcher::Batch& batch,
                                         std::vector<FailedMutation> failed) {
-  size_t const num_mutations = failed.size();
+  size_t num_mutations = 0;
   size_t completed_size = 0;
 
   for (auto const& f : failed) {
     int const idx = f.original_index();
     auto it = batch.mutation_data.find(idx);
     completed_size += it->second.request_size;
+    num_mutations += 1 + it->second.coalesced_promises.size();
     it->second.completion_promise.set_value(f.status());
+    for (auto& promise : it->second.coalesced_promises) {
+      promise.set_value(f.status());
+    }
     // Release resources as early as possible.
     batch.mutation_data.erase(it);
   }
@@ -205,7 +325,8 @@ void MutationBatcher::OnFailedMutations(CompletionQueue& cq,
 }
 
 void MutationBatcher::OnBulkApplyAttemptFinished(
-    CompletionQueue& cq, MutationBatcher::Batch& batch) {
+    CompletionQueue& cq, MutationBatcher::Batch& batch,
+    grpc::Status const& status) {
   if (batch.attempt_finished) {
     // We consider a batch finished if the original request finished. If it is
     // later retried, we don't count it against the limit. The reasoning is that
@@ -214,12 +335,49 @@ void MutationBatcher::OnBulkApplyAttemptFinished(
     return;
   }
   batch.attempt_finished = true;
+  auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - batch.sent_time);
   std::unique_lock<std::mutex> lk(mu_);
   num_outstanding_batches_ -= 1;
+  AdjustLimits(status, latency);
   FlushIfPossible(cq);
   SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
 }
 
+void MutationBatcher::AdjustLimits(grpc::Status const& status,
+                                   std::chrono::milliseconds latency) {
+  last_batch_latency_ = latency;
+  bool const too_slow = options_.target_batch_latency.count() > 0 &&
+                        latency > options_.target_batch_latency;
+  bool const throttled = IsThrottlingError(status.error_code()) || too_slow;
+  if (throttled) {
+    ++num_batches_throttled_;
+  }
+  if (!options_.adaptive) {
+    return;
+  }
+  if (throttled) {
+    // Multiplicative decrease, but never below the configured minimums.
+    auto const min_mutations = std::max<std::size_t>(
+        1, std::min(options_.min_mutations_per_batch,
+                    options_.max_mutations_per_batch));
+    max_mutations_per_batch_ =
+        std::max(min_mutations, max_mutations_per_batch_ / 2);
+    max_batches_ = std::max<std::size_t>(1, max_batches_ / 2);
+    return;
+  }
+  if (!status.ok()) {
+    // Other errors say nothing about the load on the service.
+    return;
+  }
+  // Additive increase, up to the configured limits.
+  auto const step = std::max<std::size_t>(
+      1, options_.max_mutations_per_batch / kAdditiveIncreaseSteps);
+  max_mutations_per_batch_ = std::min(options_.max_mutations_per_batch,
+                                      max_mutations_per_batch_ + step);
+  max_batches_ = std::min(options_.max_batches, max_batches_ + 1);
+}
+
 std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
     CompletionQueue& cq) {
   // Defer satisfying promises until we release the lock.
@@ -230,17 +388,41 @@ std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
            HasSpaceFor(pending_mutations_.front())) {
       auto& mut(pending_mutations_.front());
       admission_promises.emplace_back(std::move(mut.admission_promise));
-      Admit(std::move(mut));
+      Admit(cq, std::move(mut));
       pending_mutations_.pop();
     }
   } while (FlushIfPossible(cq));
   return admission_promises;
 }
 
-void MutationBatcher::Admit(PendingSingleRowMutation mut) {
+void MutationBatcher::Admit(CompletionQueue& cq,
+                            PendingSingleRowMutation mut) {
+  if (cur_batch_->num_mutations == 0 && options_.max_linger.count() != 0) {
+    StartLingerTimer(cq);
+  }
   outstanding_size_ += mut.request_size;
   cur_batch_->requests_size += mut.request_size;
   cur_batch_->num_mutations += mut.num_mutations;
+  if (options_.coalesce_rows) {
+    auto inserted =
+        cur_batch_->row_index.emplace(mut.mut.row_key(), cur_batch_->last_idx);
+    if (!inserted.second) {
+      // There is an entry for this row already, append the new mutations.
+      int const idx = inserted.first->second;
+      google::bigtable::v2::MutateRowsRequest::Entry entry;
+      mut.mut.MoveTo(&entry);
+      auto& target = cur_batch_->requests[idx];
+      for (auto& op : *entry.mutable_mutations()) {
+        target.emplace_back(Mutation{std::move(op)});
+      }
+      auto& data = cur_batch_->mutation_data.find(idx)->second;
+      data.coalesced_promises.emplace_back(std::move(mut.completion_promise));
+      data.num_mutations += mut.num_mutations;
+      data.request_size += mut.request_size;
+      ++num_mutations_coalesced_;
+      return;
+    }
+  }
   cur_batch_->requests.emplace_back(std::move(mut.mut));
   cur_batch_->mutation_data.emplace(cur_batch_->last_idx++,
                                     Batch::MutationData(std::move(mut)));
@@ -250,12 +432,14 @@ void MutationBatcher::SatisfyPromises(
     std::vector<AdmissionPromise> admission_promises,
     std::unique_lock<std::mutex>& lk) {
   std::vector<NoMorePendingPromise> no_more_pending_promises;
-  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0) {
+  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0 &&
+      num_linger_timers_ == 0) {
     // We should wait not only on num_requests_pending_ being zero but also on
     // num_outstanding_batches_ because we want to allow the user to kill the
     // completion queue after this promise is fulfilled. Otherwise, the user can
     // destroy the completion queue while the last batch is still being
-    // processed - we've had this bug (#2140).
+    // processed - we've had this bug (#2140). The same applies to the linger
+    // timers.
     no_more_pending_promises_.swap(no_more_pending_promises);
   }
   lk.unlock();
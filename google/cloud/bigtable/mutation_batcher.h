@@ -17,16 +17,23 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/mpsc_queue.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/status.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -79,19 +86,109 @@ class MutationBatcher {
       return *this;
     }
 
+    /**
+     * Adapt the batch size and the number of batches to the observed load.
+     *
+     * In adaptive mode `max_mutations_per_batch` and `max_batches` are upper
+     * bounds; the actual limits are chosen by an additive-increase,
+     * multiplicative-decrease controller. Both limits are halved whenever a
+     * batch is throttled (its first attempt fails with `UNAVAILABLE`,
+     * `RESOURCE_EXHAUSTED` or `DEADLINE_EXCEEDED`) or takes longer than
+     * `target_batch_latency`, and they grow by a small step for every batch
+     * which completes without either problem.
+     */
+    Options& SetAdaptive(bool adaptive_arg) {
+      adaptive = adaptive_arg;
+      return *this;
+    }
+
+    /// In adaptive mode, shrink the batches when they are slower than this.
+    Options& SetTargetBatchLatency(
+        std::chrono::milliseconds target_batch_latency_arg) {
+      target_batch_latency = target_batch_latency_arg;
+      return *this;
+    }
+
+    /// In adaptive mode, batches are not limited to fewer mutations than this.
+    Options& SetMinMutationsPerBatch(size_t min_mutations_per_batch_arg) {
+      min_mutations_per_batch = min_mutations_per_batch_arg;
+      return *this;
+    }
+
+    /**
+     * Wait up to this long for more mutations before sending a partial batch.
+     *
+     * By default (a zero duration) a batch is sent as soon as there is room
+     * for another outstanding RPC, even if it contains a single mutation. With
+     * a linger period the batch is sent when it is full, when the period
+     * expires, or when the application calls `AsyncWaitForNoPendingRequests()`.
+     * This trades some latency for larger batches.
+     */
+    Options& SetMaxLinger(std::chrono::milliseconds max_linger_arg) {
+      max_linger = max_linger_arg;
+      return *this;
+    }
+
+    /**
+     * Merge mutations for the same row in the currently constructed batch.
+     *
+     * When enabled, a mutation for a row which already has an entry in the
+     * batch waiting to be sent is appended to that entry, instead of sending
+     * the row key again. Each `AsyncApply()` call still gets its own
+     * completion future, but all the mutations merged into an entry succeed
+     * or fail together. Mutations are only merged while the batch waits to be
+     * sent, a linger period (see `SetMaxLinger()`) makes that more likely.
+     */
+    Options& SetCoalesceRows(bool coalesce_rows_arg) {
+      coalesce_rows = coalesce_rows_arg;
+      return *this;
+    }
+
     size_t max_mutations_per_batch;
     size_t max_size_per_batch;
     size_t max_batches;
     size_t max_outstanding_size;
+    std::chrono::milliseconds max_linger;
+    bool coalesce_rows;
+    bool adaptive;
+    /// A zero latency means that only throttling errors shrink the batches.
+    std::chrono::milliseconds target_batch_latency;
+    size_t min_mutations_per_batch;
+  };
+
+  /// A snapshot of the `MutationBatcher` limits and state.
+  struct Stats {
+    /// The current limit on the number of mutations in a single RPC.
+    size_t max_mutations_per_batch;
+    /// The current limit on the number of outstanding RPCs.
+    size_t max_batches;
+    size_t num_outstanding_batches;
+    size_t outstanding_size;
+    size_t num_requests_pending;
+    std::uint64_t num_batches_sent;
+    /// How many batches had their first attempt throttled or delayed.
+    std::uint64_t num_batches_throttled;
+    /// How many mutations were merged into an entry for the same row.
+    std::uint64_t num_mutations_coalesced;
+    /// The duration of the first attempt of the most recently completed batch.
+    std::chrono::milliseconds last_batch_latency;
   };
 
   MutationBatcher(Table table, Options options = Options())
       : table_(std::move(table)),
         options_(options),
+        max_mutations_per_batch_(options.max_mutations_per_batch),
+        max_batches_(options.max_batches),
         num_outstanding_batches_(),
         outstanding_size_(),
-        num_requests_pending_(),
-        cur_batch_(std::make_shared<Batch>()) {}
+        num_requests_pending_(0),
+        num_batches_sent_(),
+        num_batches_throttled_(),
+        num_mutations_coalesced_(),
+        last_batch_latency_(),
+        num_linger_timers_(),
+        cur_batch_(std::make_shared<Batch>()),
+        draining_(false) {}
 
   /**
    * Asynchronously apply mutation.
@@ -121,6 +218,10 @@ class MutationBatcher {
    *
    * One should not make assumptions on which future will be satisfied first.
    *
+   * This function can be called from multiple threads. The threads do not
+   * wait for each other: one of them assembles the batches while the others
+   * simply queue their mutations and return.
+   *
    * This quasi-synchronous example shows the intended use:
    * @code
    * bigtable::MutationBatcher batcher(bigtable::Table(...args...));
@@ -147,15 +248,34 @@ class MutationBatcher {
   std::pair<future<void>, future<Status>> AsyncApply(CompletionQueue& cq,
                                                      SingleRowMutation mut);
 
+  /**
+   * Asynchronously apply a mutation using the table's background threads.
+   *
+   * This is equivalent to calling `AsyncApply(cq, mut)` with the completion
+   * queue returned by `Table::background_completion_queue()`, the application
+   * does not need to create or run a `CompletionQueue`.
+   */
+  std::pair<future<void>, future<Status>> AsyncApply(SingleRowMutation mut);
+
   /**
    * Asynchronously wait until all submitted mutations complete.
    *
+   * If the options set a linger period, the current partial batch is sent
+   * without waiting for that period to expire.
+   *
    * @return a future which will be satisfied once all mutations submitted
    *     before calling this function finish; if there are no such operations,
    *     the returned future is already satisfied
    */
   future<void> AsyncWaitForNoPendingRequests();
 
+  /**
+   * Return the current limits and state.
+   *
+   * This is mostly useful to observe the limits chosen in adaptive mode.
+   */
+  Stats GetStats();
+
  private:
   using CompletionPromise = promise<Status>;
   using AdmissionPromise = promise<void>;
@@ -207,7 +327,11 @@ class MutationBatcher {
    */
   struct Batch {
     Batch()
-        : num_mutations(), requests_size(), last_idx(), attempt_finished() {}
+        : num_mutations(),
+          requests_size(),
+          last_idx(),
+          attempt_finished(),
+          linger_expired() {}
 
     struct MutationData {
       MutationData(PendingSingleRowMutation pending)
@@ -215,6 +339,8 @@ class MutationBatcher {
             num_mutations(pending.num_mutations),
             request_size(pending.request_size) {}
       CompletionPromise completion_promise;
+      /// The promises of other mutations merged into this entry.
+      std::vector<CompletionPromise> coalesced_promises;
       std::size_t num_mutations;
       std::size_t request_size;
     };
@@ -222,10 +348,16 @@ class MutationBatcher {
     std::mutex mu_;
     size_t num_mutations;
     size_t requests_size;
-    BulkMutation requests;
+    std::vector<SingleRowMutation> requests;
+    /// The index of each row in `requests`, only used to coalesce rows.
+    std::unordered_map<std::string, int> row_index;
     int last_idx;
     /// Whether at least one AsyncBulkApply finished.
     bool attempt_finished;
+    /// When the batch was sent, used to measure the latency in adaptive mode.
+    std::chrono::steady_clock::time_point sent_time;
+    /// Whether the batch may be sent before it is full.
+    bool linger_expired;
     /**
      * The reason why it's not simple std::vector is that we want this
      * structure to shrink as individual mutations complete, so that the user
@@ -234,6 +366,12 @@ class MutationBatcher {
     std::unordered_map<int, MutationData> mutation_data;
   };
 
+  /**
+   * Move the mutations in `submitted_` into batches, unless another thread is
+   * already doing so.
+   */
+  void DrainSubmitted(CompletionQueue& cq);
+
   /// Check if a mutation doesn't exceed allowed limits.
   grpc::Status IsValid(PendingSingleRowMutation& mut) const;
 
@@ -255,12 +393,31 @@ class MutationBatcher {
     return pending_mutations_.empty() && HasSpaceFor(mut);
   }
 
+  /**
+   * Check if the currently constructed batch should be sent. That is always
+   * the case unless the options set a linger period and the batch is neither
+   * full nor lingering for too long.
+   */
+  bool CurBatchIsReady() const;
+
   /**
    * Send the currently constructed batch if there are not too many outstanding
    * already. If there are no mutations in the batch, it's a noop.
    */
   bool FlushIfPossible(CompletionQueue& cq);
 
+  /**
+   * Start a timer to send the currently constructed batch once the linger
+   * period expires.
+   */
+  void StartLingerTimer(CompletionQueue& cq);
+
+  /**
+   * Entry point for the linger timer of `batch`, it sends the batch if it has
+   * not been sent already.
+   */
+  void OnLingerTimer(CompletionQueue& cq, MutationBatcher::Batch& batch);
+
   /**
    * Entry point for lower layers indicating that mutations with indices
    * `indices` in batch `batch` have finished successfully.
@@ -280,7 +437,15 @@ class MutationBatcher {
    * `batch` was made. This might be called multiple times in case of retries.
    */
   void OnBulkApplyAttemptFinished(CompletionQueue& cq,
-                                  MutationBatcher::Batch& batch);
+                                  MutationBatcher::Batch& batch,
+                                  grpc::Status const& status);
+
+  /**
+   * Update the limits after the first attempt of a batch finished with
+   * `status` after `latency`.
+   */
+  void AdjustLimits(grpc::Status const& status,
+                    std::chrono::milliseconds latency);
 
   /**
    * Try to move mutations waiting in `pending_mutations_` to the currently
@@ -293,7 +458,7 @@ class MutationBatcher {
   /**
    * Append mutation `mut` to the currently constructed batch.
    */
-  void Admit(PendingSingleRowMutation mut);
+  void Admit(CompletionQueue& cq, PendingSingleRowMutation mut);
 
   /**
    * Satisfies passed admission promises and potentially the promises of no more
@@ -306,12 +471,25 @@ class MutationBatcher {
   Table table_;
   Options options_;
 
+  /// The current limits, in adaptive mode they change over time.
+  size_t max_mutations_per_batch_;
+  size_t max_batches_;
+
   /// Num batches sent but not completed.
   size_t num_outstanding_batches_;
   /// Size of admitted but uncompleted mutations.
   size_t outstanding_size_;
-  // Number of uncompleted SingleRowMutations (including not admitted).
-  size_t num_requests_pending_;
+  // Number of uncompleted SingleRowMutations (including not admitted). It is
+  // incremented without holding `mu_` when mutations are submitted.
+  std::atomic<size_t> num_requests_pending_;
+  std::uint64_t num_batches_sent_;
+  std::uint64_t num_batches_throttled_;
+  std::uint64_t num_mutations_coalesced_;
+  std::chrono::milliseconds last_batch_latency_;
+  /// Linger timers whose callbacks have not run yet.
+  size_t num_linger_timers_;
+  /// The linger timer for `cur_batch_`, if any.
+  std::shared_ptr<AsyncOperation> linger_timer_;
 
   /// Currently contructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
@@ -323,6 +501,15 @@ class MutationBatcher {
    */
   std::queue<PendingSingleRowMutation> pending_mutations_;
   std::vector<NoMorePendingPromise> no_more_pending_promises_;
+
+  /**
+   * The mutations submitted by `AsyncApply()` and not yet processed.
+   *
+   * Producers push to this queue without locking `mu_`, the thread which sets
+   * `draining_` moves them into the batches.
+   */
+  internal::MpscQueue<PendingSingleRowMutation> submitted_;
+  std::atomic<bool> draining_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -249,6 +249,22 @@ TEST(OptionsTest, Trivial) {
   ASSERT_EQ(4, opt.max_outstanding_size);
 }
 
+TEST(OptionsTest, Linger) {
+  ASSERT_EQ(0_ms, MutationBatcher::Options().max_linger);
+  ASSERT_EQ(7_ms, MutationBatcher::Options().SetMaxLinger(7_ms).max_linger);
+}
+
+TEST(OptionsTest, Adaptive) {
+  MutationBatcher::Options opt = MutationBatcher::Options()
+                                     .SetAdaptive(true)
+                                     .SetTargetBatchLatency(5_ms)
+                                     .SetMinMutationsPerBatch(6);
+  ASSERT_TRUE(opt.adaptive);
+  ASSERT_EQ(5_ms, opt.target_batch_latency);
+  ASSERT_EQ(6, opt.min_mutations_per_batch);
+  ASSERT_FALSE(MutationBatcher::Options().adaptive);
+}
+
 TEST_F(MutationBatcherTest, TrivialTest) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
@@ -910,6 +926,232 @@ TEST_F(MutationBatcherTest, WaitForNoPendingEdgeCases) {
   EXPECT_EQ(no_more_pending2.wait_for(1_ms), std::future_status::ready);
 }
 
+// Test that the stats report the limits and the throttled batches.
+TEST_F(MutationBatcherTest, StatsWithFixedLimits) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxBatches(4).SetMaxMutationsPerBatch(16)));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({}, {0}, {})}),
+                     Exchange({mutations[0]}, {ResultPiece({0}, {}, {})})});
+
+  auto stats = batcher_->GetStats();
+  EXPECT_EQ(16U, stats.max_mutations_per_batch);
+  EXPECT_EQ(4U, stats.max_batches);
+  EXPECT_EQ(0U, stats.num_batches_sent);
+
+  auto state0 = Apply(mutations[0]);
+  stats = batcher_->GetStats();
+  EXPECT_EQ(1U, stats.num_batches_sent);
+  EXPECT_EQ(1U, stats.num_outstanding_batches);
+  EXPECT_EQ(1U, stats.num_requests_pending);
+  EXPECT_EQ(MutationSize(mutations[0]), stats.outstanding_size);
+
+  // The transient failure is reported as throttling, but without adaptive
+  // mode the limits do not change.
+  FinishSingleItemStream();
+  stats = batcher_->GetStats();
+  EXPECT_EQ(1U, stats.num_batches_throttled);
+  EXPECT_EQ(16U, stats.max_mutations_per_batch);
+  EXPECT_EQ(4U, stats.max_batches);
+  EXPECT_EQ(0U, stats.num_outstanding_batches);
+
+  FinishTimer();
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  stats = batcher_->GetStats();
+  EXPECT_EQ(0U, stats.num_requests_pending);
+  EXPECT_EQ(0U, stats.outstanding_size);
+}
+
+// Test that in adaptive mode the limits shrink on throttling and grow back.
+TEST_F(MutationBatcherTest, AdaptiveLimits) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetAdaptive(true)
+                                                 .SetMaxBatches(2)
+                                                 .SetMaxMutationsPerBatch(2)));
+
+  ExpectInteraction({// The first batch is throttled.
+                     Exchange({mutations[0]}, {ResultPiece({}, {0}, {})}),
+                     Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     // With the reduced limits each batch has one mutation.
+                     Exchange({mutations[1]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[2]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[3]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  FinishSingleItemStream();
+  auto stats = batcher_->GetStats();
+  EXPECT_EQ(1U, stats.num_batches_throttled);
+  EXPECT_EQ(1U, stats.max_mutations_per_batch);
+  EXPECT_EQ(1U, stats.max_batches);
+
+  // The retry does not change the limits.
+  FinishTimer();
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  stats = batcher_->GetStats();
+  EXPECT_EQ(1U, stats.max_mutations_per_batch);
+  EXPECT_EQ(1U, stats.max_batches);
+
+  // Only one batch is outstanding, and it has only one mutation, so the last
+  // mutation cannot be admitted.
+  auto state1 = Apply(mutations[1]);
+  auto state2 = Apply(mutations[2]);
+  auto state3 = Apply(mutations[3]);
+  EXPECT_TRUE(state1->admitted);
+  EXPECT_TRUE(state2->admitted);
+  EXPECT_FALSE(state3->admitted);
+  EXPECT_EQ(1U, NumOperationsOutstanding());
+
+  // A successful batch raises the limits, and the remaining mutations are
+  // sent in parallel.
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state3->admitted);
+  stats = batcher_->GetStats();
+  EXPECT_EQ(2U, stats.max_mutations_per_batch);
+  EXPECT_EQ(2U, stats.max_batches);
+  EXPECT_EQ(2U, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state2->completed);
+  EXPECT_TRUE(state3->completed);
+  EXPECT_EQ(0U, NumOperationsOutstanding());
+  EXPECT_EQ(4U, batcher_->GetStats().num_batches_sent);
+}
+
+// Test that partial batches are sent when the linger period expires.
+TEST_F(MutationBatcherTest, LingerSendsPartialBatch) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxMutationsPerBatch(3).SetMaxLinger(
+          10_ms)));
+
+  ExpectInteraction({Exchange({mutations[0], mutations[1]},
+                              {ResultPiece({0, 1}, {}, {})})});
+
+  auto states = ApplyMany(mutations.begin(), mutations.end());
+  EXPECT_TRUE(states.AllAdmitted());
+  EXPECT_TRUE(states.NoneCompleted());
+  // Only the linger timer is pending, the batch has not been sent.
+  EXPECT_EQ(1U, NumOperationsOutstanding());
+  EXPECT_EQ(0U, batcher_->GetStats().num_batches_sent);
+
+  FinishTimer();
+  EXPECT_EQ(1U, batcher_->GetStats().num_batches_sent);
+  EXPECT_EQ(1U, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(states.AllCompleted());
+  EXPECT_EQ(0U, NumOperationsOutstanding());
+  auto no_more_pending = batcher_->AsyncWaitForNoPendingRequests();
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::ready);
+}
+
+// Test that full batches are sent without waiting for the linger period.
+TEST_F(MutationBatcherTest, LingerSendsFullBatch) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxMutationsPerBatch(2).SetMaxLinger(
+          10_ms)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})}),
+       Exchange({mutations[2]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_EQ(0U, batcher_->GetStats().num_batches_sent);
+  auto state1 = Apply(mutations[1]);
+  EXPECT_EQ(1U, batcher_->GetStats().num_batches_sent);
+
+  // This also runs the (cancelled) linger timer callback for the first batch.
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_TRUE(state1->completed);
+  EXPECT_EQ(0U, NumOperationsOutstanding());
+
+  // The third mutation starts a new batch, with its own linger timer.
+  auto state2 = Apply(mutations[2]);
+  EXPECT_TRUE(state2->admitted);
+  EXPECT_EQ(1U, batcher_->GetStats().num_batches_sent);
+  EXPECT_EQ(1U, NumOperationsOutstanding());
+
+  // Waiting for the pending requests cancels the linger timer, its callback
+  // sends the partial batch.
+  auto no_more_pending = batcher_->AsyncWaitForNoPendingRequests();
+  FinishTimer();
+  EXPECT_EQ(2U, batcher_->GetStats().num_batches_sent);
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::timeout);
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(0U, NumOperationsOutstanding());
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::ready);
+}
+
+// Test that mutations for the same row are merged into one entry.
+TEST_F(MutationBatcherTest, CoalesceRows) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo0", {bt::SetCell("fam", "col2", 0_ms, "baz"),
+                                  bt::DeleteFromColumn("fam", "col3")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col2", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetMaxMutationsPerBatch(10)
+                                                 .SetMaxLinger(10_ms)
+                                                 .SetCoalesceRows(true)));
+
+  SingleRowMutation merged0(
+      "foo0", {bt::SetCell("fam", "col", 0_ms, "baz"),
+               bt::SetCell("fam", "col2", 0_ms, "baz"),
+               bt::DeleteFromColumn("fam", "col3")});
+  SingleRowMutation merged1("foo1", {bt::SetCell("fam", "col", 0_ms, "baz"),
+                                     bt::SetCell("fam", "col2", 0_ms, "baz")});
+  // The entry for "foo0" fails, the entry for "foo1" succeeds.
+  ExpectInteraction(
+      {Exchange({merged0, merged1}, {ResultPiece({1}, {}, {0})})});
+
+  auto states = ApplyMany(mutations.begin(), mutations.end());
+  EXPECT_TRUE(states.AllAdmitted());
+  EXPECT_EQ(2U, batcher_->GetStats().num_mutations_coalesced);
+  EXPECT_EQ(4U, batcher_->GetStats().num_requests_pending);
+
+  FinishTimer();
+  FinishSingleItemStream();
+  // Every mutation gets its own completion, with the status of its entry.
+  EXPECT_TRUE(states.AllCompleted());
+  EXPECT_FALSE(states.states_[0]->completion_status.ok());
+  EXPECT_STATUS_OK(states.states_[1]->completion_status);
+  EXPECT_FALSE(states.states_[2]->completion_status.ok());
+  EXPECT_STATUS_OK(states.states_[3]->completion_status);
+
+  auto stats = batcher_->GetStats();
+  EXPECT_EQ(0U, stats.num_requests_pending);
+  EXPECT_EQ(0U, stats.outstanding_size);
+  EXPECT_EQ(1U, stats.num_batches_sent);
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -0,0 +1,41 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/parallel_scan_options.h"
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+/// The parallelism used when the number of hardware threads is unknown.
+std::size_t constexpr kDefaultMaxParallelism = 4;
+
+std::size_t DefaultMaxParallelism() {
+  auto const hc = std::thread::hardware_concurrency();
+  return hc == 0 ? kDefaultMaxParallelism : hc;
+}
+}  // namespace
+
+ParallelScanOptions::ParallelScanOptions()
+    : max_parallelism(DefaultMaxParallelism()),
+      read_ahead_responses(0),
+      read_ahead_bytes(0) {}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,68 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_SCAN_OPTIONS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_SCAN_OPTIONS_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configure a `Table::ParallelReadRows()` scan.
+ *
+ * The scan is split into shards at the row keys returned by
+ * `Table::SampleRows()`, and the shards are read by up to `max_parallelism`
+ * threads.
+ */
+struct ParallelScanOptions {
+  ParallelScanOptions();
+
+  /**
+   * The maximum number of shards read at the same time.
+   *
+   * The default is the number of hardware threads, or 4 if that is unknown.
+   */
+  ParallelScanOptions& SetMaxParallelism(std::size_t max_parallelism_arg) {
+    max_parallelism = max_parallelism_arg;
+    return *this;
+  }
+
+  /**
+   * Read ahead in each shard, see `RowReader::EnableReadAhead()`.
+   *
+   * Read-ahead is disabled by default.
+   */
+  ParallelScanOptions& SetReadAhead(std::size_t max_responses,
+                                    std::size_t max_bytes) {
+    read_ahead_responses = max_responses;
+    read_ahead_bytes = max_bytes;
+    return *this;
+  }
+
+  std::size_t max_parallelism;
+  std::size_t read_ahead_responses;
+  std::size_t read_ahead_bytes;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_SCAN_OPTIONS_H_
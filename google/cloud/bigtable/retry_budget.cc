@@ -0,0 +1,119 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/retry_budget.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+constexpr std::int64_t RetryBudget::kScale;
+
+RetryBudget::RetryBudget(double retry_ratio, double max_tokens)
+    : deposit_(static_cast<std::int64_t>(retry_ratio * kScale)),
+      capacity_(static_cast<std::int64_t>(max_tokens * kScale)),
+      tokens_(capacity_),
+      operations_(0),
+      retries_(0),
+      suppressed_retries_(0) {
+  if (retry_ratio < 0.0 || retry_ratio > 1.0) {
+    google::cloud::internal::ThrowInvalidArgument(
+        "retry_ratio must be in the [0, 1] range");
+  }
+  if (max_tokens < 1.0) {
+    google::cloud::internal::ThrowInvalidArgument(
+        "max_tokens must be at least 1");
+  }
+}
+
+void RetryBudget::Deposit() {
+  ++operations_;
+  auto current = tokens_.load();
+  std::int64_t desired;
+  do {
+    if (current >= capacity_) {
+      return;
+    }
+    desired = std::min(current + deposit_, capacity_);
+  } while (!tokens_.compare_exchange_weak(current, desired));
+}
+
+bool RetryBudget::TryWithdraw() {
+  auto current = tokens_.load();
+  do {
+    if (current < kScale) {
+      ++suppressed_retries_;
+      return false;
+    }
+  } while (!tokens_.compare_exchange_weak(current, current - kScale));
+  ++retries_;
+  return true;
+}
+
+RetryBudgetStats RetryBudget::stats() const {
+  return RetryBudgetStats{operations_.load(), retries_.load(),
+                          suppressed_retries_.load(),
+                          static_cast<double>(tokens_.load()) / kScale};
+}
+
+namespace internal {
+namespace {
+/// Decorate a retry policy to also consume a shared budget.
+class BudgetedRetryPolicy : public RPCRetryPolicy {
+ public:
+  BudgetedRetryPolicy(std::unique_ptr<RPCRetryPolicy> policy,
+                      std::shared_ptr<RetryBudget> budget)
+      : policy_(std::move(policy)), budget_(std::move(budget)) {}
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override {
+    budget_->Deposit();
+    return std::unique_ptr<RPCRetryPolicy>(
+        new BudgetedRetryPolicy(policy_->clone(), budget_));
+  }
+  void Setup(grpc::ClientContext& context) const override {
+    policy_->Setup(context);
+  }
+  bool OnFailure(google::cloud::Status const& status) override {
+    return policy_->OnFailure(status) && budget_->TryWithdraw();
+  }
+  bool OnFailure(grpc::Status const& status) override {
+    return policy_->OnFailure(status) && budget_->TryWithdraw();
+  }
+  std::chrono::system_clock::time_point retry_deadline() const override {
+    return policy_->retry_deadline();
+  }
+
+ private:
+  std::unique_ptr<RPCRetryPolicy> policy_;
+  std::shared_ptr<RetryBudget> budget_;
+};
+}  // namespace
+
+std::unique_ptr<RPCRetryPolicy> MakeBudgetedRetryPolicy(
+    std::unique_ptr<RPCRetryPolicy> policy,
+    std::shared_ptr<RetryBudget> budget) {
+  if (!budget) {
+    return policy;
+  }
+  return std::unique_ptr<RPCRetryPolicy>(
+      new BudgetedRetryPolicy(std::move(policy), std::move(budget)));
+}
+}  // namespace internal
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,119 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RETRY_BUDGET_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RETRY_BUDGET_H_
+
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/// The activity of a `RetryBudget` since it was created.
+struct RetryBudgetStats {
+  /// The number of operations started.
+  std::int64_t operations;
+  /// The number of retries allowed by the budget.
+  std::int64_t retries;
+  /// The number of retries suppressed because the budget was exhausted.
+  std::int64_t suppressed_retries;
+  /// The number of retries currently available.
+  double available_tokens;
+};
+
+/**
+ * Limit the retries of all the operations in a client.
+ *
+ * Each operation retries transient errors as configured by its
+ * `RPCRetryPolicy`. When the service is overloaded all the operations fail at
+ * once, and their retries add to the overload. A retry budget, shared by all
+ * the operations in a client, limits the retries to a fraction of the
+ * operations.
+ *
+ * The budget is a token bucket. Each operation deposits @p retry_ratio tokens
+ * when it starts, and each retry withdraws one token. If no token is available
+ * the retry is suppressed, and the operation fails with the last error. The
+ * bucket starts full and holds at most @p max_tokens, so short bursts of
+ * errors are retried as usual.
+ *
+ * Configure the budget with `ClientOptions::set_retry_budget()`, every `Table`
+ * using the client then applies it to its retry policy. The same budget may be
+ * shared by several clients.
+ *
+ * @par Thread-safety
+ * All the member functions are thread-safe, they do not lock.
+ */
+class RetryBudget {
+ public:
+  /**
+   * Create a budget.
+   *
+   * @param retry_ratio the number of retries allowed for each operation, for
+   *     example, 0.1 allows one retry every 10 operations. Must be in the
+   *     [0, 1] range.
+   * @param max_tokens the maximum number of retries that can be saved up. Must
+   *     be at least 1.
+   * @throws std::invalid_argument if the parameters are out of range.
+   */
+  explicit RetryBudget(double retry_ratio = 0.1, double max_tokens = 100.0);
+
+  RetryBudget(RetryBudget const&) = delete;
+  RetryBudget& operator=(RetryBudget const&) = delete;
+
+  /// Record the start of an operation.
+  void Deposit();
+
+  /// Consume a token for a retry, return false if none is available.
+  bool TryWithdraw();
+
+  /// Return the activity of the budget since it was created.
+  RetryBudgetStats stats() const;
+
+ private:
+  // The tokens are kept in fixed point, with kScale units per token, so they
+  // can be updated with atomic integer operations.
+  static constexpr std::int64_t kScale = 1000;
+
+  std::int64_t const deposit_;
+  std::int64_t const capacity_;
+  std::atomic<std::int64_t> tokens_;
+  std::atomic<std::int64_t> operations_;
+  std::atomic<std::int64_t> retries_;
+  std::atomic<std::int64_t> suppressed_retries_;
+};
+
+namespace internal {
+/**
+ * Apply @p budget to the operations created from @p policy.
+ *
+ * Each `clone()` of the result starts an operation and deposits into the
+ * budget, each retry approved by @p policy must also withdraw from it. Returns
+ * @p policy unchanged if @p budget is null.
+ */
+std::unique_ptr<RPCRetryPolicy> MakeBudgetedRetryPolicy(
+    std::unique_ptr<RPCRetryPolicy> policy,
+    std::shared_ptr<RetryBudget> budget);
+}  // namespace internal
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_RETRY_BUDGET_H_
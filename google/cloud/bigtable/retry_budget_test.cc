@@ -0,0 +1,152 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/retry_budget.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+grpc::Status TransientError() {
+  return grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+}
+
+grpc::Status PermanentError() {
+  return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION, "uh-oh");
+}
+
+/// @test Verify that retries are limited to a fraction of the operations.
+TEST(RetryBudgetTest, Simple) {
+  RetryBudget budget(0.5, 2.0);
+  // The bucket starts full.
+  EXPECT_TRUE(budget.TryWithdraw());
+  EXPECT_TRUE(budget.TryWithdraw());
+  EXPECT_FALSE(budget.TryWithdraw());
+
+  // Two operations earn one retry.
+  budget.Deposit();
+  EXPECT_FALSE(budget.TryWithdraw());
+  budget.Deposit();
+  EXPECT_TRUE(budget.TryWithdraw());
+  EXPECT_FALSE(budget.TryWithdraw());
+
+  auto stats = budget.stats();
+  EXPECT_EQ(2, stats.operations);
+  EXPECT_EQ(3, stats.retries);
+  EXPECT_EQ(3, stats.suppressed_retries);
+  EXPECT_DOUBLE_EQ(0.0, stats.available_tokens);
+}
+
+/// @test Verify that the tokens saved up are bounded.
+TEST(RetryBudgetTest, Capacity) {
+  RetryBudget budget(1.0, 3.0);
+  for (int i = 0; i != 100; ++i) {
+    budget.Deposit();
+  }
+  EXPECT_DOUBLE_EQ(3.0, budget.stats().available_tokens);
+  int retries = 0;
+  while (budget.TryWithdraw()) {
+    ++retries;
+  }
+  EXPECT_EQ(3, retries);
+}
+
+/// @test Verify that the parameters are validated.
+TEST(RetryBudgetTest, ValidateParameters) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(RetryBudget(-0.1, 10.0), std::invalid_argument);
+  EXPECT_THROW(RetryBudget(1.5, 10.0), std::invalid_argument);
+  EXPECT_THROW(RetryBudget(0.1, 0.5), std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(RetryBudget(-0.1, 10.0),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+/// @test Verify that concurrent retries never exceed the budget.
+TEST(RetryBudgetTest, Concurrent) {
+  RetryBudget budget(0.0, 100.0);
+  std::atomic<int> retries(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([&budget, &retries] {
+      for (int j = 0; j != 100; ++j) {
+        if (budget.TryWithdraw()) {
+          ++retries;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(100, retries.load());
+  EXPECT_EQ(300, budget.stats().suppressed_retries);
+}
+
+/// @test Verify that the budgeted policy consumes the shared budget.
+TEST(RetryBudgetTest, BudgetedRetryPolicy) {
+  auto budget = std::make_shared<RetryBudget>(0.5, 1.0);
+  auto prototype = internal::MakeBudgetedRetryPolicy(
+      std::unique_ptr<RPCRetryPolicy>(new LimitedErrorCountRetryPolicy(3)),
+      budget);
+
+  auto op1 = prototype->clone();
+  auto op2 = prototype->clone();
+  EXPECT_EQ(2, budget->stats().operations);
+
+  // Permanent errors do not consume the budget.
+  EXPECT_FALSE(op1->OnFailure(PermanentError()));
+  EXPECT_TRUE(op1->OnFailure(TransientError()));
+  EXPECT_FALSE(op2->OnFailure(TransientError()));
+
+  auto stats = budget->stats();
+  EXPECT_EQ(1, stats.retries);
+  EXPECT_EQ(1, stats.suppressed_retries);
+}
+
+/// @test Verify that the budgeted policy still obeys the wrapped policy.
+TEST(RetryBudgetTest, BudgetedRetryPolicyLimits) {
+  auto budget = std::make_shared<RetryBudget>(0.1, 100.0);
+  auto prototype = internal::MakeBudgetedRetryPolicy(
+      std::unique_ptr<RPCRetryPolicy>(new LimitedErrorCountRetryPolicy(2)),
+      budget);
+  auto op = prototype->clone();
+  EXPECT_TRUE(op->OnFailure(TransientError()));
+  EXPECT_TRUE(op->OnFailure(TransientError()));
+  EXPECT_FALSE(op->OnFailure(TransientError()));
+  EXPECT_EQ(2, budget->stats().retries);
+  EXPECT_EQ(std::chrono::system_clock::time_point::max(),
+            op->retry_deadline());
+}
+
+/// @test Verify that policies are unchanged without a budget.
+TEST(RetryBudgetTest, NoBudget) {
+  auto* policy = new LimitedErrorCountRetryPolicy(2);
+  auto result = internal::MakeBudgetedRetryPolicy(
+      std::unique_ptr<RPCRetryPolicy>(policy), nullptr);
+  EXPECT_EQ(policy, result.get());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -48,6 +48,75 @@ class Row {
   std::vector<Cell> cells_;
 };
 
+/**
+ * A Bigtable row whose cells share the row key, family and column storage.
+ *
+ * This is an opt-in alternative to `Row`, returned by
+ * `RowReader::NextSharedRow()`. All the cells in the row refer to the same row
+ * key, and cells from the same stream refer to the same column family and
+ * column qualifier strings. Use `ToRow()` to convert to a `Row` when needed.
+ */
+class SharedRow {
+ public:
+  /// Create a row from a list of cells.
+  SharedRow(SharedCell::StringPtr row_key, std::vector<SharedCell> cells)
+      : row_key_(std::move(row_key)), cells_(std::move(cells)) {}
+
+  /// Return the row key. The returned value is not valid
+  /// after this object is deleted.
+  std::string const& row_key() const { return *row_key_; }
+
+  /// Return all cells.
+  std::vector<SharedCell> const& cells() const { return cells_; }
+
+  /// Convert to a `Row`, where each cell owns its data.
+  Row ToRow() && {
+    std::vector<Cell> cells;
+    cells.reserve(cells_.size());
+    for (auto& c : cells_) {
+      cells.emplace_back(std::move(c).ToCell());
+    }
+    return Row(*row_key_, std::move(cells));
+  }
+
+ private:
+  SharedCell::StringPtr row_key_;
+  std::vector<SharedCell> cells_;
+};
+
+/**
+ * A Bigtable row that refers to data owned by a `RowReader`.
+ *
+ * Returned by `RowReader::NextRowView()`, see `CellView` for the lifetime of
+ * the data. Use `ToRow()` to keep a copy.
+ */
+class RowView {
+ public:
+  /// Create a view from a row key and a list of cells.
+  RowView(std::string const& row_key, std::vector<CellView> const& cells)
+      : row_key_(&row_key), cells_(&cells) {}
+
+  /// Return the row key.
+  std::string const& row_key() const { return *row_key_; }
+
+  /// Return all cells.
+  std::vector<CellView> const& cells() const { return *cells_; }
+
+  /// Create a `Row` owning copies of the data.
+  Row ToRow() const {
+    std::vector<Cell> cells;
+    cells.reserve(cells_->size());
+    for (auto const& c : *cells_) {
+      cells.emplace_back(c.ToCell());
+    }
+    return Row(*row_key_, std::move(cells));
+  }
+
+ private:
+  std::string const* row_key_;
+  std::vector<CellView> const* cells_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
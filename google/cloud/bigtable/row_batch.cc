@@ -0,0 +1,133 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/row_batch.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+std::size_t constexpr RowBatch::kDefaultMaxRows;
+std::size_t constexpr RowBatch::kDefaultMaxCells;
+
+RowBatch::RowBatch(std::size_t max_rows, std::size_t max_cells)
+    : max_rows_(max_rows), max_cells_(max_cells) {
+  if (max_rows_ != 0) {
+    row_key_offsets_.reserve(max_rows_ + 1);
+    row_cell_offsets_.reserve(max_rows_ + 1);
+  }
+  family_ids_.reserve(max_cells_);
+  qualifier_ids_.reserve(max_cells_);
+  timestamps_.reserve(max_cells_);
+  value_offsets_.reserve(max_cells_ + 1);
+  label_offsets_.reserve(max_cells_ + 1);
+  Clear();
+}
+
+std::string RowBatch::row_key(std::size_t row) const {
+  auto begin = row_key_offsets_[row];
+  return row_keys_.substr(begin, row_key_offsets_[row + 1] - begin);
+}
+
+std::string RowBatch::value(std::size_t cell) const {
+  auto begin = value_offsets_[cell];
+  return values_.substr(begin, value_offsets_[cell + 1] - begin);
+}
+
+Row RowBatch::ToRow(std::size_t row) const {
+  std::vector<Cell> cells;
+  auto key = row_key(row);
+  for (auto i = row_cell_offsets_[row]; i != row_cell_offsets_[row + 1]; ++i) {
+    std::vector<std::string> labels;
+    for (auto j = label_offsets_[i]; j != label_offsets_[i + 1]; ++j) {
+      labels.push_back(labels_[label_ids_[j]]);
+    }
+    cells.emplace_back(key, families_[family_ids_[i]],
+                       qualifiers_[qualifier_ids_[i]], timestamps_[i],
+                       value(i), std::move(labels));
+  }
+  return Row(std::move(key), std::move(cells));
+}
+
+bool RowBatch::CanAppend(RowView const& row) const {
+  if (empty()) {
+    return true;
+  }
+  return (max_rows_ == 0 || row_count() < max_rows_) &&
+         cell_count() + row.cells().size() <= max_cells_;
+}
+
+void RowBatch::Append(RowView const& row) {
+  row_keys_.append(row.row_key());
+  row_key_offsets_.push_back(row_keys_.size());
+  for (auto const& cell : row.cells()) {
+    // Consecutive cells are usually in the same column family.
+    if (!family_ids_.empty() &&
+        families_[family_ids_.back()] == cell.family_name()) {
+      family_ids_.push_back(family_ids_.back());
+    } else {
+      family_ids_.push_back(
+          Lookup(families_, family_index_, cell.family_name()));
+    }
+    qualifier_ids_.push_back(
+        Lookup(qualifiers_, qualifier_index_, cell.column_qualifier()));
+    timestamps_.push_back(cell.timestamp().count());
+    values_.append(cell.value());
+    value_offsets_.push_back(values_.size());
+    for (auto const& label : cell.labels()) {
+      label_ids_.push_back(Lookup(labels_, label_index_, label));
+    }
+    label_offsets_.push_back(label_ids_.size());
+  }
+  row_cell_offsets_.push_back(timestamps_.size());
+}
+
+void RowBatch::Clear() {
+  row_keys_.clear();
+  row_key_offsets_.assign(1, 0);
+  row_cell_offsets_.assign(1, 0);
+  family_ids_.clear();
+  qualifier_ids_.clear();
+  timestamps_.clear();
+  values_.clear();
+  value_offsets_.assign(1, 0);
+  label_offsets_.assign(1, 0);
+  label_ids_.clear();
+  families_.clear();
+  qualifiers_.clear();
+  labels_.clear();
+  family_index_.clear();
+  qualifier_index_.clear();
+  label_index_.clear();
+}
+
+std::uint32_t RowBatch::Lookup(
+    std::vector<std::string>& dictionary,
+    std::unordered_map<std::string, std::uint32_t>& index,
+    std::string const& value) {
+  auto loc = index.find(value);
+  if (loc != index.end()) {
+    return loc->second;
+  }
+  auto id = static_cast<std::uint32_t>(dictionary.size());
+  dictionary.push_back(value);
+  index.emplace(value, id);
+  return id;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
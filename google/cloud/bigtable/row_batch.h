@@ -0,0 +1,187 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H_
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A batch of rows laid out column-wise.
+ *
+ * Applications exporting large scans (for example, to columnar formats) can
+ * use `RowReader::NextBatch()` to receive the rows in batches, instead of one
+ * `Row` (and one `Cell` object per cell) at a time. In a `RowBatch` the data
+ * for all the cells is stored in a handful of contiguous buffers:
+ *
+ * - The row keys are concatenated in `row_keys()`, the key for row `i` is in
+ *   the range `[row_key_offsets()[i], row_key_offsets()[i + 1])`.
+ * - The cells for row `i` are the indices in the range
+ *   `[row_cell_offsets()[i], row_cell_offsets()[i + 1])`.
+ * - The column family and column qualifier of each cell are indices into the
+ *   `families()` and `qualifiers()` dictionaries.
+ * - The timestamps (in microseconds) of each cell are in `timestamps()`.
+ * - The values are concatenated in `values()`, the value for cell `j` is in
+ *   the range `[value_offsets()[j], value_offsets()[j + 1])`.
+ * - The labels for cell `j` are the entries in the range
+ *   `[label_offsets()[j], label_offsets()[j + 1])` of `label_ids()`, which
+ *   are indices into the `labels()` dictionary.
+ *
+ * The dictionaries are local to each batch. A batch has a fixed capacity, set
+ * when it is created, and its buffers are reused when the batch is cleared, so
+ * reading a stream into the same batch allocates memory only while the buffers
+ * grow.
+ */
+class RowBatch {
+ public:
+  /// The default maximum number of rows in a batch.
+  static std::size_t constexpr kDefaultMaxRows = 1024;
+
+  /// The default maximum number of cells in a batch.
+  static std::size_t constexpr kDefaultMaxCells = 64 * 1024;
+
+  /**
+   * Create an empty batch.
+   *
+   * @param max_rows the maximum number of rows in the batch. Zero is used as a
+   *     magic value that means "no limit", in that case only @p max_cells
+   *     limits the size of the batch.
+   * @param max_cells the maximum number of cells in the batch.
+   */
+  explicit RowBatch(std::size_t max_rows = kDefaultMaxRows,
+                    std::size_t max_cells = kDefaultMaxCells);
+
+  /// The maximum number of rows in this batch, zero if there is no limit.
+  std::size_t max_rows() const { return max_rows_; }
+
+  /**
+   * The maximum number of cells in this batch.
+   *
+   * Rows are never split across batches, a row with more cells than this value
+   * is stored in a batch by itself.
+   */
+  std::size_t max_cells() const { return max_cells_; }
+
+  /// The number of rows in the batch.
+  std::size_t row_count() const { return row_key_offsets_.size() - 1; }
+
+  /// The number of cells in the batch.
+  std::size_t cell_count() const { return timestamps_.size(); }
+
+  /// Return true if the batch has no rows.
+  bool empty() const { return row_count() == 0; }
+
+  //@{
+  /// @name Per-row data.
+  std::string const& row_keys() const { return row_keys_; }
+  std::vector<std::size_t> const& row_key_offsets() const {
+    return row_key_offsets_;
+  }
+  std::vector<std::size_t> const& row_cell_offsets() const {
+    return row_cell_offsets_;
+  }
+  //@}
+
+  //@{
+  /// @name Per-cell data.
+  std::vector<std::uint32_t> const& family_ids() const { return family_ids_; }
+  std::vector<std::uint32_t> const& qualifier_ids() const {
+    return qualifier_ids_;
+  }
+  std::vector<std::int64_t> const& timestamps() const { return timestamps_; }
+  std::string const& values() const { return values_; }
+  std::vector<std::size_t> const& value_offsets() const {
+    return value_offsets_;
+  }
+  std::vector<std::size_t> const& label_offsets() const {
+    return label_offsets_;
+  }
+  std::vector<std::uint32_t> const& label_ids() const { return label_ids_; }
+  //@}
+
+  //@{
+  /// @name The dictionaries for the column families, qualifiers, and labels.
+  std::vector<std::string> const& families() const { return families_; }
+  std::vector<std::string> const& qualifiers() const { return qualifiers_; }
+  std::vector<std::string> const& labels() const { return labels_; }
+  //@}
+
+  /// Return a copy of the key for row @p row.
+  std::string row_key(std::size_t row) const;
+
+  /// Return a copy of the value for cell @p cell.
+  std::string value(std::size_t cell) const;
+
+  /// Create a `Row` with a copy of the data for row @p row.
+  Row ToRow(std::size_t row) const;
+
+  /// Return true if @p row fits in the remaining capacity of the batch.
+  bool CanAppend(RowView const& row) const;
+
+  /**
+   * Append a copy of @p row to the batch.
+   *
+   * The capacity is not checked, use `CanAppend()` to check it first.
+   */
+  void Append(RowView const& row);
+
+  /// Remove all the rows, keeping the allocated buffers.
+  void Clear();
+
+ private:
+  /// Return the index of @p value in @p dictionary, adding it if needed.
+  static std::uint32_t Lookup(
+      std::vector<std::string>& dictionary,
+      std::unordered_map<std::string, std::uint32_t>& index,
+      std::string const& value);
+
+  std::size_t max_rows_;
+  std::size_t max_cells_;
+
+  std::string row_keys_;
+  std::vector<std::size_t> row_key_offsets_;
+  std::vector<std::size_t> row_cell_offsets_;
+
+  std::vector<std::uint32_t> family_ids_;
+  std::vector<std::uint32_t> qualifier_ids_;
+  std::vector<std::int64_t> timestamps_;
+  std::string values_;
+  std::vector<std::size_t> value_offsets_;
+  std::vector<std::size_t> label_offsets_;
+  std::vector<std::uint32_t> label_ids_;
+
+  std::vector<std::string> families_;
+  std::vector<std::string> qualifiers_;
+  std::vector<std::string> labels_;
+  std::unordered_map<std::string, std::uint32_t> family_index_;
+  std::unordered_map<std::string, std::uint32_t> qualifier_index_;
+  std::unordered_map<std::string, std::uint32_t> label_index_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_BATCH_H_
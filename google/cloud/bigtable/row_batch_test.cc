@@ -0,0 +1,126 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/row_batch.h"
+#include <gtest/gtest.h>
+
+namespace bigtable = google::cloud::bigtable;
+
+namespace {
+/// Owns the data referenced by a `RowView` in these tests.
+struct TestRow {
+  TestRow(std::string key, std::vector<std::vector<std::string>> cells)
+      : row_key(std::move(key)), data(std::move(cells)) {
+    for (auto const& c : data) {
+      views.emplace_back(row_key, c[0], c[1], 42, c[2], labels);
+    }
+  }
+
+  bigtable::RowView view() const { return bigtable::RowView(row_key, views); }
+
+  std::string row_key;
+  std::vector<std::vector<std::string>> data;
+  bigtable::CellView::Labels labels;
+  std::vector<bigtable::CellView> views;
+};
+}  // anonymous namespace
+
+/// @test Verify the columnar layout of a RowBatch.
+TEST(RowBatchTest, Layout) {
+  TestRow r1("r1", {{"fam", "c1", "v1"}, {"fam", "c2", "value2"}});
+  TestRow r2("row2", {{"other", "c1", "v3"}});
+  r2.labels.Add()->assign("label");
+  r2.views.assign(1, bigtable::CellView(r2.row_key, r2.data[0][0],
+                                        r2.data[0][1], 43, r2.data[0][2],
+                                        r2.labels));
+
+  bigtable::RowBatch batch;
+  EXPECT_TRUE(batch.empty());
+  batch.Append(r1.view());
+  batch.Append(r2.view());
+
+  ASSERT_EQ(2U, batch.row_count());
+  ASSERT_EQ(3U, batch.cell_count());
+  EXPECT_EQ("r1row2", batch.row_keys());
+  EXPECT_EQ((std::vector<std::size_t>{0, 2, 6}), batch.row_key_offsets());
+  EXPECT_EQ((std::vector<std::size_t>{0, 2, 3}), batch.row_cell_offsets());
+  EXPECT_EQ("row2", batch.row_key(1));
+
+  EXPECT_EQ((std::vector<std::string>{"fam", "other"}), batch.families());
+  EXPECT_EQ((std::vector<std::string>{"c1", "c2"}), batch.qualifiers());
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 0, 1}), batch.family_ids());
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 0}), batch.qualifier_ids());
+  EXPECT_EQ((std::vector<std::int64_t>{42, 42, 43}), batch.timestamps());
+  EXPECT_EQ("v1value2v3", batch.values());
+  EXPECT_EQ((std::vector<std::size_t>{0, 2, 8, 10}), batch.value_offsets());
+  EXPECT_EQ("value2", batch.value(1));
+  EXPECT_EQ((std::vector<std::string>{"label"}), batch.labels());
+  EXPECT_EQ((std::vector<std::size_t>{0, 0, 0, 1}), batch.label_offsets());
+  EXPECT_EQ((std::vector<std::uint32_t>{0}), batch.label_ids());
+
+  auto row = batch.ToRow(1);
+  EXPECT_EQ("row2", row.row_key());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("other", row.cells()[0].family_name());
+  EXPECT_EQ("c1", row.cells()[0].column_qualifier());
+  EXPECT_EQ(43, row.cells()[0].timestamp().count());
+  EXPECT_EQ("v3", row.cells()[0].value());
+  EXPECT_EQ((std::vector<std::string>{"label"}), row.cells()[0].labels());
+
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0U, batch.cell_count());
+  EXPECT_TRUE(batch.values().empty());
+  EXPECT_TRUE(batch.families().empty());
+}
+
+/// @test Verify the capacity limits of a RowBatch.
+TEST(RowBatchTest, Capacity) {
+  TestRow r1("r1", {{"fam", "c1", "v1"}, {"fam", "c2", "v2"}});
+  TestRow r2("r2", {{"fam", "c1", "v3"}});
+
+  bigtable::RowBatch batch(2, 2);
+  EXPECT_EQ(2U, batch.max_rows());
+  EXPECT_EQ(2U, batch.max_cells());
+  EXPECT_TRUE(batch.CanAppend(r1.view()));
+  batch.Append(r1.view());
+  // The batch has room for another row, but not for its cells.
+  EXPECT_FALSE(batch.CanAppend(r2.view()));
+
+  // An empty batch accepts any row, even if it is too large.
+  bigtable::RowBatch small(2, 1);
+  EXPECT_TRUE(small.CanAppend(r1.view()));
+  small.Append(r1.view());
+  EXPECT_FALSE(small.CanAppend(r2.view()));
+
+  bigtable::RowBatch single(1, 10);
+  single.Append(r2.view());
+  EXPECT_FALSE(single.CanAppend(r1.view()));
+}
+
+/// @test Verify that a RowBatch without a row limit is bounded by its cells.
+TEST(RowBatchTest, NoRowLimit) {
+  TestRow r1("r1", {{"fam", "c1", "v1"}});
+  TestRow r2("r2", {{"fam", "c1", "v2"}, {"fam", "c2", "v3"}});
+
+  bigtable::RowBatch batch(0, 3);
+  EXPECT_EQ(0U, batch.max_rows());
+  EXPECT_TRUE(batch.CanAppend(r1.view()));
+  batch.Append(r1.view());
+  EXPECT_TRUE(batch.CanAppend(r2.view()));
+  batch.Append(r2.view());
+  EXPECT_EQ(2U, batch.row_count());
+  EXPECT_FALSE(batch.CanAppend(r1.view()));
+}
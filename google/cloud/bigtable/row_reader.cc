@@ -14,11 +14,11 @@
 
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
 #include "google/cloud/bigtable/internal/table.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/log.h"
-#include <thread>
 
 namespace google {
 namespace cloud {
@@ -92,7 +92,11 @@ RowReader::RowReader(
       parser_factory_(std::move(parser_factory)),
       stream_is_open_(false),
       operation_cancelled_(false),
+      share_strings_(false),
       processed_chunks_count_(0),
+      arena_response_(nullptr),
+      read_ahead_responses_(0),
+      read_ahead_bytes_(0),
       rows_count_(0) {}
 
 // The name must be all lowercase to work with range-for loops.
@@ -108,6 +112,10 @@ RowReader::iterator RowReader::end() { return internal::RowReaderIterator(); }
 void RowReader::MakeRequest() {
   response_ = {};
   processed_chunks_count_ = 0;
+  if (arena_pool_) {
+    arena_response_ = nullptr;
+    arena_pool_->Release(0);
+  }
 
   google::bigtable::v2::ReadRowsRequest request;
 
@@ -124,36 +132,69 @@ void RowReader::MakeRequest() {
     request.set_rows_limit(rows_limit_ - rows_count_);
   }
 
+  // The previous stream, and any thread reading from it, must not outlive its
+  // context.
+  stream_.reset();
+
   context_ = google::cloud::internal::make_unique<grpc::ClientContext>();
   retry_policy_->Setup(*context_);
   backoff_policy_->Setup(*context_);
   metadata_update_policy_.Setup(*context_);
   stream_ = client_->ReadRows(context_.get(), request);
+  if (read_ahead_responses_ != 0) {
+    stream_ = google::cloud::internal::make_unique<
+        internal::PrefetchingReadRowsReader>(std::move(stream_),
+                                             context_.get(),
+                                             read_ahead_responses_,
+                                             read_ahead_bytes_);
+  }
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
+  parser_->set_share_strings(share_strings_);
 }
 
 bool RowReader::NextChunk() {
   ++processed_chunks_count_;
-  while (processed_chunks_count_ >= response_.chunks_size()) {
+  while (processed_chunks_count_ >= CurrentResponse().chunks_size()) {
     processed_chunks_count_ = 0;
-    bool response_is_valid = stream_->Read(&response_);
+    bool response_is_valid = stream_->Read(NextResponseBuffer());
     if (!response_is_valid) {
       response_ = {};
+      arena_response_ = nullptr;
       return false;
     }
   }
   return true;
 }
 
-StatusOr<internal::OptionalRow> RowReader::Advance() {
+google::bigtable::v2::ReadRowsResponse& RowReader::CurrentResponse() {
+  return arena_response_ != nullptr ? *arena_response_ : response_;
+}
+
+google::bigtable::v2::ReadRowsResponse* RowReader::NextResponseBuffer() {
+  if (!arena_pool_) {
+    return &response_;
+  }
+  arena_response_ = arena_pool_->NewResponse();
+  return arena_response_;
+}
+
+template <typename RowType, typename Extractor>
+StatusOr<optional<RowType>> RowReader::AdvanceWithRetries(
+    Extractor const& extract) {
   if (operation_cancelled_) {
     return Status(StatusCode::kCancelled, "Operation cancelled.");
   }
+  if (stream_ && !stream_is_open_) {
+    // The stream finished successfully, there are no more rows. Calling
+    // `Read()` on a finished stream is not allowed, and callers such as
+    // `NextBatch()` or a second `begin()` may ask again after the end.
+    return optional<RowType>();
+  }
   while (true) {
-    internal::OptionalRow row;
-    grpc::Status status = AdvanceOrFail(row);
+    optional<RowType> row;
+    grpc::Status status = AdvanceOrFail(row, extract);
     if (status.ok()) {
       return std::move(row);
     }
@@ -183,14 +224,18 @@ StatusOr<internal::OptionalRow> RowReader::Advance() {
     }
 
     auto delay = backoff_policy_->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!internal::BackoffBeforeRetry(*retry_policy_, delay)) {
+      return internal::MakeStatusFromRpcError(status);
+    }
 
     // If we reach this place, we failed and need to restart the call.
     MakeRequest();
   }
 }
 
-grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
+template <typename RowType, typename Extractor>
+grpc::Status RowReader::AdvanceOrFail(optional<RowType>& row,
+                                      Extractor const& extract) {
   row.reset();
   grpc::Status status;
   if (!stream_) {
@@ -198,9 +243,14 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   }
   while (!parser_->HasNext()) {
     if (NextChunk()) {
-      parser_->HandleChunk(
-          std::move(*(response_.mutable_chunks(processed_chunks_count_))),
-          status);
+      if (arena_response_ != nullptr) {
+        parser_->HandleChunkView(
+            arena_response_->chunks(processed_chunks_count_), status);
+      } else {
+        parser_->HandleChunk(
+            std::move(*(response_.mutable_chunks(processed_chunks_count_))),
+            status);
+      }
       if (!status.ok()) {
         return status;
       }
@@ -220,17 +270,73 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   }
 
   // We have a complete row in the parser.
-  Row parsed_row = parser_->Next(status);
+  RowType parsed_row = extract(status);
   if (!status.ok()) {
     return status;
   }
   row.emplace(std::move(parsed_row));
   ++rows_count_;
-  last_read_row_key_ = std::string(row.value().row_key());
+  last_read_row_key_.assign(row.value().row_key());
 
   return status;
 }
 
+StatusOr<internal::OptionalRow> RowReader::Advance() {
+  return AdvanceWithRetries<Row>(
+      [this](grpc::Status& status) { return parser_->Next(status); });
+}
+
+StatusOr<optional<SharedRow>> RowReader::NextSharedRow() {
+  // Only the parsers created after this point use the shared representation,
+  // `NextShared()` converts the rows of any earlier parser.
+  share_strings_ = true;
+  return AdvanceWithRetries<SharedRow>(
+      [this](grpc::Status& status) { return parser_->NextShared(status); });
+}
+
+StatusOr<optional<RowView>> RowReader::NextRowView() {
+  if (!arena_pool_) {
+    arena_pool_ = google::cloud::internal::make_unique<
+        internal::ReadRowsArenaPool>();
+  }
+  // The previous row is consumed, only the arena holding the response being
+  // parsed is still needed.
+  arena_pool_->Release(arena_response_ == nullptr ? 0 : 1);
+  return AdvanceWithRetries<RowView>(
+      [this](grpc::Status& status) { return parser_->NextView(status); });
+}
+
+Status RowReader::NextBatch(RowBatch& batch) {
+  batch.Clear();
+  if (pending_batch_row_) {
+    // The view is still valid, NextRowView() was not called since.
+    batch.Append(*pending_batch_row_);
+    pending_batch_row_.reset();
+  }
+  while (batch.max_rows() == 0 || batch.row_count() < batch.max_rows()) {
+    auto row = NextRowView();
+    if (!row) {
+      return row.status();
+    }
+    if (!row->has_value()) {
+      break;
+    }
+    if (!batch.CanAppend(**row)) {
+      pending_batch_row_ =
+          google::cloud::internal::make_unique<RowView>(**row);
+      break;
+    }
+    batch.Append(**row);
+  }
+  return Status();
+}
+
+void RowReader::EnableReadAhead(std::size_t max_responses,
+                                std::size_t max_bytes) {
+  read_ahead_responses_ = max_responses;
+  read_ahead_bytes_ = max_bytes;
+}
+
 void RowReader::Cancel() {
   operation_cancelled_ = true;
   if (!stream_is_open_) {
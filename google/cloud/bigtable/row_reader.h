@@ -18,10 +18,13 @@
 #include "google/cloud/bigtable/bigtable_strong_types.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
+#include "google/cloud/bigtable/internal/read_rows_arena_pool.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_batch.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
@@ -93,6 +96,79 @@ class RowReader {
   /// End iterator over the rows in the response.
   iterator end();
 
+  /**
+   * Read the next row, sharing the row key, family and column storage.
+   *
+   * This is an alternative to iterating over the `RowReader`, applications
+   * scanning wide rows may prefer this function to avoid copying the row key,
+   * column family and column qualifier into each cell. Do not mix calls to
+   * this function with the iterators on the same `RowReader`.
+   *
+   * Retry and backoff policies are honored.
+   *
+   * @return the next row, an unset optional if there are no more rows, or the
+   *     error status if the read failed after retries.
+   */
+  StatusOr<optional<SharedRow>> NextSharedRow();
+
+  /**
+   * Read the next row as a view into the received responses.
+   *
+   * This is an alternative to iterating over the `RowReader` for applications
+   * that scan many cells and consume each row before reading the next one. The
+   * responses are received into `google::protobuf::Arena` objects that are
+   * recycled once their rows are consumed, and the returned view refers to the
+   * data in these responses instead of copying it into `Cell` objects. The
+   * arenas hold the message objects, the strings in the responses are still
+   * heap allocated by protobuf. The view, and any `CellView` obtained from it,
+   * is invalidated by the next call to this function. Do not mix calls to this
+   * function with the iterators or `NextSharedRow()` on the same `RowReader`.
+   *
+   * Retry and backoff policies are honored.
+   *
+   * @return a view of the next row, an unset optional if there are no more
+   *     rows, or the error status if the read failed after retries.
+   */
+  StatusOr<optional<RowView>> NextRowView();
+
+  /**
+   * Read the next rows into a columnar batch.
+   *
+   * Clears @p batch and then appends rows until the batch is full or there are
+   * no more rows. The rows are received as in `NextRowView()`, and copied into
+   * the contiguous buffers of the batch. A row that does not fit is kept for
+   * the next call. Do not mix calls to this function with the iterators,
+   * `NextSharedRow()`, or `NextRowView()` on the same `RowReader`.
+   *
+   * Retry and backoff policies are honored.
+   *
+   * @return the status of the read, if it is OK and @p batch is empty there are
+   *     no more rows. On failure, @p batch contains the rows received before
+   *     the error.
+   */
+  Status NextBatch(RowBatch& batch);
+
+  /**
+   * Read the responses ahead of the application on a background thread.
+   *
+   * By default the `RowReader` only reads a response from the stream once all
+   * the rows in the previous response are consumed. With read-ahead enabled a
+   * background thread keeps up to @p max_responses responses, or up to
+   * @p max_bytes bytes of responses, buffered, so the network transfer
+   * overlaps with the processing of the rows. The responses are still parsed
+   * in the thread reading the rows. At least one response is always buffered,
+   * regardless of its size.
+   *
+   * The setting applies to the streams created after this call, call it before
+   * reading the first row. Retries resume after the last row returned to the
+   * application, the buffered responses of a failed stream are discarded.
+   *
+   * @param max_responses the maximum number of buffered responses, zero
+   *     disables read-ahead.
+   * @param max_bytes the maximum size of the buffered responses.
+   */
+  void EnableReadAhead(std::size_t max_responses, std::size_t max_bytes);
+
   /**
    * Gracefully terminate a streaming read.
    *
@@ -111,8 +187,18 @@ class RowReader {
    */
   StatusOr<internal::OptionalRow> Advance();
 
-  /// Called by Advance(), does not handle retries.
-  grpc::Status AdvanceOrFail(internal::OptionalRow& row);
+  /**
+   * Read and parse the next row, retrying as needed.
+   *
+   * @param extract how to take the row from the parser, either `Row` or
+   *     `SharedRow` objects are returned.
+   */
+  template <typename RowType, typename Extractor>
+  StatusOr<optional<RowType>> AdvanceWithRetries(Extractor const& extract);
+
+  /// Called by AdvanceWithRetries(), does not handle retries.
+  template <typename RowType, typename Extractor>
+  grpc::Status AdvanceOrFail(optional<RowType>& row, Extractor const& extract);
 
   /**
    * Move the `processed_chunks_count_` index to the next chunk,
@@ -127,6 +213,12 @@ class RowReader {
    */
   bool NextChunk();
 
+  /// The response holding the chunks being parsed.
+  google::bigtable::v2::ReadRowsResponse& CurrentResponse();
+
+  /// The buffer to receive the next response.
+  google::bigtable::v2::ReadRowsResponse* NextResponseBuffer();
+
   /// Sends the ReadRows request to the stub.
   void MakeRequest();
 
@@ -149,12 +241,26 @@ class RowReader {
       stream_;
   bool stream_is_open_;
   bool operation_cancelled_;
+  /// Set by `NextSharedRow()`, the parsers then build `SharedCell` objects.
+  bool share_strings_;
 
   /// The last received response, chunks are being parsed one by one from it.
   google::bigtable::v2::ReadRowsResponse response_;
-  /// Number of chunks already parsed in response_.
+  /// Number of chunks already parsed in the current response.
   int processed_chunks_count_;
 
+  /// The arenas used by NextRowView(), created on its first call.
+  std::unique_ptr<internal::ReadRowsArenaPool> arena_pool_;
+  /// The last received response when using arenas, owned by `arena_pool_`.
+  google::bigtable::v2::ReadRowsResponse* arena_response_;
+  /// A row received by NextBatch() that did not fit in the previous batch.
+  std::unique_ptr<RowView> pending_batch_row_;
+
+  /// The read-ahead limits, read-ahead is disabled if `read_ahead_responses_`
+  /// is zero.
+  std::size_t read_ahead_responses_;
+  std::size_t read_ahead_bytes_;
+
   /// Number of rows read so far, used to set row_limit in retries.
   std::int64_t rows_count_;
   /// Holds the last read row key, for retries.
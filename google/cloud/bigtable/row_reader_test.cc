@@ -211,6 +211,39 @@ TEST_F(RowReaderTest, ReadOneRow) {
   EXPECT_EQ(++it, reader.end());
 }
 
+TEST_F(RowReaderTest, ReadAfterStreamFinished) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  EXPECT_CALL(*parser, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet(),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  EXPECT_EQ(++it, reader.end());
+
+  // The stream is not read again, neither by a new iterator nor by the other
+  // functions to read rows.
+  EXPECT_EQ(reader.begin(), reader.end());
+  auto row = reader.NextSharedRow();
+  ASSERT_STATUS_OK(row);
+  EXPECT_FALSE(row->has_value());
+}
+
 TEST_F(RowReaderTest, ReadOneRow_AppProfileId) {
   using namespace ::testing;
   auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
@@ -787,3 +820,237 @@ TEST_F(RowReaderTest, FailedStreamRetryNewContext) {
   EXPECT_EQ((*it)->row_key(), "r1");
   EXPECT_EQ(++it, reader.end());
 }
+
+TEST_F(RowReaderTest, NextRowViewSpansResponses) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto r1 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v1"
+      })");
+  auto r2 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        qualifier { value: "c2" }
+        timestamp_micros: 10
+        value: "v2"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        timestamp_micros: 10
+        value: "v3"
+        commit_row: true
+      })");
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(r1), Return(true)));
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(r2), Return(true)));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+  EXPECT_CALL(*parser_factory_, CreateHook()).Times(1);
+
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet(),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  auto row = reader.NextRowView();
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->has_value());
+  EXPECT_EQ("r1", (*row)->row_key());
+  ASSERT_EQ(2U, (*row)->cells().size());
+  EXPECT_EQ("fam", (*row)->cells()[1].family_name());
+  EXPECT_EQ("c2", (*row)->cells()[1].column_qualifier());
+  EXPECT_EQ("v1", (*row)->cells()[0].value());
+  EXPECT_EQ("v2", (*row)->cells()[1].value());
+
+  row = reader.NextRowView();
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->has_value());
+  EXPECT_EQ("r2", (*row)->row_key());
+  ASSERT_EQ(1U, (*row)->cells().size());
+  EXPECT_EQ("fam", (*row)->cells()[0].family_name());
+  EXPECT_EQ("c2", (*row)->cells()[0].column_qualifier());
+  EXPECT_EQ("v3", (*row)->cells()[0].value());
+
+  row = reader.NextRowView();
+  ASSERT_STATUS_OK(row);
+  EXPECT_FALSE(row->has_value());
+}
+
+TEST_F(RowReaderTest, NextBatchKeepsRowsThatDoNotFit) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v1"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v2"
+      }
+      chunks {
+        qualifier { value: "c2" }
+        timestamp_micros: 10
+        value: "v3"
+        commit_row: true
+      })");
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+  EXPECT_CALL(*parser_factory_, CreateHook()).Times(1);
+
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet(),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  // The second row does not fit in the first batch.
+  bigtable::RowBatch batch(10, 2);
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  ASSERT_EQ(1U, batch.row_count());
+  EXPECT_EQ("r1", batch.row_key(0));
+  EXPECT_EQ("v1", batch.values());
+
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  ASSERT_EQ(1U, batch.row_count());
+  EXPECT_EQ("r2", batch.row_key(0));
+  EXPECT_EQ("v2v3", batch.values());
+  EXPECT_EQ((std::vector<std::string>{"c1", "c2"}), batch.qualifiers());
+
+  ASSERT_STATUS_OK(reader.NextBatch(batch));
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST_F(RowReaderTest, ReadAheadRetriesSkipAlreadyReadRows) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto r1 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v1"
+        commit_row: true
+      }
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "partial"
+      })");
+  auto r2 = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v2"
+        commit_row: true
+      })");
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(3)))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(r1), Return(true)));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "retry")));
+
+    EXPECT_CALL(*retry_policy_, OnFailureHook(_)).WillOnce(Return(true));
+    EXPECT_CALL(*backoff_policy_, OnCompletionHook(_))
+        .WillOnce(Return(std::chrono::milliseconds(0)));
+
+    auto stream_retry = new MockReadRowsReader;  // the stub will free it
+    // The partial row is requested again, the first row is not.
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(2)))
+        .WillOnce(Invoke(stream_retry->MakeMockReturner()));
+    EXPECT_CALL(*stream_retry, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(r2), Return(true)));
+    EXPECT_CALL(*stream_retry, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+  EXPECT_CALL(*parser_factory_, CreateHook()).Times(2);
+
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet("r1", "r2", "r3"),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+  reader.EnableReadAhead(4, 1024 * 1024);
+
+  std::vector<std::string> keys;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    keys.push_back(row->row_key());
+    ASSERT_EQ(1U, row->cells().size());
+    EXPECT_NE("partial", row->cells()[0].value());
+  }
+  EXPECT_EQ((std::vector<std::string>{"r1", "r2"}), keys);
+}
+
+TEST_F(RowReaderTest, ReadAheadCancelDrainsStream) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "c1" }
+        timestamp_micros: 10
+        value: "v1"
+        commit_row: true
+      })");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+  int reads = 0;
+  EXPECT_CALL(*stream, Read(_))
+      .WillRepeatedly(Invoke([&reads, &response](ReadRowsResponse* r) {
+        if (++reads > 10) {
+          return false;
+        }
+        *r = response;
+        response.mutable_chunks(0)->set_row_key("r" + std::to_string(reads));
+        return true;
+      }));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::CANCELLED, "")));
+
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet(),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+  reader.EnableReadAhead(2, 1024 * 1024);
+
+  auto it = reader.begin();
+  ASSERT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ("r1", (*it)->row_key());
+  reader.Cancel();
+  EXPECT_EQ(11, reads);
+}
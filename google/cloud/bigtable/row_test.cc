@@ -35,3 +35,26 @@ TEST(RowTest, RowInstantiation) {
   EXPECT_EQ(2U, two_cells_row.cells().size());
   EXPECT_EQ(std::next(two_cells_row.cells().begin())->value(), cell2.value());
 }
+
+/// @test Verify SharedRow instantiation and conversion to Row.
+TEST(RowTest, SharedRow) {
+  auto row_key = std::make_shared<std::string const>("row");
+  auto family = std::make_shared<std::string const>("family");
+  auto column = std::make_shared<std::string const>("column");
+  bigtable::SharedCell cell(row_key, family, column, 42, "value", {});
+  bigtable::SharedCell cell2(row_key, family, column, 43, "val", {});
+  bigtable::SharedRow shared_row(row_key, {cell, cell2});
+
+  EXPECT_EQ("row", shared_row.row_key());
+  ASSERT_EQ(2U, shared_row.cells().size());
+  EXPECT_EQ(&shared_row.row_key(), &shared_row.cells()[0].row_key());
+  EXPECT_EQ(&shared_row.row_key(), &shared_row.cells()[1].row_key());
+
+  bigtable::Row row = std::move(shared_row).ToRow();
+  EXPECT_EQ("row", row.row_key());
+  ASSERT_EQ(2U, row.cells().size());
+  EXPECT_EQ("row", row.cells()[0].row_key());
+  EXPECT_EQ("family", row.cells()[0].family_name());
+  EXPECT_EQ("column", row.cells()[1].column_qualifier());
+  EXPECT_EQ("val", row.cells()[1].value());
+}
@@ -64,6 +64,11 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(internal::MakeStatusFromRpcError(status));
 }
 
+std::chrono::system_clock::time_point LimitedTimeRetryPolicy::retry_deadline()
+    const {
+  return impl_.deadline();
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -105,6 +105,18 @@ class RPCRetryPolicy {
   // TODO(coryan) - remove ::grpc::Status version.
   virtual bool OnFailure(grpc::Status const& status) = 0;
 
+  /**
+   * Return the time after which the policy stops retrying.
+   *
+   * The client library does not start a backoff that would end after this
+   * time, it reports the last error instead. Policies that do not bound the
+   * total time of an operation do not need to override this function, the
+   * default never expires.
+   */
+  virtual std::chrono::system_clock::time_point retry_deadline() const {
+    return std::chrono::system_clock::time_point::max();
+  }
+
   static bool IsPermanentFailure(google::cloud::Status const& status) {
     return SafeGrpcRetry::IsPermanentFailure(status);
   }
@@ -153,6 +165,7 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   bool OnFailure(google::cloud::Status const& status) override;
   // TODO(coryan) - remove ::grpc::Status version.
   bool OnFailure(grpc::Status const& status) override;
+  std::chrono::system_clock::time_point retry_deadline() const override;
 
  private:
   using Impl =
@@ -82,6 +82,20 @@ TEST(LimitedTimeRetryPolicy, OnNonRetryable) {
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
 
+/// @test Verify that LimitedTimeRetryPolicy reports its deadline.
+TEST(LimitedTimeRetryPolicy, RetryDeadline) {
+  auto const start = std::chrono::system_clock::now();
+  bigtable::LimitedTimeRetryPolicy original(kLimitedTimeTestPeriod);
+  EXPECT_LE(start + kLimitedTimeTestPeriod, original.retry_deadline());
+  EXPECT_GE(std::chrono::system_clock::now() + kLimitedTimeTestPeriod,
+            original.retry_deadline());
+
+  // Each clone starts a new operation, with its own deadline.
+  std::this_thread::sleep_for(kLimitedTimeTolerance);
+  auto tested = original.clone();
+  EXPECT_LT(original.retry_deadline(), tested->retry_deadline());
+}
+
 /// @test A simple test for the LimitedErrorCountRetryPolicy.
 TEST(LimitedErrorCountRetryPolicy, Simple) {
   using namespace google::cloud::testing_util::chrono_literals;
@@ -110,3 +124,10 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   bigtable::LimitedErrorCountRetryPolicy tested(3);
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
+
+/// @test Verify that LimitedErrorCountRetryPolicy does not bound the time.
+TEST(LimitedErrorCountRetryPolicy, RetryDeadline) {
+  bigtable::LimitedErrorCountRetryPolicy tested(3);
+  EXPECT_EQ(std::chrono::system_clock::time_point::max(),
+            tested.retry_deadline());
+}
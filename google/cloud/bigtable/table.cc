@@ -14,11 +14,16 @@
 
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/async_future_from_callback.h"
+#include "google/cloud/bigtable/internal/async_read_rows_future.h"
 #include "google/cloud/bigtable/internal/async_retry_unary_rpc.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/retry_backoff.h"
+#include "google/cloud/bigtable/internal/split_row_set.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
-#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <type_traits>
 
 namespace btproto = ::google::bigtable::v2;
@@ -70,7 +75,10 @@ Status Table::Apply(SingleRowMutation mut) {
           "Permanent (or too many transient) errors in Table::Apply()");
     }
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!internal::BackoffBeforeRetry(*rpc_policy, delay)) {
+      return bigtable::internal::MakeStatusFromRpcError(
+          status.error_code(), "Retry deadline exhausted in Table::Apply()");
+    }
   }
 }
 
@@ -130,8 +138,12 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
     if (!status.ok() && !retry_policy->OnFailure(status)) {
       break;
     }
+    // The mutations still pending after a partial success have no error to
+    // report yet, they are retried until the retry deadline.
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!internal::BackoffBeforeRetry(*retry_policy, delay)) {
+      break;
+    }
   }
   auto failures = mutator.ExtractFinalFailures();
 
@@ -177,6 +189,80 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                        bigtable::internal::ReadRowsParserFactory>());
 }
 
+future<Status> Table::AsyncReadRows(std::function<future<bool>(Row)> on_row,
+                                    RowSet row_set, Filter filter,
+                                    CompletionQueue& cq) {
+  return AsyncReadRows(std::move(on_row), std::move(row_set),
+                       RowReader::NO_ROWS_LIMIT, std::move(filter), cq);
+}
+
+future<Status> Table::AsyncReadRows(std::function<future<bool>(Row)> on_row,
+                                    RowSet row_set, std::int64_t rows_limit,
+                                    Filter filter, CompletionQueue& cq) {
+  if (rows_limit < 0) {
+    return make_ready_future(
+        Status(StatusCode::kInvalidArgument, "rows_limit must be >= 0"));
+  }
+  return internal::AsyncReadRowsFuture::Create(
+      cq, impl_.client_, impl_.app_profile_id_, impl_.table_name_,
+      std::move(row_set), rows_limit, std::move(filter),
+      clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      clone_metadata_update_policy(),
+      google::cloud::internal::make_unique<
+          bigtable::internal::ReadRowsParserFactory>(),
+      std::move(on_row));
+}
+
+Status Table::ParallelReadRows(
+    RowSet row_set, Filter filter, ParallelScanOptions const& options,
+    std::function<bool(std::size_t shard, Row row)> const& on_row) {
+  auto samples = SampleRows<>();
+  if (!samples) {
+    return samples.status();
+  }
+  auto const shards = internal::SplitRowSet(row_set, *samples);
+
+  std::atomic<std::size_t> next_shard(0);
+  std::atomic<bool> stop(false);
+  std::mutex mu;
+  Status first_error;
+  auto read_shards = [&] {
+    for (auto i = next_shard++; i < shards.size() && !stop; i = next_shard++) {
+      auto reader = ReadRows(shards[i], filter);
+      if (options.read_ahead_responses != 0) {
+        reader.EnableReadAhead(options.read_ahead_responses,
+                               options.read_ahead_bytes);
+      }
+      for (auto& row : reader) {
+        if (!row) {
+          std::lock_guard<std::mutex> lk(mu);
+          if (first_error.ok()) {
+            first_error = row.status();
+          }
+          stop = true;
+          break;
+        }
+        if (stop || !on_row(i, std::move(*row))) {
+          stop = true;
+          break;
+        }
+      }
+    }
+  };
+
+  auto const thread_count = std::min(
+      shards.size(), std::max<std::size_t>(options.max_parallelism, 1));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < thread_count; ++t) {
+    threads.emplace_back(read_shards);
+  }
+  read_shards();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return first_error;
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
   RowSet row_set(std::move(row_key));
@@ -350,9 +436,13 @@ void Table::SampleRowsImpl(
                             "No more retries allowed as per policy.");
       return;
     }
-    clearer();
     auto delay = backoff_policy->OnCompletion(status);
-    std::this_thread::sleep_for(delay);
+    if (!internal::BackoffBeforeRetry(*retry_policy, delay)) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Retry deadline exhausted as per policy.");
+      return;
+    }
+    clearer();
   }
 }
 }  // namespace BIGTABLE_CLIENT_NS
@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
 #include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/parallel_scan_options.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/future.h"
@@ -35,6 +36,7 @@ class MutationBatcher;
  * This class provides member functions to:
  * - read specific rows: `Table::ReadRow()`
  * - scan a ranges of rows: `Table::ReadRows()`
+ * - scan large ranges of rows in parallel: `Table::ParallelReadRows()`
  * - update or create a single row: `Table::Apply()`
  * - update or modify multiple rows: `Table::BulkApply()`
  * - update a row based on previous values: `Table::CheckAndMutateRow()`
@@ -190,6 +192,19 @@ class Table {
   std::string const& table_name() const { return impl_.table_name(); }
   std::string const& app_profile_id() const { return impl_.app_profile_id(); }
 
+  /**
+   * Return a completion queue run by the client's background threads.
+   *
+   * Applications that do not create and run their own `CompletionQueue` can
+   * use this queue with the asynchronous member functions of this class. The
+   * threads keep running while a copy of the queue exists, even after the
+   * client is destroyed.
+   */
+  CompletionQueue background_completion_queue() const {
+    return internal::BackgroundCompletionQueue(
+        impl_.client_->BackgroundThreads());
+  }
+
   /**
    * Attempts to apply the mutation to a row.
    *
@@ -290,6 +305,80 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Asynchronously reads a set of rows from the table, with flow control.
+   *
+   * Each row is passed to @p on_row, which returns a `future<bool>`. No more
+   * rows are delivered, and no more data is requested from the server, until
+   * that future is satisfied. A value of `false` stops the scan. This allows
+   * applications to process rows asynchronously without buffering them, and
+   * to run many concurrent scans with a few threads blocked in `cq.Run()`.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param on_row called with each row, in row key order, never concurrently.
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @return a future satisfied when the scan finishes, its value is the error
+   *     status if the read failed after retries. If @p on_row stops the scan
+   *     the status is OK.
+   */
+  future<Status> AsyncReadRows(std::function<future<bool>(Row)> on_row,
+                               RowSet row_set, Filter filter,
+                               CompletionQueue& cq);
+
+  /**
+   * Asynchronously reads a limited set of rows from the table.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param on_row called with each row, see `AsyncReadRows()` above.
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read. Zero means no limit,
+   *     as in `AsyncReadRows(on_row, RowSet, Filter, cq)`. Negative values are
+   *     rejected with `StatusCode::kInvalidArgument`.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param cq the completion queue that will execute the asynchronous calls.
+   */
+  future<Status> AsyncReadRows(std::function<future<bool>(Row)> on_row,
+                               RowSet row_set, std::int64_t rows_limit,
+                               Filter filter, CompletionQueue& cq);
+
+  /**
+   * Reads a set of rows from the table, scanning several shards in parallel.
+   *
+   * The row set is split into shards at the row keys returned by
+   * `SampleRows()`, and each shard is read with its own `RowReader`, using up
+   * to `options.max_parallelism` threads, including the calling thread. The
+   * function returns once all the shards are read, or once the scan stops.
+   *
+   * The shards are numbered in row key order, so the rows of shard `i` sort
+   * before the rows of shard `i + 1`, and within a shard @p on_row receives the
+   * rows in row key order. @p on_row is called concurrently for different
+   * shards, but never concurrently for the same shard.
+   *
+   * Retry and backoff policies are honored in each shard.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param options the parallelism and read-ahead for the scan.
+   * @param on_row called with the shard number and each row, return `false`
+   *     to stop the scan.
+   * @return the status of the scan, the first error if a shard or the
+   *     `SampleRows()` request fail after retries. If @p on_row stops the scan
+   *     the status is OK.
+   */
+  Status ParallelReadRows(
+      RowSet row_set, Filter filter, ParallelScanOptions const& options,
+      std::function<bool(std::size_t shard, Row row)> const& on_row);
+
   /**
    * Read and return a single row from the table.
    *
@@ -93,6 +93,19 @@ class TableAdmin {
   std::string const& instance_id() const { return impl_.instance_id(); }
   std::string const& instance_name() const { return impl_.instance_name(); }
 
+  /**
+   * Return a completion queue run by the client's background threads.
+   *
+   * Applications that do not create and run their own `CompletionQueue` can
+   * use this queue with the asynchronous member functions of this class. The
+   * threads keep running while a copy of the queue exists, even after the
+   * client is destroyed.
+   */
+  CompletionQueue background_completion_queue() const {
+    return internal::BackgroundCompletionQueue(
+        impl_.client_->BackgroundThreads());
+  }
+
   /**
    * Create a new table in the instance.
    *
@@ -81,3 +81,22 @@ TEST_F(TableApplyTest, RetryIdempotent) {
   EXPECT_FALSE(status.ok());
   EXPECT_EQ(google::cloud::StatusCode::kUnavailable, status.code());
 }
+
+/// @test Verify that Table::Apply() does not back off past the retry deadline.
+TEST_F(TableApplyTest, RetryDeadline) {
+  using namespace ::testing;
+
+  bigtable::Table table(client_, "foo-table",
+                        bigtable::LimitedTimeRetryPolicy(1_s),
+                        bigtable::ExponentialBackoffPolicy(60_s, 60_s));
+  EXPECT_CALL(*client_, MutateRow(_, _, _))
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+
+  auto start = std::chrono::steady_clock::now();
+  auto status = table.Apply(bigtable::SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(google::cloud::StatusCode::kUnavailable, status.code());
+  EXPECT_GT(30_s, std::chrono::steady_clock::now() - start);
+}
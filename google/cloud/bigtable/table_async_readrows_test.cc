@@ -0,0 +1,280 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace ::testing;
+using bigtable::testing::MockClientAsyncReaderInterface;
+using MockReader = MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+
+class TableAsyncReadRowsTest : public bigtable::testing::TableTestFixture {
+ protected:
+  TableAsyncReadRowsTest()
+      : impl_(std::make_shared<bigtable::testing::MockCompletionQueue>()),
+        cq_(impl_) {}
+
+  std::shared_ptr<bigtable::testing::MockCompletionQueue> impl_;
+  CompletionQueue cq_;
+};
+
+/// Return a `Read()` action that adds a single-cell row with @p row_key.
+std::function<void(btproto::ReadRowsResponse*, void*)> ReturnRow(
+    std::string row_key) {
+  return [row_key](btproto::ReadRowsResponse* r, void*) {
+    auto c = r->add_chunks();
+    c->set_row_key(row_key);
+    c->mutable_family_name()->set_value("fam");
+    c->mutable_qualifier()->set_value("col");
+    c->set_timestamp_micros(1000);
+    c->set_value("value-" + row_key);
+    c->set_commit_row(true);
+  };
+}
+
+/// @test Verify that Table::AsyncReadRows() delivers all the rows in order.
+TEST_F(TableAsyncReadRowsTest, Simple) {
+  auto reader = new MockReader;
+  std::unique_ptr<MockReader> reader_deleter(reader);
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void* tag) {
+        ReturnRow("r1")(r, tag);
+        ReturnRow("r2")(r, tag);
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> keys;
+  auto result = table_.AsyncReadRows(
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(true);
+      },
+      RowSet(), Filter::PassAllFilter(), cq_);
+
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read
+  impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  EXPECT_FALSE(result.is_ready());
+  impl_->SimulateCompletion(cq_, true);
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_THAT(keys, ElementsAre("r1", "r2"));
+}
+
+/// @test Verify that Table::AsyncReadRows() waits for the callback futures.
+TEST_F(TableAsyncReadRowsTest, FlowControl) {
+  auto reader = new MockReader;
+  std::unique_ptr<MockReader> reader_deleter(reader);
+  int read_count = 0;
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse* r, void* tag) {
+        ++read_count;
+        ReturnRow("r1")(r, tag);
+        ReturnRow("r2")(r, tag);
+      }))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse*, void*) {
+        ++read_count;
+      }));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> keys;
+  std::vector<promise<bool>> promises;
+  promises.reserve(2);
+  auto result = table_.AsyncReadRows(
+      [&keys, &promises](Row row) {
+        keys.push_back(row.row_key());
+        promises.emplace_back();
+        return promises.back().get_future();
+      },
+      RowSet(), Filter::PassAllFilter(), cq_);
+
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  EXPECT_EQ(1, read_count);
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read, the callback has not finished with "r1".
+  EXPECT_THAT(keys, ElementsAre("r1"));
+  EXPECT_EQ(1, read_count);
+
+  promises[0].set_value(true);
+  EXPECT_THAT(keys, ElementsAre("r1", "r2"));
+  EXPECT_EQ(1, read_count);
+
+  // Only when the application is done with the last row is more data read.
+  promises[1].set_value(true);
+  EXPECT_EQ(2, read_count);
+
+  impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  impl_->SimulateCompletion(cq_, true);
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_STATUS_OK(result.get());
+}
+
+/// @test Verify that Table::AsyncReadRows() stops when the callback says so.
+TEST_F(TableAsyncReadRowsTest, StopEarly) {
+  auto reader = new MockReader;
+  std::unique_ptr<MockReader> reader_deleter(reader);
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void* tag) {
+        ReturnRow("r1")(r, tag);
+        ReturnRow("r2")(r, tag);
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+      }));
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  std::vector<std::string> keys;
+  auto result = table_.AsyncReadRows(
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(false);
+      },
+      RowSet(), Filter::PassAllFilter(), cq_);
+
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read, the stream is cancelled.
+  impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  impl_->SimulateCompletion(cq_, true);
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_THAT(keys, ElementsAre("r1"));
+}
+
+/// @test Verify that Table::AsyncReadRows() retries after the last row.
+TEST_F(TableAsyncReadRowsTest, RetryAfterLastRow) {
+  auto reader1 = new MockReader;
+  std::unique_ptr<MockReader> reader_deleter1(reader1);
+  EXPECT_CALL(*reader1, Read(_, _))
+      .WillOnce(Invoke(ReturnRow("r1")))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader1, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+      }));
+
+  auto reader2 = new MockReader;
+  std::unique_ptr<MockReader> reader_deleter2(reader2);
+  EXPECT_CALL(*reader2, Read(_, _))
+      .WillOnce(Invoke(ReturnRow("r2")))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader2, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter1](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ("r0", r.rows().row_ranges(0).start_key_closed());
+        EXPECT_EQ(10, r.rows_limit());
+        return std::move(reader_deleter1);
+      }))
+      .WillOnce(Invoke([&reader_deleter2](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        // The second attempt only requests the rows not yet delivered.
+        EXPECT_EQ("r1", r.rows().row_ranges(0).start_key_open());
+        EXPECT_EQ(9, r.rows_limit());
+        return std::move(reader_deleter2);
+      }));
+
+  std::vector<std::string> keys;
+  auto result = table_.AsyncReadRows(
+      [&keys](Row row) {
+        keys.push_back(row.row_key());
+        return make_ready_future(true);
+      },
+      RowSet(RowRange::StartingAt("r0")), 10, Filter::PassAllFilter(), cq_);
+
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read
+  impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  impl_->SimulateCompletion(cq_, true);
+  // finished, scheduled timer
+  impl_->SimulateCompletion(cq_, true);
+  // timer finished, retry
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING
+  impl_->SimulateCompletion(cq_, true);
+  // state == PROCESSING, 1 read
+  impl_->SimulateCompletion(cq_, false);
+  // state == FINISHING
+  EXPECT_FALSE(result.is_ready());
+  impl_->SimulateCompletion(cq_, true);
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_THAT(keys, ElementsAre("r1", "r2"));
+}
+
+/// @test Verify that Table::AsyncReadRows() rejects negative row limits.
+TEST_F(TableAsyncReadRowsTest, NegativeRowsLimit) {
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _)).Times(0);
+  auto result = table_.AsyncReadRows(
+      [](Row) { return make_ready_future(true); }, RowSet(), -1,
+      Filter::PassAllFilter(), cq_);
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_EQ(StatusCode::kInvalidArgument, result.get().code());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
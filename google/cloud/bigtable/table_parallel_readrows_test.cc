@@ -0,0 +1,209 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = ::google::bigtable::v2;
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::Return;
+using testing::SetArgPointee;
+
+/// Define helper types and functions for this test.
+namespace {
+using bigtable::testing::MockReadRowsReader;
+using bigtable::testing::MockSampleRowKeysReader;
+
+class TableParallelReadRowsTest : public bigtable::testing::TableTestFixture {
+ protected:
+  /// Configure the SampleRowKeys() call to return a single split at "m".
+  void ExpectSampleRowKeys() {
+    auto reader = new MockSampleRowKeysReader;
+    EXPECT_CALL(*client_, SampleRowKeys(_, _))
+        .WillOnce(Invoke(reader->MakeMockReturner()));
+    EXPECT_CALL(*reader, Read(_))
+        .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+          r->set_row_key("m");
+          r->set_offset_bytes(1000);
+          return true;
+        }))
+        .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+          r->set_row_key("");
+          r->set_offset_bytes(2000);
+          return true;
+        }))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  /**
+   * Configure the ReadRows() calls to return the rows in each shard.
+   *
+   * The first shard returns OK, the second shard returns @p last_status.
+   */
+  void ExpectReadRows(grpc::Status last_status = grpc::Status::OK) {
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([last_status](
+                                   grpc::ClientContext*,
+                                   btproto::ReadRowsRequest const& request) {
+          EXPECT_EQ(1, request.rows().row_ranges_size());
+          if (request.rows().row_ranges(0).end_key_open() == "m") {
+            return MakeStream({"a", "b"}, grpc::Status::OK);
+          }
+          return MakeStream({"m", "x"}, last_status);
+        }));
+  }
+
+  static MockReadRowsReader::UniquePtr MakeStream(
+      std::vector<std::string> const& keys, grpc::Status const& status) {
+    auto stream = new MockReadRowsReader;
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(DoAll(SetArgPointee<0>(MakeResponse(keys)), Return(true)))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(status));
+    return stream->AsUniqueMocked();
+  }
+
+  static btproto::ReadRowsResponse MakeResponse(
+      std::vector<std::string> const& keys) {
+    btproto::ReadRowsResponse response;
+    for (auto const& key : keys) {
+      auto& chunk = *response.add_chunks();
+      chunk.set_row_key(key);
+      chunk.mutable_family_name()->set_value("fam");
+      chunk.mutable_qualifier()->set_value("col");
+      chunk.set_timestamp_micros(1000);
+      chunk.set_value("value-" + key);
+      chunk.set_commit_row(true);
+    }
+    return response;
+  }
+};
+}  // anonymous namespace
+
+/// @test Verify that ParallelReadRows() reads all the shards.
+TEST_F(TableParallelReadRowsTest, ReadsAllShards) {
+  ExpectSampleRowKeys();
+  ExpectReadRows();
+
+  std::mutex mu;
+  std::map<std::size_t, std::vector<std::string>> rows;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelScanOptions().SetMaxParallelism(2),
+      [&mu, &rows](std::size_t shard, bigtable::Row row) {
+        std::lock_guard<std::mutex> lk(mu);
+        rows[shard].push_back(row.row_key());
+        return true;
+      });
+  ASSERT_STATUS_OK(status);
+  ASSERT_EQ(2U, rows.size());
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), rows[0]);
+  EXPECT_EQ((std::vector<std::string>{"m", "x"}), rows[1]);
+}
+
+/// @test Verify that ParallelReadRows() works with read-ahead and one thread.
+TEST_F(TableParallelReadRowsTest, SingleThreadWithReadAhead) {
+  ExpectSampleRowKeys();
+  ExpectReadRows();
+
+  std::vector<std::string> keys;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelScanOptions().SetMaxParallelism(1).SetReadAhead(
+          4, 1024 * 1024),
+      [&keys](std::size_t, bigtable::Row row) {
+        keys.push_back(row.row_key());
+        return true;
+      });
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "m", "x"}), keys);
+}
+
+/// @test Verify that ParallelReadRows() reports errors in any shard.
+TEST_F(TableParallelReadRowsTest, ReportsShardErrors) {
+  ExpectSampleRowKeys();
+  ExpectReadRows(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh"));
+
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelScanOptions().SetMaxParallelism(1),
+      [](std::size_t, bigtable::Row) { return true; });
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+  EXPECT_EQ("uh-oh", status.message());
+}
+
+/// @test Verify that the callback can stop the scan.
+TEST_F(TableParallelReadRowsTest, CallbackStopsScan) {
+  ExpectSampleRowKeys();
+  auto stream = new MockReadRowsReader;
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(MakeResponse({"a", "b"})),
+                      Return(true)))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  std::vector<std::string> keys;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelScanOptions().SetMaxParallelism(1),
+      [&keys](std::size_t, bigtable::Row row) {
+        keys.push_back(row.row_key());
+        return false;
+      });
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ((std::vector<std::string>{"a"}), keys);
+}
+
+/// @test Verify that ParallelReadRows() reports SampleRows() errors.
+TEST_F(TableParallelReadRowsTest, ReportsSampleRowsErrors) {
+  auto reader = new MockSampleRowKeysReader;
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+  EXPECT_CALL(*client_, ReadRows(_, _)).Times(0);
+
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelScanOptions(),
+      [](std::size_t, bigtable::Row) { return true; });
+  EXPECT_FALSE(status.ok());
+}
+
+/// @test Verify the default parallelism follows the hardware threads.
+TEST(ParallelScanOptionsTest, DefaultMaxParallelism) {
+  auto const hc = std::thread::hardware_concurrency();
+  bigtable::ParallelScanOptions options;
+  if (hc == 0) {
+    EXPECT_EQ(4U, options.max_parallelism);
+  } else {
+    EXPECT_EQ(hc, options.max_parallelism);
+  }
+}
@@ -104,3 +104,11 @@ TEST_F(TableTest, ConstructorWithAppProfileAndPolicies) {
   EXPECT_EQ("test-profile-id", table.app_profile_id());
   EXPECT_THAT(table.table_name(), ::testing::HasSubstr("some-table"));
 }
+
+TEST_F(TableTest, BackgroundCompletionQueue) {
+  bigtable::Table table(client_, "some-table");
+  auto cq = table.background_completion_queue();
+  auto timer = cq.MakeRelativeTimer(std::chrono::milliseconds(2));
+  EXPECT_EQ(std::future_status::ready,
+            timer.wait_for(std::chrono::milliseconds(500)));
+}
@@ -17,7 +17,6 @@
 
 #include "google/cloud/internal/random.h"
 #include "google/cloud/internal/throw_delegate.h"
-#include "google/cloud/optional.h"
 #include <chrono>
 #include <memory>
 
@@ -144,7 +143,6 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
   std::chrono::microseconds current_delay_range_;
   std::chrono::microseconds maximum_delay_;
   double scaling_;
-  optional<DefaultPRNG> generator_;
 };
 
 }  // namespace internal
@@ -13,12 +13,15 @@
 // limitations under the License.
 
 #include "google/cloud/internal/random.h"
+#include <chrono>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
-std::string Sample(DefaultPRNG& gen, int n, std::string const& population) {
+namespace {
+template <typename Generator>
+std::string SampleImpl(Generator& gen, int n, std::string const& population) {
   std::uniform_int_distribution<std::size_t> rd(0, population.size() - 1);
 
   std::string result(std::size_t(n), '0');
@@ -26,6 +29,30 @@ std::string Sample(DefaultPRNG& gen, int n, std::string const& population) {
                 [&rd, &gen, &population]() { return population[rd(gen)]; });
   return result;
 }
+}  // namespace
+
+FastPRNG MakeFastPRNG() {
+  // A single value from `std::random_device` is the expensive part, the clock
+  // is mixed in so generators seeded with the same value still differ.
+  std::random_device rd;
+  auto const seed = static_cast<FastPRNG::result_type>(rd()) << 32U;
+  auto const now = static_cast<FastPRNG::result_type>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  return FastPRNG(seed ^ now);
+}
+
+FastPRNG& ThreadLocalFastPRNG() {
+  static thread_local FastPRNG generator = MakeFastPRNG();
+  return generator;
+}
+
+std::string Sample(DefaultPRNG& gen, int n, std::string const& population) {
+  return SampleImpl(gen, n, population);
+}
+
+std::string Sample(FastPRNG& gen, int n, std::string const& population) {
+  return SampleImpl(gen, n, population);
+}
 
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
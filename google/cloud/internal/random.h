@@ -17,7 +17,11 @@
 
 #include "google/cloud/version.h"
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -72,6 +76,52 @@ Generator MakePRNG() {
 /// Create a new PRNG.
 inline DefaultPRNG MakeDefaultPRNG() { return MakePRNG<DefaultPRNG>(); }
 
+/**
+ * A small and fast PRNG, to randomize backoff delays and similar values.
+ *
+ * This is the SplitMix64 generator, its state is a single 64-bit word. Seeding
+ * it takes one value from `std::random_device`, while seeding `DefaultPRNG`
+ * takes hundreds, and that is most of the cost of a short-lived generator.
+ * The numbers are good enough for jitter, applications that need long,
+ * statistically strong sequences should use `DefaultPRNG`.
+ *
+ * The class meets the requirements of a C++11 uniform random bit generator,
+ * it can be used with the distributions in `<random>`.
+ */
+class FastPRNG {
+ public:
+  using result_type = std::uint64_t;
+
+  explicit FastPRNG(result_type seed) : state_(seed) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    result_type z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+  }
+
+ private:
+  result_type state_;
+};
+
+/// Create a new FastPRNG, seeded with a single value from `std::random_device`.
+FastPRNG MakeFastPRNG();
+
+/**
+ * Return the FastPRNG of the calling thread.
+ *
+ * Each thread seeds its generator the first time it calls this function, after
+ * that the generator is used without any locking or system calls. The result
+ * must not be shared with other threads.
+ */
+FastPRNG& ThreadLocalFastPRNG();
+
 /**
  * Take @p n samples out of @p population, using the @p gen PRNG.
  *
@@ -80,6 +130,9 @@ inline DefaultPRNG MakeDefaultPRNG() { return MakePRNG<DefaultPRNG>(); }
  */
 std::string Sample(DefaultPRNG& gen, int n, std::string const& population);
 
+/// Take @p n samples out of @p population, using a FastPRNG.
+std::string Sample(FastPRNG& gen, int n, std::string const& population);
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
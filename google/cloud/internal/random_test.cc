@@ -14,6 +14,8 @@
 
 #include "google/cloud/internal/random.h"
 #include <gmock/gmock.h>
+#include <thread>
+#include <vector>
 
 using namespace google::cloud::internal;
 
@@ -29,3 +31,38 @@ TEST(BenchmarksRandom, Basic) {
   std::string s1 = gen_string();
   EXPECT_NE(s0, s1);
 }
+
+TEST(BenchmarksRandom, FastPRNG) {
+  // The same seed produces the same series, different seeds do not.
+  FastPRNG g0(42);
+  FastPRNG g1(42);
+  FastPRNG g2(43);
+  std::vector<FastPRNG::result_type> s0, s1, s2;
+  for (int i = 0; i != 16; ++i) {
+    s0.push_back(g0());
+    s1.push_back(g1());
+    s2.push_back(g2());
+  }
+  EXPECT_EQ(s0, s1);
+  EXPECT_NE(s0, s2);
+
+  auto f0 = MakeFastPRNG();
+  auto f1 = MakeFastPRNG();
+  EXPECT_NE(Sample(f0, 32, "0123456789abcdefghijklm"),
+            Sample(f1, 32, "0123456789abcdefghijklm"));
+}
+
+TEST(BenchmarksRandom, ThreadLocalFastPRNG) {
+  auto* local = &ThreadLocalFastPRNG();
+  EXPECT_EQ(local, &ThreadLocalFastPRNG());
+
+  FastPRNG* other = nullptr;
+  std::string other_sample;
+  std::thread t([&other, &other_sample] {
+    other = &ThreadLocalFastPRNG();
+    other_sample = Sample(*other, 32, "0123456789abcdefghijklm");
+  });
+  t.join();
+  EXPECT_NE(local, other);
+  EXPECT_NE(other_sample, Sample(*local, 32, "0123456789abcdefghijklm"));
+}
@@ -13,15 +13,27 @@
 // limitations under the License.
 
 #include "google/cloud/storage/client.h"
+#include "google/cloud/internal/big_endian.h"
 #include "google/cloud/internal/filesystem.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/crc32c_combine.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
+#include <crc32c/crc32c.h>
 #include <openssl/md5.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // _WIN32
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <fstream>
+#include <future>
 #include <thread>
 
 namespace google {
@@ -33,6 +45,191 @@ static_assert(std::is_copy_constructible<storage::Client>::value,
 static_assert(std::is_copy_assignable<storage::Client>::value,
               "storage::Client must be assignable");
 
+namespace {
+#ifndef _WIN32
+// Each slice of a parallel download runs in its own thread, requests for more
+// slices than this are capped.
+std::size_t constexpr kMaximumParallelDownloadSlices = 32;
+
+std::size_t ParallelDownloadSliceCount(std::size_t requested,
+                                       std::uint64_t object_size,
+                                       std::uint64_t minimum_slice_size) {
+  auto const max_slices = static_cast<std::size_t>(
+      object_size / (std::max)(std::uint64_t{1}, minimum_slice_size));
+  return (std::max)(std::size_t{1},
+                    (std::min)({requested, max_slices,
+                                kMaximumParallelDownloadSlices}));
+}
+
+/// Write all of [@p data, @p data + @p count) at @p offset in @p fd.
+Status WriteAt(int fd, char const* data, std::size_t count,
+               std::int64_t offset) {
+  while (count != 0) {
+    auto n = ::pwrite(fd, data, count, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status(StatusCode::kUnknown,
+                    "pwrite() failed, errno=" + std::to_string(errno));
+    }
+    data += n;
+    count -= static_cast<std::size_t>(n);
+    offset += n;
+  }
+  return Status();
+}
+
+/**
+ * Download the range in @p request to @p fd, return the CRC32C of the range.
+ *
+ * The slice stops early if @p cancelled becomes true, this happens when
+ * another slice has failed and the download cannot succeed.
+ */
+StatusOr<std::uint32_t> DownloadSlice(
+    std::shared_ptr<internal::RawClient> const& client,
+    internal::ReadObjectRangeRequest const& request, int fd,
+    std::size_t buffer_size, std::atomic<bool>& cancelled) {
+  auto const range = request.GetOption<ReadRange>().value();
+  auto streambuf = client->ReadObject(request);
+  if (!streambuf) {
+    cancelled = true;
+    return std::move(streambuf).status();
+  }
+  ObjectReadStream stream(*std::move(streambuf));
+
+  std::string buffer(buffer_size, '\0');
+  std::uint32_t crc = 0;
+  auto offset = range.begin;
+  while (stream.good() && !cancelled.load()) {
+    stream.read(&buffer[0], buffer.size());
+    auto count = static_cast<std::size_t>(stream.gcount());
+    crc = crc32c::Extend(
+        crc, reinterpret_cast<std::uint8_t const*>(buffer.data()), count);
+    auto status = WriteAt(fd, buffer.data(), count, offset);
+    if (!status.ok()) {
+      cancelled = true;
+      return status;
+    }
+    offset += count;
+  }
+  if (!stream.status().ok()) {
+    cancelled = true;
+    return stream.status();
+  }
+  if (offset != range.end) {
+    cancelled = true;
+    return Status(StatusCode::kAborted,
+                  "download slice ended early, expected " +
+                      std::to_string(range.end - range.begin) +
+                      " bytes, got " + std::to_string(offset - range.begin));
+  }
+  return crc;
+}
+#endif  // _WIN32
+
+/**
+ * Open @p file_name to upload its contents.
+ *
+ * Uploads read whole chunks at a time. With an unbuffered stream those reads
+ * go directly into the chunk buffer, instead of copying the data through the
+ * stream's own buffer.
+ */
+void OpenUploadSource(std::ifstream& source, std::string const& file_name) {
+  // Changing the buffer has no effect once the file is open.
+  source.rdbuf()->pubsetbuf(nullptr, 0);
+  source.open(file_name, std::ios::binary);
+}
+
+// The maximum number of source objects in a single `ComposeObject()` request.
+std::size_t constexpr kMaximumComposeSources = 32;
+
+// GCS limits the number of components in a composite object, requests for
+// more parts than this are capped.
+std::size_t constexpr kMaximumParallelUploadParts = 1024;
+
+// The parts of a parallel upload are uploaded by at most this many threads.
+std::size_t constexpr kMaximumParallelUploadThreads = 32;
+
+std::size_t ParallelUploadPartCount(std::size_t requested,
+                                    std::uint64_t source_size,
+                                    std::uint64_t minimum_part_size) {
+  auto const max_parts = static_cast<std::size_t>(
+      source_size / (std::max)(std::uint64_t{1}, minimum_part_size));
+  return (std::max)(std::size_t{1}, (std::min)({requested, max_parts,
+                                                kMaximumParallelUploadParts}));
+}
+
+/**
+ * Upload [@p offset, @p offset + @p size) from @p file_name to a new object.
+ *
+ * Return the CRC32C of the uploaded data. The part stops early if
+ * @p cancelled becomes true, this happens when another part has failed and
+ * the upload cannot succeed.
+ */
+StatusOr<std::uint32_t> UploadPart(
+    std::shared_ptr<internal::RawClient> const& client,
+    internal::ResumableUploadRequest const& request,
+    std::string const& file_name, std::uint64_t offset, std::uint64_t size,
+    std::size_t chunk_size, std::atomic<bool>& cancelled) {
+  auto cancel = [&cancelled](Status status) {
+    cancelled = true;
+    return status;
+  };
+  std::ifstream source;
+  OpenUploadSource(source, file_name);
+  if (!source.is_open()) {
+    return cancel(Status(StatusCode::kNotFound,
+                               "cannot open upload file source " + file_name));
+  }
+  auto session = client->CreateResumableSession(request);
+  if (!session) {
+    return cancel(std::move(session).status());
+  }
+
+  std::string buffer;
+  std::uint32_t crc = 0;
+  // The number of bytes included in `crc`, a chunk may need to be sent again
+  // if the service only commits part of it.
+  std::uint64_t crc_size = 0;
+  StatusOr<internal::ResumableUploadResponse> response(
+      internal::ResumableUploadResponse{});
+  while (response->payload.empty()) {
+    if (cancelled.load()) {
+      return Status(StatusCode::kCancelled, "another part failed to upload");
+    }
+    auto const next = (*session)->next_expected_byte();
+    if (next >= size) {
+      return cancel(
+          Status(StatusCode::kInternal,
+                 "upload completed without returning the object metadata"));
+    }
+    auto const count =
+        static_cast<std::size_t>((std::min)(std::uint64_t{chunk_size},
+                                            size - next));
+    buffer.resize(count);
+    source.seekg(static_cast<std::streamoff>(offset + next), std::ios::beg);
+    source.read(&buffer[0], static_cast<std::streamsize>(count));
+    if (static_cast<std::size_t>(source.gcount()) != count) {
+      return cancel(Status(StatusCode::kUnknown,
+                                 "short read from upload file source"));
+    }
+    if (next <= crc_size && crc_size < next + count) {
+      auto const skip = static_cast<std::size_t>(crc_size - next);
+      crc = crc32c::Extend(
+          crc, reinterpret_cast<std::uint8_t const*>(buffer.data()) + skip,
+          count - skip);
+      crc_size = next + count;
+    }
+    response = (*session)->UploadChunk(buffer, size);
+    if (!response) {
+      return cancel(std::move(response).status());
+    }
+  }
+  return crc;
+}
+}  // namespace
+
 std::shared_ptr<internal::RawClient> Client::CreateDefaultInternalClient(
     ClientOptions options) {
   return internal::CurlClient::Create(std::move(options));
@@ -84,7 +281,8 @@ bool Client::UseSimpleUpload(std::string const& file_name) const {
 
 StatusOr<ObjectMetadata> Client::UploadFileSimple(
     std::string const& file_name, internal::InsertObjectMediaRequest request) {
-  std::ifstream is(file_name);
+  std::ifstream is;
+  OpenUploadSource(is, file_name);
   if (!is.is_open()) {
     std::ostringstream os;
     os << __func__ << "(" << request << ", " << file_name
@@ -92,7 +290,13 @@ StatusOr<ObjectMetadata> Client::UploadFileSimple(
     return Status(StatusCode::kNotFound, std::move(os).str());
   }
 
-  std::string payload(std::istreambuf_iterator<char>{is}, {});
+  // `UseSimpleUpload()` has verified this is a (small) regular file, read it
+  // with a single call instead of growing the payload one byte at a time.
+  std::string payload(
+      static_cast<std::size_t>(google::cloud::internal::file_size(file_name)),
+      '\0');
+  is.read(&payload[0], static_cast<std::streamsize>(payload.size()));
+  payload.resize(static_cast<std::size_t>(is.gcount()));
   request.set_contents(std::move(payload));
 
   return raw_client_->InsertObjectMedia(request);
@@ -117,7 +321,8 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
 )""";
   }
 
-  std::ifstream source(file_name);
+  std::ifstream source;
+  OpenUploadSource(source, file_name);
   if (!source.is_open()) {
     std::ostringstream os;
     os << __func__ << "(" << request << ", " << file_name
@@ -128,6 +333,26 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
   // class checks before calling it.
   std::uint64_t source_size = google::cloud::internal::file_size(file_name);
 
+  auto const parallel = request.GetOption<ParallelUpload>();
+  auto const restore_session =
+      request.HasOption<UseResumableUploadSession>() &&
+      !request.GetOption<UseResumableUploadSession>().value().empty();
+  // `ComposeObject()` does not support these pre-conditions, and composite
+  // objects do not have an MD5 hash to validate.
+  auto const compose_compatible =
+      !request.HasOption<IfGenerationNotMatch>() &&
+      !request.HasOption<IfMetagenerationNotMatch>() &&
+      !request.HasOption<MD5HashValue>();
+  if (parallel.has_value() && parallel.value() > 1 && is_regular(status) &&
+      !restore_session && compose_compatible) {
+    auto const part_count = ParallelUploadPartCount(
+        parallel.value(), source_size,
+        raw_client()->client_options().parallel_upload_minimum_part_size());
+    if (part_count > 1) {
+      return UploadFileParallel(file_name, source_size, part_count, request);
+    }
+  }
+
   return UploadStreamResumable(source, source_size, request);
 }
 
@@ -148,11 +373,14 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
 
   StatusOr<internal::ResumableUploadResponse> upload_response(
       internal::ResumableUploadResponse{});
+  // Reuse the same buffer for all the chunks, the memory used by the upload
+  // does not grow with the size of the source.
+  std::string buffer;
   // We iterate while `source` is good and the retry policy has not been
   // exhausted.
   while (!source.eof() && upload_response && upload_response->payload.empty()) {
     // Read a chunk of data from the source file.
-    std::string buffer(chunk_size, '\0');
+    buffer.resize(chunk_size);
     source.read(&buffer[0], buffer.size());
     auto gcount = static_cast<std::size_t>(source.gcount());
     if (gcount < buffer.size()) {
@@ -180,8 +408,226 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
   return internal::ObjectMetadataParser::FromString(upload_response->payload);
 }
 
+StatusOr<ObjectMetadata> Client::UploadFileParallel(
+    std::string const& file_name, std::uint64_t source_size,
+    std::size_t part_count, internal::ResumableUploadRequest const& request) {
+  auto report_error = [&request, &file_name](char const* func,
+                                             char const* what,
+                                             Status const& status) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  // The temporary objects share a random prefix, so concurrent uploads to the
+  // same destination do not overwrite each other's parts.
+  auto const prefix =
+      request.object_name() + ".parallel-upload-" +
+      google::cloud::internal::Sample(
+          google::cloud::internal::ThreadLocalFastPRNG(), 16,
+          "abcdefghijklmnopqrstuvwxyz0123456789") +
+      ".";
+
+  // GCS requires chunks to be a multiple of 256KiB.
+  auto const chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
+      raw_client()->client_options().upload_buffer_size());
+  auto const part_size = (source_size + part_count - 1) / part_count;
+  std::vector<std::string> part_names;
+  std::vector<std::uint64_t> part_offsets;
+  std::vector<std::uint64_t> part_sizes;
+  for (std::uint64_t offset = 0; offset < source_size; offset += part_size) {
+    part_names.push_back(prefix + "part-" + std::to_string(part_names.size()));
+    part_offsets.push_back(offset);
+    part_sizes.push_back((std::min)(part_size, source_size - offset));
+  }
+
+  // A bounded pool of threads uploads the parts, each thread takes the next
+  // part until there are none left. Once a part fails the remaining parts are
+  // not started.
+  std::atomic<bool> cancelled(false);
+  std::atomic<std::size_t> next_part(0);
+  std::vector<StatusOr<std::uint32_t>> results(part_names.size());
+  std::vector<char> started(part_names.size(), 0);
+  auto upload_parts = [&] {
+    for (auto i = next_part++; i < part_names.size(); i = next_part++) {
+      if (cancelled.load()) {
+        results[i] = StatusOr<std::uint32_t>(
+            Status(StatusCode::kCancelled, "another part failed to upload"));
+        continue;
+      }
+      started[i] = 1;
+      // The parts must use the same encryption key as the destination, but
+      // the hashes and pre-conditions only apply to the destination object.
+      internal::ResumableUploadRequest part_request(request.bucket_name(),
+                                                    part_names[i]);
+      part_request.set_multiple_options(request.GetOption<EncryptionKey>(),
+                                        request.GetOption<UserProject>());
+      results[i] = UploadPart(raw_client_, part_request, file_name,
+                              part_offsets[i], part_sizes[i], chunk_size,
+                              cancelled);
+    }
+  };
+  std::vector<std::future<void>> workers;
+  auto const thread_count =
+      (std::min)(part_names.size(), kMaximumParallelUploadThreads);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    workers.push_back(std::async(std::launch::async, upload_parts));
+  }
+  // Wait for all the workers, even after a failure, so all the temporary
+  // objects are known before they are deleted.
+  for (auto& w : workers) {
+    w.get();
+  }
+
+  Status status;
+  std::uint32_t crc = 0;
+  std::vector<std::string> temporaries;
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    if (started[i] != 0) {
+      temporaries.push_back(part_names[i]);
+    }
+    if (!results[i]) {
+      // Prefer the error that caused the cancellation.
+      if (status.ok() || status.code() == StatusCode::kCancelled) {
+        status = std::move(results[i]).status();
+      }
+      continue;
+    }
+    crc = internal::Crc32cCombine(crc, *results[i], part_sizes[i]);
+  }
+  if (!status.ok()) {
+    DeleteParallelUploadParts(request, temporaries);
+    return report_error(__func__, "error uploading parts", status);
+  }
+
+  // Compose the parts in rounds, until the remaining sources fit in a single
+  // request for the destination object.
+  std::vector<std::string> sources = std::move(part_names);
+  for (int round = 0; sources.size() > kMaximumComposeSources; ++round) {
+    std::vector<std::string> composed;
+    for (std::size_t i = 0; i < sources.size(); i += kMaximumComposeSources) {
+      auto const end = (std::min)(sources.size(), i + kMaximumComposeSources);
+      std::vector<ComposeSourceObject> source_objects;
+      for (auto j = i; j != end; ++j) {
+        source_objects.push_back(ComposeSourceObject{sources[j], {}, {}});
+      }
+      composed.push_back(prefix + "compose-" + std::to_string(round) + "-" +
+                         std::to_string(composed.size()));
+      internal::ComposeObjectRequest compose_request(
+          request.bucket_name(), std::move(source_objects), composed.back());
+      compose_request.set_multiple_options(request.GetOption<EncryptionKey>(),
+                                           request.GetOption<UserProject>());
+      auto result = raw_client_->ComposeObject(compose_request);
+      if (!result) {
+        DeleteParallelUploadParts(request, temporaries);
+        return report_error(__func__, "error composing parts",
+                            std::move(result).status());
+      }
+      temporaries.push_back(composed.back());
+    }
+    sources = std::move(composed);
+  }
+
+  std::vector<ComposeSourceObject> source_objects;
+  for (auto& name : sources) {
+    source_objects.push_back(ComposeSourceObject{std::move(name), {}, {}});
+  }
+  // Composite objects do not inherit the metadata of their sources, the
+  // content type and encoding set for the upload must be copied explicitly.
+  ObjectMetadata destination;
+  if (request.HasOption<WithObjectMetadata>()) {
+    destination = request.GetOption<WithObjectMetadata>().value();
+  }
+  if (request.HasOption<ContentType>()) {
+    destination.set_content_type(request.GetOption<ContentType>().value());
+  }
+  if (request.HasOption<ContentEncoding>()) {
+    destination.set_content_encoding(
+        request.GetOption<ContentEncoding>().value());
+  }
+  internal::ComposeObjectRequest compose_request(
+      request.bucket_name(), std::move(source_objects), request.object_name());
+  compose_request.set_multiple_options(
+      request.GetOption<EncryptionKey>(), request.GetOption<KmsKeyName>(),
+      request.GetOption<IfGenerationMatch>(),
+      request.GetOption<IfMetagenerationMatch>(),
+      request.GetOption<UserProject>(),
+      WithObjectMetadata(std::move(destination)));
+  if (request.HasOption<PredefinedAcl>()) {
+    compose_request.set_option(
+        DestinationPredefinedAcl(request.GetOption<PredefinedAcl>().value()));
+  }
+  auto metadata = raw_client_->ComposeObject(compose_request);
+  DeleteParallelUploadParts(request, temporaries);
+  if (!metadata) {
+    return report_error(__func__, "error composing destination object",
+                        std::move(metadata).status());
+  }
+
+  if (request.HasOption<DisableCrc32cChecksum>() ||
+      metadata->crc32c().empty()) {
+    return metadata;
+  }
+  auto computed =
+      internal::Base64Encode(google::cloud::internal::EncodeBigEndian(crc));
+  auto expected = request.HasOption<Crc32cChecksumValue>()
+                      ? request.GetOption<Crc32cChecksumValue>().value()
+                      : computed;
+  if (computed != metadata->crc32c() || expected != metadata->crc32c()) {
+    return report_error(
+        __func__, "mismatched hashes in upload",
+        Status(StatusCode::kDataLoss, "expected=" + expected +
+                                          ", received=" + metadata->crc32c() +
+                                          ", computed=" + computed));
+  }
+  return metadata;
+}
+
+void Client::DeleteParallelUploadParts(
+    internal::ResumableUploadRequest const& request,
+    std::vector<std::string> const& object_names) {
+  for (auto const& name : object_names) {
+    internal::DeleteObjectRequest delete_request(request.bucket_name(), name);
+    delete_request.set_multiple_options(request.GetOption<UserProject>());
+    auto status = raw_client_->DeleteObject(delete_request).status();
+    // A part may not exist if its upload failed, there is nothing to clean up
+    // in that case.
+    if (!status.ok() && status.code() != StatusCode::kNotFound) {
+      GCP_LOG(WARNING) << "cannot delete temporary object " << name
+                       << " from parallel upload to " << request.object_name()
+                       << ": " << status;
+    }
+  }
+}
+
 Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                                 std::string const& file_name) {
+#ifndef _WIN32
+  auto const parallel = request.GetOption<ParallelDownload>();
+  if (parallel.has_value() && parallel.value() > 1 &&
+      !request.HasOption<ReadRange>() && !request.HasOption<ReadFromOffset>()) {
+    internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                        request.object_name());
+    metadata_request.set_multiple_options(
+        request.GetOption<Generation>(), request.GetOption<IfGenerationMatch>(),
+        request.GetOption<IfGenerationNotMatch>(),
+        request.GetOption<IfMetagenerationMatch>(),
+        request.GetOption<IfMetagenerationNotMatch>(),
+        request.GetOption<UserProject>());
+    auto metadata = raw_client_->GetObjectMetadata(metadata_request);
+    if (!metadata) {
+      return std::move(metadata).status();
+    }
+    auto const slice_count = ParallelDownloadSliceCount(
+        parallel.value(), metadata->size(),
+        raw_client_->client_options().parallel_download_minimum_slice_size());
+    if (slice_count > 1) {
+      return DownloadFileParallel(request, *metadata, slice_count, file_name);
+    }
+  }
+#endif  // _WIN32
+
   auto streambuf = raw_client_->ReadObject(request);
   if (!streambuf) {
     return streambuf.status();
@@ -227,6 +673,95 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   return Status();
 }
 
+#ifndef _WIN32
+Status Client::DownloadFileParallel(
+    internal::ReadObjectRangeRequest const& request,
+    ObjectMetadata const& metadata, std::size_t slice_count,
+    std::string const& file_name) {
+  auto report_error = [&request, file_name](char const* func, char const* what,
+                                            Status const& status) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  // Open the destination file and set its size, so each slice can write its
+  // data at the right offset as soon as it is received.
+  int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return report_error(__func__, "cannot open download destination file",
+                        Status(StatusCode::kInvalidArgument, "open()"));
+  }
+  auto const object_size = static_cast<std::int64_t>(metadata.size());
+  if (::ftruncate(fd, static_cast<off_t>(object_size)) != 0) {
+    ::close(fd);
+    return report_error(__func__,
+                        "cannot preallocate download destination file",
+                        Status(StatusCode::kUnknown, "ftruncate()"));
+  }
+
+  auto const buffer_size =
+      raw_client_->client_options().download_buffer_size();
+  auto const slice_size =
+      (object_size + static_cast<std::int64_t>(slice_count) - 1) /
+      static_cast<std::int64_t>(slice_count);
+  std::atomic<bool> cancelled(false);
+  std::vector<std::int64_t> slice_sizes;
+  std::vector<std::future<StatusOr<std::uint32_t>>> slices;
+  for (std::int64_t begin = 0; begin < object_size; begin += slice_size) {
+    auto const end = (std::min)(object_size, begin + slice_size);
+    // Pin all the slices to the generation returned by the metadata request,
+    // otherwise an object replaced during the download would be corrupted.
+    internal::ReadObjectRangeRequest slice_request = request;
+    slice_request.set_multiple_options(ReadRange(begin, end),
+                                       Generation(metadata.generation()));
+    slice_sizes.push_back(end - begin);
+    slices.push_back(std::async(std::launch::async, DownloadSlice, raw_client_,
+                                std::move(slice_request), fd, buffer_size,
+                                std::ref(cancelled)));
+  }
+
+  // Wait for all the slices, even after a failure, because they all write to
+  // `fd`. Combine the CRC32C values of the slices as they complete.
+  Status status;
+  std::uint32_t crc = 0;
+  for (std::size_t i = 0; i != slices.size(); ++i) {
+    auto slice = slices[i].get();
+    if (!slice) {
+      if (status.ok()) {
+        status = std::move(slice).status();
+      }
+      continue;
+    }
+    crc = internal::Crc32cCombine(crc, *slice,
+                                  static_cast<std::uint64_t>(slice_sizes[i]));
+  }
+  if (::close(fd) != 0 && status.ok()) {
+    return report_error(__func__, "cannot close download destination file",
+                        Status(StatusCode::kUnknown, "close()"));
+  }
+  if (!status.ok()) {
+    return report_error(__func__, "error reading download source object",
+                        status);
+  }
+
+  if (request.HasOption<DisableCrc32cChecksum>() ||
+      metadata.crc32c().empty()) {
+    return Status();
+  }
+  auto computed =
+      internal::Base64Encode(google::cloud::internal::EncodeBigEndian(crc));
+  if (computed != metadata.crc32c()) {
+    return report_error(
+        __func__, "mismatched hashes in download",
+        Status(StatusCode::kDataLoss, "expected=" + metadata.crc32c() +
+                                          ", computed=" + computed));
+  }
+  return Status();
+}
+#endif  // _WIN32
+
 std::string Client::SigningEmail(SigningAccount const& signing_account) {
   if (signing_account.has_value()) {
     return signing_account.value();
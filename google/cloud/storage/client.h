@@ -910,11 +910,18 @@ class Client {
    *     Valid types for this operation include `DisableCrc32cChecksum`,
    *     `DisableMD5Hash`, `IfGenerationMatch`, `EncryptionKey`, `Generation`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *     `IfMetagenerationNotMatch`, `ReadRange`, and `UserProject`.
+   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, and
+   *     `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
+   * @par Interrupted downloads
+   * If the download fails with a retryable error after some data was
+   * received, the library transparently starts a new download, pinned to the
+   * same object generation, from the first byte not yet returned. The retry
+   * policy of the client controls how many times the download is resumed.
+   *
    * @par Example
    * @snippet storage_object_samples.cc read object
    *
@@ -1016,13 +1023,20 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UserProject`, and
-   *   `WithObjectMetadata`.
+   *   `MD5HashValue`, `ParallelUpload`, `PredefinedAcl`, `Projection`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
    * case, `IfGenerationMatch`.
    *
+   * @par Parallel uploads
+   * With the `ParallelUpload` option large files are uploaded as several
+   * temporary objects, using multiple concurrent streams, and then composed
+   * into the destination object. This is useful for large files, where a
+   * single stream cannot saturate the network. Note that the destination is a
+   * composite object, which has no MD5 hash.
+   *
    * @par Example
    * @snippet storage_object_samples.cc upload file
    *
@@ -1055,11 +1069,19 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *   Valid types for this operation include `IfGenerationMatch`,
    *   `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *   `IfMetagenerationNotMatch`, `Generation`, `ReadRange`, and `UserProject`.
+   *   `IfMetagenerationNotMatch`, `Generation`, `ParallelDownload`,
+   *   `ReadFromOffset`, `ReadRange`, and `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
+   * @par Parallel downloads
+   * With the `ParallelDownload` option the object is downloaded using multiple
+   * concurrent streams, each one reading a different slice of the object. This
+   * is useful for large objects, where a single stream cannot saturate the
+   * network. This mode is not available on Windows, where the option is
+   * ignored.
+   *
    * @par Example
    * @snippet storage_object_samples.cc download file
    */
@@ -2876,9 +2898,25 @@ class Client {
       std::istream& source, std::uint64_t source_size,
       internal::ResumableUploadRequest const& request);
 
+  /// Upload @p file_name using @p part_count streams and compose the parts.
+  StatusOr<ObjectMetadata> UploadFileParallel(
+      std::string const& file_name, std::uint64_t source_size,
+      std::size_t part_count, internal::ResumableUploadRequest const& request);
+
+  /// Delete the temporary objects created by `UploadFileParallel()`.
+  void DeleteParallelUploadParts(
+      internal::ResumableUploadRequest const& request,
+      std::vector<std::string> const& object_names);
+
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
+  /// Download @p metadata to @p file_name using @p slice_count streams.
+  Status DownloadFileParallel(internal::ReadObjectRangeRequest const& request,
+                              ObjectMetadata const& metadata,
+                              std::size_t slice_count,
+                              std::string const& file_name);
+
   /// Determine the email used to sign a blob.
   std::string SigningEmail(SigningAccount const& signing_account);
 
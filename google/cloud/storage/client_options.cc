@@ -59,6 +59,14 @@ std::size_t DefaultConnectionPoolSize() {
   (5 * 1024 * 1024L)
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE
 
+// Parallel downloads and uploads avoid slices (or parts) smaller than this.
+// Very small slices spend more time setting up the transfer than transferring
+// data.
+#ifndef GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MINIMUM_SLICE_SIZE
+#define GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MINIMUM_SLICE_SIZE \
+  (16 * 1024 * 1024L)
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MINIMUM_SLICE_SIZE
+
 }  // namespace
 
 StatusOr<ClientOptions> ClientOptions::CreateDefaultClientOptions() {
@@ -80,7 +88,11 @@ ClientOptions::ClientOptions(std::shared_ptr<oauth2::Credentials> credentials)
       download_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_BUFFER_SIZE),
       upload_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_BUFFER_SIZE),
       maximum_simple_upload_size_(
-          GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE) {
+          GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE),
+      parallel_download_minimum_slice_size_(
+          GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MINIMUM_SLICE_SIZE),
+      parallel_upload_minimum_part_size_(
+          GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MINIMUM_SLICE_SIZE) {
   auto emulator =
       google::cloud::internal::GetEnv("CLOUD_STORAGE_TESTBENCH_ENDPOINT");
   if (emulator.has_value()) {
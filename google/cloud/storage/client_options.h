@@ -110,6 +110,21 @@ class ClientOptions {
   std::size_t upload_buffer_size() const { return upload_buffer_size_; }
   ClientOptions& SetUploadBufferSize(std::size_t size);
 
+  /**
+   * The memory budget for each resumable upload stream.
+   *
+   * If this is larger than `upload_buffer_size()` each chunk is uploaded in a
+   * background thread while the application fills the next chunk. Writing to
+   * the stream blocks when the chunks waiting to upload, plus the chunk being
+   * filled, use the full budget. The default, `0`, uploads each chunk from the
+   * application thread.
+   */
+  std::size_t upload_buffer_budget() const { return upload_buffer_budget_; }
+  ClientOptions& set_upload_buffer_budget(std::size_t v) {
+    upload_buffer_budget_ = v;
+    return *this;
+  }
+
   std::string const& user_agent_prefix() const { return user_agent_prefix_; }
   ClientOptions& add_user_agent_prefx(std::string const& v) {
     std::string prefix = v;
@@ -129,6 +144,35 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * The minimum size of each slice in a `ParallelDownload`.
+   *
+   * Downloads use fewer slices than requested when the slices would be smaller
+   * than this. Very small slices spend more time setting up the download than
+   * transferring data.
+   */
+  std::size_t parallel_download_minimum_slice_size() const {
+    return parallel_download_minimum_slice_size_;
+  }
+  ClientOptions& set_parallel_download_minimum_slice_size(std::size_t v) {
+    parallel_download_minimum_slice_size_ = v;
+    return *this;
+  }
+
+  /**
+   * The minimum size of each part in a `ParallelUpload`.
+   *
+   * Uploads use fewer parts than requested when the parts would be smaller
+   * than this.
+   */
+  std::size_t parallel_upload_minimum_part_size() const {
+    return parallel_upload_minimum_part_size_;
+  }
+  ClientOptions& set_parallel_upload_minimum_part_size(std::size_t v) {
+    parallel_upload_minimum_part_size_ = v;
+    return *this;
+  }
+
   /**
    * If true and using OpenSSL 1.0.2 the library configures the OpenSSL
    * callbacks for locking.
@@ -155,8 +199,11 @@ class ClientOptions {
   std::size_t connection_pool_size_;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
+  std::size_t upload_buffer_budget_ = 0;
   std::string user_agent_prefix_;
   std::size_t maximum_simple_upload_size_;
+  std::size_t parallel_download_minimum_slice_size_;
+  std::size_t parallel_upload_minimum_part_size_;
   bool enable_ssl_locking_callbacks_ = true;
 };
 }  // namespace STORAGE_CLIENT_NS
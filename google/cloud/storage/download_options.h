@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -48,6 +49,41 @@ inline std::ostream& operator<<(std::ostream& os, ReadRangeData const& rhs) {
             << "}";
 }
 
+/**
+ * Request the GCS object starting at the given offset in a ReadObject
+ * operation.
+ *
+ * The download includes all the data from the offset to the end of the
+ * object. This option is ignored if the request also includes a `ReadRange`.
+ */
+struct ReadFromOffset
+    : public internal::ComplexOption<ReadFromOffset, std::int64_t> {
+  using ComplexOption<ReadFromOffset, std::int64_t>::ComplexOption;
+  static char const* name() { return "read-offset"; }
+};
+
+/**
+ * Download an object to a file using multiple concurrent streams.
+ *
+ * When this option is used with `Client::DownloadToFile()` the library splits
+ * the object into (at most) the given number of slices, reads each slice with
+ * a separate `ReadObject()` request, and writes the slices directly to their
+ * offset in the destination file. All the slices are pinned to the generation
+ * of the object at the time the download starts. The CRC32C checksum of the
+ * full object is still validated, the MD5 hash is not.
+ *
+ * The option is ignored if the request also includes a `ReadRange` or a
+ * `ReadFromOffset`. The library uses fewer slices if the object is too small
+ * to make each slice at least `parallel_download_minimum_slice_size()` long
+ * (16 MiB by default, see `ClientOptions`), and never uses more than 32
+ * slices.
+ */
+struct ParallelDownload
+    : public internal::ComplexOption<ParallelDownload, std::size_t> {
+  using ComplexOption<ParallelDownload, std::size_t>::ComplexOption;
+  static char const* name() { return "parallel-download"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
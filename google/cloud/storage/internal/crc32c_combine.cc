@@ -0,0 +1,95 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include <array>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// The CRC32C (Castagnoli) polynomial, in the reflected bit order used by the
+// crc32c library and by GCS.
+std::uint32_t constexpr kCrc32cPolynomial = 0x82F63B78U;
+
+using Gf2Matrix = std::array<std::uint32_t, 32>;
+
+std::uint32_t Gf2MatrixTimes(Gf2Matrix const& matrix, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; vec != 0; ++i, vec >>= 1U) {
+    if ((vec & 1U) != 0) {
+      sum ^= matrix[i];
+    }
+  }
+  return sum;
+}
+
+Gf2Matrix Gf2MatrixSquare(Gf2Matrix const& matrix) {
+  Gf2Matrix square;
+  for (std::size_t i = 0; i != square.size(); ++i) {
+    square[i] = Gf2MatrixTimes(matrix, matrix[i]);
+  }
+  return square;
+}
+}  // namespace
+
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uint64_t size_b) {
+  // This is the algorithm used by zlib's `crc32_combine()`: appending `size_b`
+  // zero bytes to `A` is a linear operator on the CRC, which we compute by
+  // repeated squaring of the operator for a single zero bit. The pre- and
+  // post-conditioning of the CRC cancel out, so the result only needs to be
+  // xor-ed with `crc_b`.
+  if (size_b == 0) {
+    return crc_a;
+  }
+
+  // The operator for one zero bit.
+  Gf2Matrix odd;
+  odd[0] = kCrc32cPolynomial;
+  for (std::size_t i = 1; i != odd.size(); ++i) {
+    odd[i] = 1U << (i - 1);
+  }
+  // The operators for two and then four zero bits.
+  Gf2Matrix even = Gf2MatrixSquare(odd);
+  odd = Gf2MatrixSquare(even);
+
+  // Each iteration squares the operator, the first one yields the operator for
+  // a single zero byte.
+  do {
+    even = Gf2MatrixSquare(odd);
+    if ((size_b & 1U) != 0) {
+      crc_a = Gf2MatrixTimes(even, crc_a);
+    }
+    size_b >>= 1U;
+    if (size_b == 0) {
+      break;
+    }
+    odd = Gf2MatrixSquare(even);
+    if ((size_b & 1U) != 0) {
+      crc_a = Gf2MatrixTimes(odd, crc_a);
+    }
+    size_b >>= 1U;
+  } while (size_b != 0);
+
+  return crc_a ^ crc_b;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,65 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(Crc32cCombineTest, Empty) {
+  auto const crc = crc32c::Crc32c(std::string("The quick brown fox"));
+  EXPECT_EQ(crc, Crc32cCombine(crc, crc32c::Crc32c(std::string{}), 0));
+  EXPECT_EQ(crc, Crc32cCombine(0, crc, 19));
+}
+
+TEST(Crc32cCombineTest, Simple) {
+  std::string const a = "The quick brown fox jumps ";
+  std::string const b = "over the lazy dog";
+  auto const expected = crc32c::Crc32c(a + b);
+  auto const actual =
+      Crc32cCombine(crc32c::Crc32c(a), crc32c::Crc32c(b), b.size());
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(Crc32cCombineTest, ManySlices) {
+  std::string data;
+  for (int i = 0; i != 100000; ++i) {
+    data.push_back(static_cast<char>('a' + i % 26));
+    if (i % 7 == 0) data.push_back(static_cast<char>(i % 251));
+  }
+  auto const expected = crc32c::Crc32c(data);
+
+  for (std::size_t slice_size : {1U, 3U, 4096U, 65537U}) {
+    SCOPED_TRACE("Testing with slice_size=" + std::to_string(slice_size));
+    std::uint32_t actual = 0;
+    for (std::size_t offset = 0; offset < data.size(); offset += slice_size) {
+      auto slice = data.substr(offset, slice_size);
+      actual = Crc32cCombine(actual, crc32c::Crc32c(slice), slice.size());
+    }
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
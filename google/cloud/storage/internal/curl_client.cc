@@ -15,11 +15,13 @@
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/curl_resumable_streambuf.h"
 #include "google/cloud/storage/internal/curl_resumable_upload_session.h"
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
+#include "google/cloud/storage/internal/pipelined_resumable_streambuf.h"
 #include "google/cloud/storage/object_stream.h"
 
 namespace google {
@@ -49,37 +51,28 @@ std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
       options.connection_pool_size());
 }
 
-std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
-                                                   bool disable_crc32c) {
-  if (disable_md5 && disable_crc32c) {
-    return google::cloud::internal::make_unique<NullHashValidator>();
-  }
-  if (disable_md5) {
-    return google::cloud::internal::make_unique<Crc32cHashValidator>();
-  }
-  if (disable_crc32c) {
-    return google::cloud::internal::make_unique<MD5HashValidator>();
-  }
-  return google::cloud::internal::make_unique<CompositeValidator>(
-      google::cloud::internal::make_unique<Crc32cHashValidator>(),
-      google::cloud::internal::make_unique<MD5HashValidator>());
-}
-
-/// Create a HashValidator for a download request.
-std::unique_ptr<HashValidator> CreateHashValidator(
-    ReadObjectRangeRequest const& request) {
+/// Add the headers to download a portion of an object, if needed.
+void AddRangeHeaders(CurlRequestBuilder& builder,
+                     ReadObjectRangeRequest const& request) {
+  std::string header;
   if (request.HasOption<ReadRange>()) {
-    return google::cloud::internal::make_unique<NullHashValidator>();
+    auto range = request.GetOption<ReadRange>().value();
+    header = "Range: bytes=" + std::to_string(range.begin) + "-" +
+             std::to_string(range.end - 1);
+  } else if (request.HasOption<ReadFromOffset>() &&
+             request.GetOption<ReadFromOffset>().value() != 0) {
+    header = "Range: bytes=" +
+             std::to_string(request.GetOption<ReadFromOffset>().value()) + "-";
+  } else {
+    return;
   }
-  return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
-}
-
-/// Create a HashValidator for an upload request.
-std::unique_ptr<HashValidator> CreateHashValidator(
-    InsertObjectStreamingRequest const& request) {
-  return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
+  builder.AddHeader(header);
+  // When doing a range read we need to disable decompression because range
+  // reads do not work in that case:
+  //   https://cloud.google.com/storage/docs/transcoding#range
+  // and
+  //   https://cloud.google.com/storage/docs/transcoding#decompressive_transcoding
+  builder.AddHeader("Cache-Control: no-transform");
 }
 
 std::string XmlMapPredefinedAcl(std::string const& acl) {
@@ -287,7 +280,6 @@ CurlClient::CreateResumableSessionGeneric(RequestType const& request) {
 CurlClient::CurlClient(ClientOptions options)
     : options_(std::move(options)),
       share_(curl_share_init(), &curl_share_cleanup),
-      generator_(google::cloud::internal::MakeDefaultPRNG()),
       storage_factory_(CreateHandleFactory(options_)),
       upload_factory_(CreateHandleFactory(options_)),
       xml_upload_factory_(CreateHandleFactory(options_)),
@@ -595,18 +587,7 @@ StatusOr<std::unique_ptr<ObjectReadStreambuf>> CurlClient::ReadObject(
     return status;
   }
   builder.AddQueryParameter("alt", "media");
-  if (request.HasOption<ReadRange>()) {
-    auto range = request.GetOption<ReadRange>().value();
-    std::string header = "Range: bytes=" + std::to_string(range.begin) + "-" +
-                         std::to_string(range.end - 1);
-    builder.AddHeader(header);
-    // When doing a range read we need to disable decompression because range
-    // reads do not work in that case:
-    //   https://cloud.google.com/storage/docs/transcoding#range
-    // and
-    //   https://cloud.google.com/storage/docs/transcoding#decompressive_transcoding
-    builder.AddHeader("Cache-Control: no-transform");
-  }
+  AddRangeHeaders(builder, request);
 
   std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
       builder.BuildDownloadRequest(std::string{}),
@@ -1326,18 +1307,7 @@ StatusOr<std::unique_ptr<ObjectReadStreambuf>> CurlClient::ReadObjectXml(
   // QuotaUser cannot be set, checked by the caller.
   // UserIp cannot be set, checked by the caller.
 
-  if (request.HasOption<ReadRange>()) {
-    auto range = request.GetOption<ReadRange>().value();
-    std::string header = "Range: bytes=" + std::to_string(range.begin) + "-" +
-                         std::to_string(range.end - 1);
-    builder.AddHeader(header);
-    // When doing a range read we need to disable decompression because range
-    // reads do not work in that case:
-    //   https://cloud.google.com/storage/docs/transcoding#range
-    // and
-    //   https://cloud.google.com/storage/docs/transcoding#decompressive_transcoding
-    builder.AddHeader("Cache-Control: no-transform");
-  }
+  AddRangeHeaders(builder, request);
 
   std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
       builder.BuildDownloadRequest(std::string{}),
@@ -1427,11 +1397,11 @@ std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
   // the candidate.  Eventually we will find something, though it might be
   // larger than `text_to_avoid`.  And we only make (approximately) one pass
   // over `text_to_avoid`.
-  auto generate_candidate = [this](int n) {
+  auto generate_candidate = [](int n) {
     static std::string const chars =
         "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    std::unique_lock<std::mutex> lk(mu_);
-    return google::cloud::internal::Sample(generator_, n, chars);
+    return google::cloud::internal::Sample(
+        google::cloud::internal::ThreadLocalFastPRNG(), n, chars);
   };
   constexpr int INITIAL_CANDIDATE_SIZE = 16;
   constexpr int CANDIDATE_GROWTH_SIZE = 4;
@@ -1467,6 +1437,14 @@ CurlClient::WriteObjectResumable(InsertObjectStreamingRequest const& request) {
     return std::move(session).status();
   }
 
+  if (client_options().upload_buffer_budget() >
+      client_options().upload_buffer_size()) {
+    auto buf = google::cloud::internal::make_unique<
+        internal::PipelinedResumableStreambuf>(
+        std::move(session).value(), client_options().upload_buffer_size(),
+        client_options().upload_buffer_budget(), CreateHashValidator(request));
+    return std::unique_ptr<internal::ObjectWriteStreambuf>(std::move(buf));
+  }
   auto buf =
       google::cloud::internal::make_unique<internal::CurlResumableStreambuf>(
           std::move(session).value(), client_options().upload_buffer_size(),
@@ -27,6 +27,9 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 class ObjectMetadata;
 namespace internal {
+class InsertObjectStreamingRequest;
+class ReadObjectRangeRequest;
+
 /**
  * Defines the interface to check hash values during uploads and downloads.
  */
@@ -144,6 +147,18 @@ class Crc32cHashValidator : public HashValidator {
   std::string received_hash_;
 };
 
+/// Create a HashValidator, disabling the requested hashes.
+std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
+                                                   bool disable_crc32c);
+
+/// Create a HashValidator for a download request.
+std::unique_ptr<HashValidator> CreateHashValidator(
+    ReadObjectRangeRequest const& request);
+
+/// Create a HashValidator for an upload request.
+std::unique_ptr<HashValidator> CreateHashValidator(
+    InsertObjectStreamingRequest const& request);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -113,8 +113,8 @@ class InsertObjectMediaRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UserProject,
-          WithObjectMetadata> {
+          MD5HashValue, ParallelUpload, PredefinedAcl, Projection,
+          UserProject, WithObjectMetadata> {
  public:
   InsertObjectMediaRequest() : GenericObjectRequest(), contents_() {}
 
@@ -150,8 +150,8 @@ class InsertObjectStreamingRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, WithObjectMetadata> {
+          MD5HashValue, ParallelUpload, PredefinedAcl, Projection,
+          UseResumableUploadSession, UserProject, WithObjectMetadata> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -201,8 +201,8 @@ class ReadObjectRangeRequest
     : public GenericObjectRequest<
           ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadRange,
-          UserProject> {
+          IfMetagenerationMatch, IfMetagenerationNotMatch, ParallelDownload,
+          ReadFromOffset, ReadRange, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -378,8 +378,8 @@ class ResumableUploadRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, WithObjectMetadata> {
+          MD5HashValue, ParallelUpload, PredefinedAcl, Projection,
+          UseResumableUploadSession, UserProject, WithObjectMetadata> {
  public:
   ResumableUploadRequest() = default;
 
@@ -0,0 +1,261 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_streambuf.h"
+#include "google/cloud/log.h"
+#include <algorithm>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+PipelinedResumableStreambuf::PipelinedResumableStreambuf(
+    std::unique_ptr<ResumableUploadSession> upload_session,
+    std::size_t max_buffer_size, std::size_t buffer_budget,
+    std::unique_ptr<HashValidator> hash_validator)
+    : upload_session_(std::move(upload_session)),
+      max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
+      buffer_budget_((std::max)(buffer_budget, 2 * max_buffer_size_)),
+      current_offset_(upload_session_->next_expected_byte()),
+      session_id_(upload_session_->session_id()),
+      next_expected_byte_(current_offset_),
+      hash_validator_(std::move(hash_validator)),
+      last_response_{400},
+      committed_session_id_(session_id_),
+      committed_byte_(current_offset_) {
+  current_ios_buffer_.resize(max_buffer_size_);
+  char* data = &current_ios_buffer_[0];
+  setp(data, data + current_ios_buffer_.size());
+}
+
+PipelinedResumableStreambuf::~PipelinedResumableStreambuf() { Shutdown(); }
+
+bool PipelinedResumableStreambuf::IsOpen() const { return is_open_; }
+
+bool PipelinedResumableStreambuf::ValidateHash(ObjectMetadata const& meta) {
+  hash_validator_->ProcessMetadata(meta);
+  hash_validator_result_ = std::move(*hash_validator_).Finish();
+  return !hash_validator_result_.is_mismatch;
+}
+
+PipelinedResumableStreambuf::int_type PipelinedResumableStreambuf::overflow(
+    int_type ch) {
+  if (!IsOpen()) {
+    return traits_type::eof();
+  }
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return Poll().ok() ? 0 : traits_type::eof();
+  }
+  // Only upload full chunks once more data arrives, that guarantees the final
+  // chunk is never empty.
+  if (pptr() == epptr()) {
+    auto status = HandOff(0);
+    if (!status.ok()) {
+      return traits_type::eof();
+    }
+  }
+  *pptr() = traits_type::to_char_type(ch);
+  pbump(1);
+  return 0;
+}
+
+int PipelinedResumableStreambuf::sync() {
+  auto status = Poll();
+  if (!status.ok()) {
+    return traits_type::eof();
+  }
+  return 0;
+}
+
+std::streamsize PipelinedResumableStreambuf::xsputn(char const* s,
+                                                    std::streamsize count) {
+  if (!IsOpen()) {
+    return traits_type::eof();
+  }
+  std::streamsize written = 0;
+  while (written < count) {
+    if (pptr() == epptr()) {
+      auto status = HandOff(0);
+      if (!status.ok()) {
+        return written;
+      }
+    }
+    auto const n = (std::min)(count - written,
+                              static_cast<std::streamsize>(epptr() - pptr()));
+    std::copy(s + written, s + written + n, pptr());
+    pbump(static_cast<int>(n));
+    written += n;
+  }
+  return count;
+}
+
+StatusOr<HttpResponse> PipelinedResumableStreambuf::DoClose() {
+  GCP_LOG(INFO) << __func__ << "()";
+  if (!IsOpen()) {
+    return last_response_;
+  }
+  auto const actual_size = static_cast<std::uint64_t>(pptr() - pbase());
+  if (actual_size == 0) {
+    return last_response_;
+  }
+  is_open_ = false;
+  auto status = HandOff(current_offset_ + actual_size);
+  if (status.ok()) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return !upload_status_.ok() || pending_.empty(); });
+    status = upload_status_;
+    next_expected_byte_ = committed_byte_;
+    session_id_ = committed_session_id_;
+  }
+  Shutdown();
+  if (!status.ok()) {
+    return status;
+  }
+  last_response_ = HttpResponse{200, std::move(final_payload_), {}};
+  return last_response_;
+}
+
+Status PipelinedResumableStreambuf::HandOff(std::uint64_t upload_size) {
+  auto const size = static_cast<std::size_t>(pptr() - pbase());
+  current_ios_buffer_.resize(size);
+  hash_validator_->Update(current_ios_buffer_);
+
+  std::unique_lock<std::mutex> lk(mu_);
+  // Block until the chunk, and the buffer for the next chunk, fit in the
+  // budget. There is always room for at least one chunk in flight.
+  cv_.wait(lk, [this, size] {
+    return !upload_status_.ok() || pending_.empty() ||
+           pending_bytes_ + size + max_buffer_size_ <= buffer_budget_;
+  });
+  if (!upload_status_.ok()) {
+    return upload_status_;
+  }
+  pending_.push_back(
+      Chunk{std::move(current_ios_buffer_), current_offset_, upload_size});
+  pending_bytes_ += size;
+  current_offset_ += size;
+  next_expected_byte_ = committed_byte_;
+  session_id_ = committed_session_id_;
+  current_ios_buffer_.clear();
+  if (upload_size == 0 && !free_buffers_.empty()) {
+    current_ios_buffer_ = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+  }
+  lk.unlock();
+  cv_.notify_all();
+
+  if (!uploader_.joinable()) {
+    uploader_ = std::thread(&PipelinedResumableStreambuf::UploadLoop, this);
+  }
+  if (upload_size != 0) {
+    // This was the final chunk, there is no need for a new buffer.
+    setp(nullptr, nullptr);
+    return Status();
+  }
+  current_ios_buffer_.resize(max_buffer_size_);
+  char* data = &current_ios_buffer_[0];
+  setp(data, data + current_ios_buffer_.size());
+  return Status();
+}
+
+Status PipelinedResumableStreambuf::Poll() {
+  std::lock_guard<std::mutex> lk(mu_);
+  next_expected_byte_ = committed_byte_;
+  session_id_ = committed_session_id_;
+  return upload_status_;
+}
+
+void PipelinedResumableStreambuf::UploadLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (shutdown_) {
+      return;
+    }
+    // Only this thread removes elements from `pending_`, and adding elements
+    // at the end of a deque does not invalidate references to the others.
+    Chunk& chunk = pending_.front();
+    lk.unlock();
+    auto result = UploadChunk(chunk);
+    auto const next_expected_byte = upload_session_->next_expected_byte();
+    auto session_id = upload_session_->session_id();
+    lk.lock();
+    if (!result.ok()) {
+      upload_status_ = std::move(result).status();
+      pending_.clear();
+      pending_bytes_ = 0;
+      cv_.notify_all();
+      return;
+    }
+    committed_byte_ = next_expected_byte;
+    committed_session_id_ = std::move(session_id);
+    if (chunk.upload_size != 0) {
+      final_payload_ = std::move(result).value().payload;
+    }
+    pending_bytes_ -= chunk.data.size();
+    free_buffers_.push_back(std::move(chunk.data));
+    pending_.pop_front();
+    cv_.notify_all();
+  }
+}
+
+void PipelinedResumableStreambuf::Shutdown() {
+  if (!uploader_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  uploader_.join();
+}
+
+StatusOr<ResumableUploadResponse> PipelinedResumableStreambuf::UploadChunk(
+    Chunk const& chunk) {
+  auto const end = chunk.offset + chunk.data.size();
+  auto begin = chunk.offset;
+  auto result = upload_session_->UploadChunk(chunk.data, chunk.upload_size);
+  for (;;) {
+    // The service returns the object metadata once the upload completes.
+    if (!result.ok() || !result->payload.empty()) {
+      return result;
+    }
+    auto const next_expected_byte = upload_session_->next_expected_byte();
+    if (next_expected_byte >= end) {
+      return result;
+    }
+    if (next_expected_byte <= begin) {
+      std::ostringstream os;
+      os << __func__ << "() - the service did not commit any data in chunk ["
+         << begin << ", " << end
+         << "), next_expected_byte=" << next_expected_byte;
+      return Status(StatusCode::kInternal, std::move(os).str());
+    }
+    // The service committed only part of the chunk, send the rest again.
+    begin = next_expected_byte;
+    result = upload_session_->UploadChunk(
+        chunk.data.substr(static_cast<std::size_t>(begin - chunk.offset)),
+        chunk.upload_size);
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,138 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_STREAMBUF_H_
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+class ObjectMetadata;
+namespace internal {
+/**
+ * Implement resumable uploads overlapping the upload with the application.
+ *
+ * Each full chunk is handed to a background thread, which uploads it while
+ * the application fills the next chunk. At most `buffer_budget` bytes are
+ * used for chunks, including the one being filled. When all the budget is in
+ * use, writing to the stream blocks until a chunk completes. The budget is
+ * rounded up to at least two chunks.
+ *
+ * If the service commits only part of a chunk, the rest of the chunk is sent
+ * again before any later chunk. Errors are reported on the next write, or
+ * when the stream is closed.
+ */
+class PipelinedResumableStreambuf : public ObjectWriteStreambuf {
+ public:
+  PipelinedResumableStreambuf(
+      std::unique_ptr<ResumableUploadSession> upload_session,
+      std::size_t max_buffer_size, std::size_t buffer_budget,
+      std::unique_ptr<HashValidator> hash_validator);
+
+  ~PipelinedResumableStreambuf() override;
+
+  bool IsOpen() const override;
+  bool ValidateHash(ObjectMetadata const& meta) override;
+  std::string const& received_hash() const override {
+    return hash_validator_result_.received;
+  }
+  std::string const& computed_hash() const override {
+    return hash_validator_result_.computed;
+  }
+  std::string const& resumable_session_id() const override {
+    return session_id_;
+  }
+  std::uint64_t next_expected_byte() const override {
+    return next_expected_byte_;
+  }
+
+ protected:
+  int sync() override;
+  std::streamsize xsputn(char const* s, std::streamsize count) override;
+  int_type overflow(int_type ch) override;
+  StatusOr<HttpResponse> DoClose() override;
+
+ private:
+  struct Chunk {
+    std::string data;
+    std::uint64_t offset;
+    std::uint64_t upload_size;
+  };
+
+  /// Queue the iostream buffer for upload, blocking if the budget is used.
+  Status HandOff(std::uint64_t upload_size);
+
+  /// Refresh the session state visible to the application.
+  Status Poll();
+
+  /// The body of the background thread.
+  void UploadLoop();
+
+  /// Stop the background thread, abandoning any chunks not yet uploaded.
+  void Shutdown();
+
+  /// Upload @p chunk, sending again any part not committed by the service.
+  StatusOr<ResumableUploadResponse> UploadChunk(Chunk const& chunk);
+
+  std::unique_ptr<ResumableUploadSession> upload_session_;
+  std::size_t max_buffer_size_;
+  std::size_t buffer_budget_;
+
+  // These are only used by the application thread.
+  std::string current_ios_buffer_;
+  std::uint64_t current_offset_;
+  std::string session_id_;
+  std::uint64_t next_expected_byte_;
+  bool is_open_ = true;
+
+  std::unique_ptr<HashValidator> hash_validator_;
+  HashValidator::Result hash_validator_result_;
+
+  HttpResponse last_response_;
+
+  // These are shared with the background thread, protected by `mu_`.
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Chunk> pending_;
+  std::size_t pending_bytes_ = 0;
+  std::vector<std::string> free_buffers_;
+  Status upload_status_;
+  std::string committed_session_id_;
+  std::uint64_t committed_byte_;
+  std::string final_payload_;
+  bool shutdown_ = false;
+
+  std::thread uploader_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_STREAMBUF_H_
@@ -0,0 +1,211 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_streambuf.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <future>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+
+auto const kQuantum = UploadChunkRequest::kChunkSizeQuantum;
+
+class PipelinedResumableStreambufTest : public ::testing::Test {
+ protected:
+  PipelinedResumableStreambufTest()
+      : mock_(google::cloud::internal::make_unique<
+              testing::MockResumableUploadSession>()) {
+    EXPECT_CALL(*mock_, session_id()).WillRepeatedly(ReturnRef(session_id_));
+    EXPECT_CALL(*mock_, next_expected_byte()).WillRepeatedly(Invoke([this] {
+      return next_expected_byte_;
+    }));
+  }
+
+  std::unique_ptr<PipelinedResumableStreambuf> MakeTested(
+      std::size_t buffer_budget) {
+    return google::cloud::internal::make_unique<PipelinedResumableStreambuf>(
+        std::move(mock_), kQuantum, buffer_budget,
+        CreateHashValidator(true, true));
+  }
+
+  std::string session_id_ = "test-session-id";
+  // Only changed by the mock `UploadChunk()`, which runs in the uploader
+  // thread, and read by the mock `next_expected_byte()`.
+  std::uint64_t next_expected_byte_ = 0;
+  std::unique_ptr<testing::MockResumableUploadSession> mock_;
+};
+
+/// @test Verify that chunks are uploaded in order, with the final size.
+TEST_F(PipelinedResumableStreambufTest, UploadsChunks) {
+  std::string const payload = std::string(kQuantum, 'a') +
+                              std::string(kQuantum, 'b') +
+                              std::string(kQuantum / 2, 'c');
+
+  EXPECT_CALL(*mock_, UploadChunk(_, _))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        EXPECT_EQ(payload.substr(0, kQuantum), p);
+        EXPECT_EQ(0U, s);
+        next_expected_byte_ = kQuantum;
+        return make_status_or(ResumableUploadResponse{"", kQuantum - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        EXPECT_EQ(payload.substr(kQuantum, kQuantum), p);
+        EXPECT_EQ(0U, s);
+        next_expected_byte_ = 2 * kQuantum;
+        return make_status_or(
+            ResumableUploadResponse{"", 2 * kQuantum - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        EXPECT_EQ(payload.substr(2 * kQuantum), p);
+        EXPECT_EQ(payload.size(), s);
+        return make_status_or(ResumableUploadResponse{"", 0, "{}"});
+      }));
+
+  auto tested = MakeTested(4 * kQuantum);
+  // Write in pieces that do not align with the chunks.
+  for (std::size_t i = 0; i < payload.size(); i += 1000) {
+    auto const n = (std::min)(std::size_t{1000}, payload.size() - i);
+    EXPECT_EQ(static_cast<std::streamsize>(n),
+              tested->sputn(payload.data() + i, n));
+  }
+
+  auto response = tested->Close();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(200, response->status_code);
+  EXPECT_EQ("{}", response->payload);
+  EXPECT_FALSE(tested->IsOpen());
+  EXPECT_EQ(session_id_, tested->resumable_session_id());
+}
+
+/// @test Verify that writes block once the budget is used.
+TEST_F(PipelinedResumableStreambufTest, Backpressure) {
+  std::promise<void> release;
+  auto released = release.get_future().share();
+
+  EXPECT_CALL(*mock_, UploadChunk(_, _))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t) {
+        released.wait();
+        EXPECT_EQ(std::string(kQuantum, 'a'), p);
+        next_expected_byte_ = kQuantum;
+        return make_status_or(ResumableUploadResponse{"", kQuantum - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t) {
+        EXPECT_EQ(std::string(kQuantum, 'b'), p);
+        next_expected_byte_ = 2 * kQuantum;
+        return make_status_or(
+            ResumableUploadResponse{"", 2 * kQuantum - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        EXPECT_EQ("c", p);
+        EXPECT_EQ(2 * kQuantum + 1, s);
+        return make_status_or(ResumableUploadResponse{"", 0, "{}"});
+      }));
+
+  auto tested = MakeTested(2 * kQuantum);
+  // The first chunk is uploaded in the background while the second is filled.
+  std::string const a(kQuantum, 'a');
+  std::string const b(kQuantum, 'b');
+  EXPECT_EQ(static_cast<std::streamsize>(a.size()),
+            tested->sputn(a.data(), a.size()));
+  EXPECT_EQ(static_cast<std::streamsize>(b.size()),
+            tested->sputn(b.data(), b.size()));
+
+  // Handing off the second chunk must wait for the first one.
+  auto writer = std::async(std::launch::async, [&tested] {
+    return tested->sputc('c');
+  });
+  EXPECT_EQ(std::future_status::timeout,
+            writer.wait_for(std::chrono::milliseconds(50)));
+  release.set_value();
+  EXPECT_EQ(0, writer.get());
+
+  auto response = tested->Close();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ("{}", response->payload);
+}
+
+/// @test Verify that partially committed chunks are completed.
+TEST_F(PipelinedResumableStreambufTest, PartialCommit) {
+  std::string const payload =
+      std::string(kQuantum, 'a') + std::string(kQuantum, 'b') + "c";
+
+  EXPECT_CALL(*mock_, UploadChunk(_, _))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t) {
+        EXPECT_EQ(payload.substr(0, 2 * kQuantum), p);
+        next_expected_byte_ = kQuantum / 2;
+        return make_status_or(
+            ResumableUploadResponse{"", kQuantum / 2 - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t) {
+        EXPECT_EQ(payload.substr(kQuantum / 2, 3 * kQuantum / 2), p);
+        next_expected_byte_ = 2 * kQuantum;
+        return make_status_or(
+            ResumableUploadResponse{"", 2 * kQuantum - 1, ""});
+      }))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        EXPECT_EQ("c", p);
+        EXPECT_EQ(payload.size(), s);
+        return make_status_or(ResumableUploadResponse{"", 0, "{}"});
+      }));
+
+  // Use larger chunks for this test, to commit a fraction of one.
+  auto tested = google::cloud::internal::make_unique<
+      PipelinedResumableStreambuf>(std::move(mock_), 2 * kQuantum,
+                                   4 * kQuantum,
+                                   CreateHashValidator(true, true));
+  EXPECT_EQ(static_cast<std::streamsize>(payload.size()),
+            tested->sputn(payload.data(), payload.size()));
+  auto response = tested->Close();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ("{}", response->payload);
+}
+
+/// @test Verify that upload errors are reported to the application.
+TEST_F(PipelinedResumableStreambufTest, UploadError) {
+  EXPECT_CALL(*mock_, UploadChunk(_, _))
+      .WillOnce(Invoke([](std::string const&, std::uint64_t) {
+        return StatusOr<ResumableUploadResponse>(PermanentError());
+      }));
+
+  auto tested = MakeTested(2 * kQuantum);
+  std::string const payload(2 * kQuantum, 'a');
+  tested->sputn(payload.data(), payload.size());
+  tested->sputc('b');
+
+  auto response = tested->Close();
+  ASSERT_FALSE(response.ok());
+  EXPECT_EQ(PermanentError().code(), response.status().code());
+  EXPECT_THAT(response.status().message(), HasSubstr("not found"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/retry_client.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
 #include <sstream>
 #include <thread>
@@ -247,8 +248,20 @@ StatusOr<std::unique_ptr<ObjectReadStreambuf>> RetryClient::ReadObject(
   auto retry_policy = retry_policy_->clone();
   auto backoff_policy = backoff_policy_->clone();
   auto is_idempotent = idempotency_policy_->IsIdempotent(request);
-  return MakeCall(*retry_policy, *backoff_policy, is_idempotent, *client_,
-                  &RawClient::ReadObject, request, __func__);
+  // The hashes are validated by RetryObjectReadStreambuf, over the data from
+  // the original download and any downloads used to resume it.
+  auto child_request = request;
+  child_request.set_multiple_options(DisableMD5Hash(true),
+                                     DisableCrc32cChecksum(true));
+  auto child = MakeCall(*retry_policy, *backoff_policy, is_idempotent,
+                        *client_, &RawClient::ReadObject, child_request,
+                        __func__);
+  if (!child) {
+    return child;
+  }
+  return std::unique_ptr<ObjectReadStreambuf>(new RetryObjectReadStreambuf(
+      client_, request, *std::move(child), retry_policy_->clone(),
+      backoff_policy_->clone()));
 }
 
 StatusOr<std::unique_ptr<ObjectWriteStreambuf>> RetryClient::WriteObject(
@@ -0,0 +1,251 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/object_stream.h"
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+RetryObjectReadStreambuf::RetryObjectReadStreambuf(
+    std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+    std::unique_ptr<ObjectReadStreambuf> child,
+    std::unique_ptr<RetryPolicy> retry_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      child_(std::move(child)),
+      retry_policy_prototype_(std::move(retry_policy)),
+      backoff_policy_prototype_(std::move(backoff_policy)),
+      hash_validator_(CreateHashValidator(request_)) {
+  // Start with an empty read area, to force an underflow() on the first
+  // extraction.
+  current_ios_buffer_.push_back('\0');
+  char* data = &current_ios_buffer_[0];
+  setg(data, data + 1, data + 1);
+}
+
+void RetryObjectReadStreambuf::Close() {
+  if (!child_) {
+    return;
+  }
+  child_->Close();
+  if (status_.ok()) {
+    status_ = child_->status();
+  }
+}
+
+bool RetryObjectReadStreambuf::IsOpen() const {
+  return child_ && child_->IsOpen();
+}
+
+RetryObjectReadStreambuf::int_type RetryObjectReadStreambuf::underflow() {
+  for (;;) {
+    Status last_status;
+    if (child_) {
+      auto count = ReadChild();
+      if (count && child_headers_pending_) {
+        child_headers_pending_ = false;
+        auto status = ProcessChildHeaders();
+        if (!status.ok()) {
+          return ReportError(std::move(status));
+        }
+      }
+      if (count && *count == 0) {
+        return OnEndOfStream();
+      }
+      if (count) {
+        // Some data was received, the next interruption starts with fresh
+        // policies.
+        retry_policy_.reset();
+        backoff_policy_.reset();
+        hash_validator_->Update(current_ios_buffer_);
+        offset_ += static_cast<std::int64_t>(*count);
+        char* data = &current_ios_buffer_[0];
+        setg(data, data, data + *count);
+        return traits_type::to_int_type(*data);
+      }
+      last_status = std::move(count).status();
+      child_.reset();
+    } else {
+      last_status = Resume();
+      if (last_status.ok()) {
+        continue;
+      }
+    }
+
+    if (!can_resume_) {
+      return ReportError(std::move(last_status));
+    }
+    if (!retry_policy_) {
+      retry_policy_ = retry_policy_prototype_->clone();
+      backoff_policy_ = backoff_policy_prototype_->clone();
+    }
+    if (!retry_policy_->OnFailure(last_status)) {
+      std::ostringstream os;
+      if (retry_policy_->IsExhausted()) {
+        os << "Retry policy exhausted in ReadObject: " << last_status;
+      } else {
+        os << "Permanent error in ReadObject: " << last_status;
+      }
+      return ReportError(Status(last_status.code(), std::move(os).str()));
+    }
+    auto delay = backoff_policy_->OnCompletion();
+    std::this_thread::sleep_for(delay);
+  }
+}
+
+StatusOr<std::size_t> RetryObjectReadStreambuf::ReadChild() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    // Peek before copying any data, the child reports errors only when it
+    // needs more data, and a partial copy would be lost.
+    if (traits_type::eq_int_type(child_->sgetc(), traits_type::eof())) {
+      if (!child_->status().ok()) {
+        return child_->status();
+      }
+      return 0;
+    }
+    auto const count = static_cast<std::size_t>(child_->in_avail());
+    current_ios_buffer_.resize(count);
+    child_->sgetn(&current_ios_buffer_[0],
+                  static_cast<std::streamsize>(count));
+    return count;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  } catch (RuntimeStatusError const& ex) {
+    return ex.status();
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+Status RetryObjectReadStreambuf::Resume() {
+  auto request = request_;
+  if (request.HasOption<ReadRange>()) {
+    auto const range = request.GetOption<ReadRange>().value();
+    auto const begin = range.begin + offset_;
+    if (begin >= range.end) {
+      // All the data was delivered before the failure, there is nothing to
+      // resume.
+      child_ = google::cloud::internal::make_unique<ObjectReadErrorStreambuf>(
+          Status());
+      return Status();
+    }
+    request.set_option(ReadRange(begin, range.end));
+  } else {
+    auto const begin = request.HasOption<ReadFromOffset>()
+                           ? request.GetOption<ReadFromOffset>().value()
+                           : 0;
+    request.set_option(ReadFromOffset(begin + offset_));
+  }
+  // The hashes are validated by this class, over all the downloads.
+  request.set_multiple_options(DisableMD5Hash(true),
+                               DisableCrc32cChecksum(true));
+  auto child = client_->ReadObject(request);
+  if (!child) {
+    return std::move(child).status();
+  }
+  child_ = *std::move(child);
+  child_headers_pending_ = true;
+  return Status();
+}
+
+Status RetryObjectReadStreambuf::ProcessChildHeaders() {
+  auto const& headers = child_->headers();
+  if (headers_.empty()) {
+    // These are the headers of the first download to receive any, they
+    // describe the object for the whole stream.
+    headers_ = headers;
+    for (auto const& kv : headers_) {
+      hash_validator_->ProcessHeader(kv.first, kv.second);
+    }
+    // Pin any new downloads to the generation of the first one, otherwise the
+    // data could come from two different versions of the object.
+    auto generation = headers_.find("x-goog-generation");
+    if (generation != headers_.end() && !request_.HasOption<Generation>()) {
+      request_.set_option(
+          Generation(std::strtoll(generation->second.c_str(), nullptr, 10)));
+    }
+    // The service may decompress the object before sending it, in that case
+    // the offsets in the data received do not match the offsets in the object.
+    auto encoding = headers_.find("x-goog-stored-content-encoding");
+    if (encoding != headers_.end() && encoding->second != "identity") {
+      can_resume_ = false;
+    }
+    return Status();
+  }
+  // The data of a resumed download is only usable if it comes from the same
+  // version of the object.
+  auto expected = headers_.find("x-goog-generation");
+  auto actual = headers.find("x-goog-generation");
+  if (expected != headers_.end() && actual != headers.end() &&
+      expected->second != actual->second) {
+    std::ostringstream os;
+    os << __func__ << "() - the object generation changed while resuming the"
+       << " download, expected=" << expected->second
+       << ", got=" << actual->second;
+    return Status(StatusCode::kAborted, std::move(os).str());
+  }
+  return Status();
+}
+
+RetryObjectReadStreambuf::int_type RetryObjectReadStreambuf::OnEndOfStream() {
+  if (!hash_validator_) {
+    return traits_type::eof();
+  }
+  hash_validator_result_ = std::move(*hash_validator_).Finish();
+  hash_validator_.reset();
+  if (hash_validator_result_.is_mismatch) {
+    std::string msg;
+    msg += __func__;
+    msg += "() - mismatched hashes in download";
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    throw HashMismatchError(msg, hash_validator_result_.received,
+                            hash_validator_result_.computed);
+#else
+    msg += ", expected=";
+    msg += hash_validator_result_.computed;
+    msg += ", received=";
+    msg += hash_validator_result_.received;
+    status_ = Status(StatusCode::kDataLoss, std::move(msg));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+  return traits_type::eof();
+}
+
+RetryObjectReadStreambuf::int_type RetryObjectReadStreambuf::ReportError(
+    Status status) {
+  // See `CurlReadStreambuf::ReportError()` for the reasons to report errors
+  // this way.
+  status_ = std::move(status);
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  google::cloud::internal::ThrowStatus(status_);
+#else
+  return traits_type::eof();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
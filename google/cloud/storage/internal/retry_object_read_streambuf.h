@@ -0,0 +1,118 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Decorates an `ObjectReadStreambuf` to resume downloads that fail mid-way.
+ *
+ * When reading from the stream fails with a retryable error this class starts
+ * a new download, from the first byte not yet delivered to the application,
+ * and continues reading from it. The new download is pinned to the generation
+ * of the original one. The hashes are computed by this class, over the data
+ * from all the downloads, the decorated streams should not validate them.
+ *
+ * Each interruption gets a fresh copy of the retry and backoff policies, as
+ * long as some data was received since the previous interruption.
+ *
+ * The decorated streams only receive the response headers with the first
+ * block of data, this class processes them after the first successful read
+ * from each download. `headers()` is empty until then.
+ */
+class RetryObjectReadStreambuf : public ObjectReadStreambuf {
+ public:
+  RetryObjectReadStreambuf(std::shared_ptr<RawClient> client,
+                           ReadObjectRangeRequest request,
+                           std::unique_ptr<ObjectReadStreambuf> child,
+                           std::unique_ptr<RetryPolicy> retry_policy,
+                           std::unique_ptr<BackoffPolicy> backoff_policy);
+
+  ~RetryObjectReadStreambuf() override = default;
+
+  void Close() override;
+  bool IsOpen() const override;
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override {
+    return hash_validator_result_.received;
+  }
+  std::string const& computed_hash() const override {
+    return hash_validator_result_.computed;
+  }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  /// Read the next block of data from `child_` into `current_ios_buffer_`.
+  StatusOr<std::size_t> ReadChild();
+
+  /// Start a new download for the data not yet delivered.
+  Status Resume();
+
+  /// Process the headers of `child_`, after its first successful read.
+  Status ProcessChildHeaders();
+
+  /// Finish the hash computations and report any mismatch.
+  int_type OnEndOfStream();
+
+  int_type ReportError(Status status);
+
+  std::shared_ptr<RawClient> client_;
+  ReadObjectRangeRequest request_;
+  std::unique_ptr<ObjectReadStreambuf> child_;
+  std::unique_ptr<RetryPolicy> retry_policy_prototype_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_prototype_;
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+
+  std::string current_ios_buffer_;
+  // The number of bytes delivered to the application, that is, the offset of
+  // the next download relative to the start of the original one.
+  std::int64_t offset_ = 0;
+  // Some objects cannot be resumed, e.g. when the service decompresses them.
+  bool can_resume_ = true;
+  // True until the headers of `child_` are processed.
+  bool child_headers_pending_ = true;
+
+  std::unique_ptr<HashValidator> hash_validator_;
+  HashValidator::Result hash_validator_result_;
+  Status status_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
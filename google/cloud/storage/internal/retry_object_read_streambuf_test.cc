@@ -0,0 +1,282 @@
+// Copyright 2019 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::google::cloud::storage::testing::canonical_errors::TransientError;
+using ::google::cloud::testing_util::chrono_literals::operator"" _us;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+
+/**
+ * A streambuf returning fixed contents and then (optionally) an error.
+ *
+ * Like `CurlReadStreambuf`, the headers are only available after the first
+ * underflow, and errors are reported the same way.
+ */
+class FakeReadStreambuf : public ObjectReadStreambuf {
+ public:
+  FakeReadStreambuf(std::string contents, Status error,
+                    std::multimap<std::string, std::string> headers = {})
+      : contents_(std::move(contents)),
+        error_(std::move(error)),
+        pending_headers_(std::move(headers)) {}
+
+  void Close() override {}
+  bool IsOpen() const override { return true; }
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override { return hash_; }
+  std::string const& computed_hash() const override { return hash_; }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ protected:
+  int_type underflow() override {
+    if (!started_) {
+      started_ = true;
+      headers_ = std::move(pending_headers_);
+      if (!contents_.empty()) {
+        char* data = &contents_[0];
+        setg(data, data, data + contents_.size());
+        return traits_type::to_int_type(*data);
+      }
+    }
+    if (error_.ok()) {
+      return traits_type::eof();
+    }
+    status_ = error_;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    google::cloud::internal::ThrowStatus(status_);
+#else
+    return traits_type::eof();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+ private:
+  std::string contents_;
+  Status error_;
+  Status status_;
+  std::string hash_;
+  bool started_ = false;
+  std::multimap<std::string, std::string> pending_headers_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+std::unique_ptr<ObjectReadStreambuf> MakeChild(
+    std::string contents, Status error = Status(),
+    std::multimap<std::string, std::string> headers = {}) {
+  return std::unique_ptr<ObjectReadStreambuf>(new FakeReadStreambuf(
+      std::move(contents), std::move(error), std::move(headers)));
+}
+
+std::string Crc32cHeader(std::string const& contents) {
+  return "crc32c=" + Base64Encode(google::cloud::internal::EncodeBigEndian(
+                         crc32c::Crc32c(contents)));
+}
+
+class RetryObjectReadStreambufTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<ObjectReadStreambuf> MakeTested(
+      ReadObjectRangeRequest request,
+      std::unique_ptr<ObjectReadStreambuf> child) {
+    return std::unique_ptr<ObjectReadStreambuf>(new RetryObjectReadStreambuf(
+        mock_, std::move(request), std::move(child),
+        LimitedErrorCountRetryPolicy(3).clone(),
+        ExponentialBackoffPolicy(1_us, 5_us, 2.0).clone()));
+  }
+
+  std::shared_ptr<testing::MockClient> mock_ =
+      std::make_shared<testing::MockClient>();
+};
+
+std::string ReadAll(ObjectReadStream& stream) {
+  std::string contents;
+  char c;
+  while (stream.get(c)) {
+    contents.push_back(c);
+  }
+  return contents;
+}
+
+/// @test Verify that a download interrupted mid-way is resumed.
+TEST_F(RetryObjectReadStreambufTest, ResumeFromOffset) {
+  std::string const contents = "0123456789abcdefghijklmnopqrstuvwxyz";
+  std::multimap<std::string, std::string> headers{
+      {"x-goog-generation", "1234"},
+      {"x-goog-hash", Crc32cHeader(contents)},
+  };
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(10, r.GetOption<ReadFromOffset>().value());
+        EXPECT_TRUE(r.HasOption<Generation>());
+        EXPECT_EQ(1234, r.GetOption<Generation>().value());
+        EXPECT_FALSE(r.HasOption<ReadRange>());
+        return make_status_or(
+            MakeChild(contents.substr(10, 10), TransientError()));
+      }))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(20, r.GetOption<ReadFromOffset>().value());
+        return make_status_or(MakeChild(contents.substr(20)));
+      }));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_option(DisableMD5Hash(true));
+  ObjectReadStream stream(MakeTested(
+      request, MakeChild(contents.substr(0, 10), TransientError(), headers)));
+  EXPECT_EQ(contents, ReadAll(stream));
+  EXPECT_TRUE(stream.status().ok());
+  EXPECT_FALSE(stream.received_hash().empty());
+  EXPECT_EQ(stream.received_hash(), stream.computed_hash());
+}
+
+/// @test Verify that the hashes are validated over all the downloads.
+TEST_F(RetryObjectReadStreambufTest, ResumeHashMismatch) {
+  std::string const contents = "0123456789abcdefghijklmnopqrstuvwxyz";
+  std::multimap<std::string, std::string> headers{
+      {"x-goog-generation", "1234"},
+      {"x-goog-hash", Crc32cHeader("not the contents")},
+  };
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const&) {
+        return make_status_or(MakeChild(contents.substr(10), Status(),
+                                        {{"x-goog-generation", "1234"}}));
+      }));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_option(DisableMD5Hash(true));
+  ObjectReadStream stream(MakeTested(
+      request, MakeChild(contents.substr(0, 10), TransientError(), headers)));
+  EXPECT_EQ(contents, ReadAll(stream));
+  EXPECT_EQ(Crc32cHeader("not the contents"),
+            "crc32c=" + stream.received_hash());
+  EXPECT_EQ(Crc32cHeader(contents), "crc32c=" + stream.computed_hash());
+  EXPECT_EQ("1234", stream.headers().find("x-goog-generation")->second);
+#if !GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_EQ(StatusCode::kDataLoss, stream.status().code());
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+/// @test Verify that resumed downloads from a different generation fail.
+TEST_F(RetryObjectReadStreambufTest, ResumeGenerationChanged) {
+  std::string const contents = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(1234, r.GetOption<Generation>().value());
+        return make_status_or(MakeChild(contents.substr(10), Status(),
+                                        {{"x-goog-generation", "5678"}}));
+      }));
+
+  ObjectReadStream stream(
+      MakeTested(ReadObjectRangeRequest("test-bucket", "test-object"),
+                 MakeChild(contents.substr(0, 10), TransientError(),
+                           {{"x-goog-generation", "1234"}})));
+  EXPECT_EQ(contents.substr(0, 10), ReadAll(stream));
+  EXPECT_TRUE(stream.bad());
+  EXPECT_EQ(StatusCode::kAborted, stream.status().code());
+  EXPECT_THAT(stream.status().message(), HasSubstr("generation changed"));
+}
+
+/// @test Verify that range downloads are resumed with a smaller range.
+TEST_F(RetryObjectReadStreambufTest, ResumeRange) {
+  std::string const contents = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_FALSE(r.HasOption<ReadFromOffset>());
+        auto range = r.GetOption<ReadRange>().value();
+        EXPECT_EQ(110, range.begin);
+        EXPECT_EQ(136, range.end);
+        return make_status_or(MakeChild(contents.substr(10)));
+      }));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_option(ReadRange(100, 136));
+  ObjectReadStream stream(MakeTested(
+      request, MakeChild(contents.substr(0, 10), TransientError())));
+  EXPECT_EQ(contents, ReadAll(stream));
+  EXPECT_TRUE(stream.status().ok());
+}
+
+/// @test Verify that permanent errors are not retried.
+TEST_F(RetryObjectReadStreambufTest, PermanentError) {
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  ObjectReadStream stream(
+      MakeTested(ReadObjectRangeRequest("test-bucket", "test-object"),
+                 MakeChild("0123456789", PermanentError())));
+  EXPECT_EQ("0123456789", ReadAll(stream));
+  EXPECT_TRUE(stream.bad());
+  EXPECT_EQ(PermanentError().code(), stream.status().code());
+  EXPECT_THAT(stream.status().message(), HasSubstr("Permanent error"));
+}
+
+/// @test Verify that the retry policy limits the attempts to resume.
+TEST_F(RetryObjectReadStreambufTest, TooManyFailures) {
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadStreambuf>>(TransientError());
+      }));
+
+  ObjectReadStream stream(
+      MakeTested(ReadObjectRangeRequest("test-bucket", "test-object"),
+                 MakeChild("0123456789", TransientError())));
+  EXPECT_EQ("0123456789", ReadAll(stream));
+  EXPECT_TRUE(stream.bad());
+  EXPECT_EQ(TransientError().code(), stream.status().code());
+  EXPECT_THAT(stream.status().message(), HasSubstr("Retry policy exhausted"));
+}
+
+/// @test Verify that objects decompressed by the service are not resumed.
+TEST_F(RetryObjectReadStreambufTest, NoResumeWithDecompression) {
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  std::multimap<std::string, std::string> headers{
+      {"x-goog-stored-content-encoding", "gzip"}};
+  ObjectReadStream stream(
+      MakeTested(ReadObjectRangeRequest("test-bucket", "test-object"),
+                 MakeChild("0123456789", TransientError(), headers)));
+  EXPECT_EQ("0123456789", ReadAll(stream));
+  EXPECT_TRUE(stream.bad());
+  EXPECT_EQ(TransientError().code(), stream.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,13 +13,21 @@
 // limitations under the License.
 
 #include "google/cloud/storage/client.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/storage/testing/retry_tests.h"
 #include "google/cloud/testing_util/assert_ok.h"
+#include <crc32c/crc32c.h>
 #include <gmock/gmock.h>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
 
 namespace google {
 namespace cloud {
@@ -30,12 +38,41 @@ namespace {
 using ::google::cloud::storage::testing::canonical_errors::PermanentError;
 using ::google::cloud::storage::testing::canonical_errors::TransientError;
 using ::testing::_;
+using ::testing::AtLeast;
 using ::testing::HasSubstr;
 using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ms = std::chrono::milliseconds;
 
+/// A streambuf returning fixed contents, used to mock `ReadObject()`.
+class FakeReadStreambuf : public internal::ObjectReadStreambuf {
+ public:
+  explicit FakeReadStreambuf(std::string contents)
+      : contents_(std::move(contents)) {
+    setg(&contents_[0], &contents_[0], &contents_[0] + contents_.size());
+  }
+
+  void Close() override {}
+  bool IsOpen() const override { return true; }
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override { return received_hash_; }
+  std::string const& computed_hash() const override { return computed_hash_; }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ protected:
+  int_type underflow() override { return traits_type::eof(); }
+
+ private:
+  std::string contents_;
+  Status status_;
+  std::string received_hash_;
+  std::string computed_hash_;
+  std::multimap<std::string, std::string> headers_;
+};
+
 /**
  * Test the functions in Storage::Client related to 'Objects: *'.
  *
@@ -440,6 +477,516 @@ TEST_F(ObjectTest, ReadObjectPermanentFailure) {
   EXPECT_THAT(status.message(), HasSubstr("ReadObject"));
 }
 
+#ifndef _WIN32
+/// Create the contents and metadata for the parallel download tests.
+std::string MakeDownloadContents(std::size_t size) {
+  std::string contents;
+  contents.reserve(size);
+  for (std::size_t i = 0; i != size; ++i) {
+    contents.push_back(static_cast<char>('a' + i % 26));
+  }
+  return contents;
+}
+
+ObjectMetadata MakeDownloadMetadata(std::string const& contents,
+                                    std::string const& crc32c) {
+  internal::nl::json json{
+      {"bucket", "test-bucket-name"},
+      {"name", "test-object-name"},
+      {"generation", "1234"},
+      {"size", std::to_string(contents.size())},
+      {"crc32c", crc32c},
+  };
+  return internal::ObjectMetadataParser::FromJson(json).value();
+}
+
+std::string Crc32cOf(std::string const& contents) {
+  return internal::Base64Encode(
+      google::cloud::internal::EncodeBigEndian(crc32c::Crc32c(contents)));
+}
+
+TEST_F(ObjectTest, DownloadToFileParallel) {
+  // Large enough to download using 3 slices of at least 1 KiB.
+  client_options.set_parallel_download_minimum_slice_size(1024);
+  auto const contents = MakeDownloadContents(3 * 1024 + 100);
+  auto const metadata = MakeDownloadMetadata(contents, Crc32cOf(contents));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&metadata](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("test-bucket-name", r.bucket_name());
+        EXPECT_EQ("test-object-name", r.object_name());
+        return make_status_or(metadata);
+      }));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke([&contents](internal::ReadObjectRangeRequest const& r) {
+            EXPECT_TRUE(r.HasOption<ReadRange>());
+            EXPECT_TRUE(r.HasOption<Generation>());
+            EXPECT_EQ(1234, r.GetOption<Generation>().value());
+            auto range = r.GetOption<ReadRange>().value();
+            std::unique_ptr<internal::ObjectReadStreambuf> buf(
+                new FakeReadStreambuf(contents.substr(
+                    static_cast<std::size_t>(range.begin),
+                    static_cast<std::size_t>(range.end - range.begin))));
+            return make_status_or(std::move(buf));
+          }));
+
+  auto const file_name = ::testing::TempDir() + "download-parallel.txt";
+  auto status = client->DownloadToFile("test-bucket-name", "test-object-name",
+                                       file_name, ParallelDownload(4));
+  ASSERT_STATUS_OK(status);
+
+  std::ifstream is(file_name);
+  std::string actual(std::istreambuf_iterator<char>{is}, {});
+  EXPECT_EQ(contents.size(), actual.size());
+  EXPECT_TRUE(contents == actual);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, DownloadToFileParallelMaximumSlices) {
+  client_options.set_parallel_download_minimum_slice_size(1);
+  auto const contents = MakeDownloadContents(1000);
+  auto const metadata = MakeDownloadMetadata(contents, Crc32cOf(contents));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(metadata)));
+  // The number of slices, and therefore of concurrent streams, is capped.
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(32)
+      .WillRepeatedly(
+          Invoke([&contents](internal::ReadObjectRangeRequest const& r) {
+            auto range = r.GetOption<ReadRange>().value();
+            std::unique_ptr<internal::ObjectReadStreambuf> buf(
+                new FakeReadStreambuf(contents.substr(
+                    static_cast<std::size_t>(range.begin),
+                    static_cast<std::size_t>(range.end - range.begin))));
+            return make_status_or(std::move(buf));
+          }));
+
+  auto const file_name = ::testing::TempDir() + "download-max-slices.txt";
+  auto status = client->DownloadToFile("test-bucket-name", "test-object-name",
+                                       file_name, ParallelDownload(1000));
+  ASSERT_STATUS_OK(status);
+
+  std::ifstream is(file_name);
+  std::string actual(std::istreambuf_iterator<char>{is}, {});
+  EXPECT_EQ(contents, actual);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, DownloadToFileParallelHashMismatch) {
+  client_options.set_parallel_download_minimum_slice_size(1024);
+  auto const contents = MakeDownloadContents(2 * 1024);
+  auto const metadata =
+      MakeDownloadMetadata(contents, Crc32cOf("not the contents"));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(metadata)));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&contents](internal::ReadObjectRangeRequest const& r) {
+            auto range = r.GetOption<ReadRange>().value();
+            std::unique_ptr<internal::ObjectReadStreambuf> buf(
+                new FakeReadStreambuf(contents.substr(
+                    static_cast<std::size_t>(range.begin),
+                    static_cast<std::size_t>(range.end - range.begin))));
+            return make_status_or(std::move(buf));
+          }));
+
+  auto const file_name = ::testing::TempDir() + "download-mismatch.txt";
+  auto status = client->DownloadToFile("test-bucket-name", "test-object-name",
+                                       file_name, ParallelDownload(2));
+  EXPECT_EQ(StatusCode::kDataLoss, status.code());
+  EXPECT_THAT(status.message(), HasSubstr("mismatched hashes"));
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, DownloadToFileParallelSmallObject) {
+  client_options.set_parallel_download_minimum_slice_size(1024);
+  auto const contents = MakeDownloadContents(1024);
+  auto const metadata = MakeDownloadMetadata(contents, Crc32cOf(contents));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(metadata)));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([&contents](internal::ReadObjectRangeRequest const& r) {
+        // Small objects are downloaded using a single stream.
+        EXPECT_FALSE(r.HasOption<ReadRange>());
+        std::unique_ptr<internal::ObjectReadStreambuf> buf(
+            new FakeReadStreambuf(contents));
+        return make_status_or(std::move(buf));
+      }));
+
+  auto const file_name = ::testing::TempDir() + "download-small.txt";
+  auto status = client->DownloadToFile("test-bucket-name", "test-object-name",
+                                       file_name, ParallelDownload(4));
+  ASSERT_STATUS_OK(status);
+
+  std::ifstream is(file_name);
+  std::string actual(std::istreambuf_iterator<char>{is}, {});
+  EXPECT_EQ(contents, actual);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+#endif  // _WIN32
+
+/// A resumable upload session that saves the uploaded data in a map.
+class FakeUploadSession : public internal::ResumableUploadSession {
+ public:
+  FakeUploadSession(std::string object_name,
+                    std::map<std::string, std::string>& objects,
+                    std::mutex& mu)
+      : object_name_(std::move(object_name)), objects_(objects), mu_(mu) {}
+
+  StatusOr<internal::ResumableUploadResponse> UploadChunk(
+      std::string const& buffer, std::uint64_t upload_size) override {
+    contents_ += buffer;
+    if (contents_.size() < upload_size) {
+      return internal::ResumableUploadResponse{"", contents_.size() - 1, ""};
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    objects_[object_name_] = contents_;
+    internal::nl::json payload{{"name", object_name_}};
+    return internal::ResumableUploadResponse{"", contents_.size() - 1,
+                                             payload.dump()};
+  }
+  StatusOr<internal::ResumableUploadResponse> ResetSession() override {
+    return Status(StatusCode::kUnimplemented, "ResetSession");
+  }
+  std::uint64_t next_expected_byte() const override {
+    return contents_.size();
+  }
+  std::string const& session_id() const override { return object_name_; }
+
+ private:
+  std::string object_name_;
+  std::string contents_;
+  std::map<std::string, std::string>& objects_;
+  std::mutex& mu_;
+};
+
+TEST_F(ObjectTest, UploadFileParallel) {
+  // Large enough to upload using 3 parts of at least 1 KiB.
+  client_options.set_maximum_simple_upload_size(0);
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  std::string contents;
+  for (std::size_t i = 0; i != 3 * 1024 + 100; ++i) {
+    contents.push_back(static_cast<char>('a' + i % 26));
+  }
+  auto const file_name = ::testing::TempDir() + "upload-parallel.txt";
+  std::ofstream(file_name, std::ios::binary) << contents;
+
+  std::mutex mu;
+  std::map<std::string, std::string> objects;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke([&](internal::ResumableUploadRequest const& r) {
+            EXPECT_EQ("test-bucket-name", r.bucket_name());
+            EXPECT_THAT(r.object_name(),
+                        HasSubstr("test-object-name.parallel-upload-"));
+            std::unique_ptr<internal::ResumableUploadSession> session(
+                new FakeUploadSession(r.object_name(), objects, mu));
+            return make_status_or(std::move(session));
+          }));
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([&](internal::ComposeObjectRequest const& r) {
+        EXPECT_EQ("test-bucket-name", r.bucket_name());
+        EXPECT_EQ("test-object-name", r.object_name());
+        auto payload = internal::nl::json::parse(r.JsonPayload());
+        EXPECT_EQ("text/plain",
+                  payload["destination"].value("contentType", ""));
+        std::string composed;
+        for (auto const& source : payload["sourceObjects"]) {
+          composed += objects[source.value("name", "")];
+        }
+        EXPECT_EQ(contents.size(), composed.size());
+        EXPECT_TRUE(contents == composed);
+        internal::nl::json json{
+            {"bucket", "test-bucket-name"},
+            {"name", "test-object-name"},
+            {"crc32c", internal::Base64Encode(
+                           google::cloud::internal::EncodeBigEndian(
+                               crc32c::Crc32c(composed)))},
+        };
+        return internal::ObjectMetadataParser::FromJson(json);
+      }));
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ(1U, objects.count(r.object_name()));
+        return make_status_or(internal::EmptyResponse{});
+      }));
+
+  auto actual =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(4), ContentType("text/plain"));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object-name", actual->name());
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, UploadFileParallelPartFailure) {
+  client_options.set_maximum_simple_upload_size(0);
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  auto const file_name = ::testing::TempDir() + "upload-parallel-failure.txt";
+  std::ofstream(file_name, std::ios::binary) << std::string(2 * 1024, 'x');
+
+  // Once a part fails the parts that have not started are skipped.
+  std::atomic<int> started(0);
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(AtLeast(1))
+      .WillRepeatedly(Invoke([&](internal::ResumableUploadRequest const&) {
+        ++started;
+        return StatusOr<std::unique_ptr<internal::ResumableUploadSession>>(
+            PermanentError());
+      }));
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+  // The temporary objects are deleted even if the parts failed to upload.
+  std::atomic<int> deleted(0);
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillRepeatedly(Invoke([&](internal::DeleteObjectRequest const&) {
+        ++deleted;
+        return StatusOr<internal::EmptyResponse>(
+            Status(StatusCode::kNotFound, "NotFound"));
+      }));
+
+  auto actual = client->UploadFile(file_name, "test-bucket-name",
+                                   "test-object-name", ParallelUpload(2));
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("error uploading parts"));
+  EXPECT_GE(2, started.load());
+  EXPECT_EQ(started.load(), deleted.load());
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+/// Compose @p r from the objects in @p objects, saving the result there too.
+StatusOr<ObjectMetadata> FakeCompose(
+    internal::ComposeObjectRequest const& r,
+    std::map<std::string, std::string>& objects, std::mutex& mu) {
+  auto payload = internal::nl::json::parse(r.JsonPayload());
+  std::string composed;
+  std::lock_guard<std::mutex> lk(mu);
+  for (auto const& source : payload["sourceObjects"]) {
+    composed += objects[source.value("name", "")];
+  }
+  objects[r.object_name()] = composed;
+  internal::nl::json json{
+      {"bucket", r.bucket_name()},
+      {"name", r.object_name()},
+      {"crc32c", internal::Base64Encode(
+                     google::cloud::internal::EncodeBigEndian(
+                         crc32c::Crc32c(composed)))},
+  };
+  return internal::ObjectMetadataParser::FromJson(json);
+}
+
+TEST_F(ObjectTest, UploadFileParallelManyParts) {
+  // More parts than a single compose request accepts, the parts are composed
+  // in two intermediate objects and then in the destination.
+  client_options.set_maximum_simple_upload_size(0);
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  std::string contents;
+  for (std::size_t i = 0; i != 40 * 1024; ++i) {
+    contents.push_back(static_cast<char>('a' + i % 26));
+  }
+  auto const file_name = ::testing::TempDir() + "upload-parallel-many.txt";
+  std::ofstream(file_name, std::ios::binary) << contents;
+
+  std::mutex mu;
+  std::map<std::string, std::string> objects;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(40)
+      .WillRepeatedly(Invoke([&](internal::ResumableUploadRequest const& r) {
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(r.object_name(), objects, mu));
+        return make_status_or(std::move(session));
+      }));
+  std::vector<std::string> intermediates;
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*mock, ComposeObject(_))
+        .Times(2)
+        .WillRepeatedly(Invoke([&](internal::ComposeObjectRequest const& r) {
+          EXPECT_THAT(r.object_name(), HasSubstr(".compose-0-"));
+          auto payload = internal::nl::json::parse(r.JsonPayload());
+          EXPECT_EQ(intermediates.empty() ? 32U : 8U,
+                    payload["sourceObjects"].size());
+          intermediates.push_back(r.object_name());
+          return FakeCompose(r, objects, mu);
+        }));
+    EXPECT_CALL(*mock, ComposeObject(_))
+        .WillOnce(Invoke([&](internal::ComposeObjectRequest const& r) {
+          EXPECT_EQ("test-object-name", r.object_name());
+          auto payload = internal::nl::json::parse(r.JsonPayload());
+          std::vector<std::string> sources;
+          for (auto const& source : payload["sourceObjects"]) {
+            sources.push_back(source.value("name", ""));
+          }
+          EXPECT_EQ(intermediates, sources);
+          return FakeCompose(r, objects, mu);
+        }));
+  }
+  std::set<std::string> deleted;
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .Times(42)
+      .WillRepeatedly(Invoke([&](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ(1U, objects.count(r.object_name()));
+        deleted.insert(r.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      }));
+
+  auto actual = client->UploadFile(file_name, "test-bucket-name",
+                                   "test-object-name", ParallelUpload(64));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object-name", actual->name());
+  EXPECT_TRUE(contents == objects["test-object-name"]);
+  // Every part and intermediate object is deleted, the destination is kept.
+  EXPECT_EQ(42U, deleted.size());
+  EXPECT_EQ(0U, deleted.count("test-object-name"));
+  for (auto const& name : intermediates) {
+    EXPECT_EQ(1U, deleted.count(name));
+  }
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, UploadFileParallelComposeFailure) {
+  client_options.set_maximum_simple_upload_size(0);
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  auto const file_name =
+      ::testing::TempDir() + "upload-parallel-compose-failure.txt";
+  std::ofstream(file_name, std::ios::binary) << std::string(40 * 1024, 'x');
+
+  std::mutex mu;
+  std::map<std::string, std::string> objects;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(40)
+      .WillRepeatedly(Invoke([&](internal::ResumableUploadRequest const& r) {
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(r.object_name(), objects, mu));
+        return make_status_or(std::move(session));
+      }));
+  // The first intermediate object is created, the second fails and the
+  // destination is never composed.
+  std::string intermediate;
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([&](internal::ComposeObjectRequest const& r) {
+        intermediate = r.object_name();
+        return FakeCompose(r, objects, mu);
+      }))
+      .WillOnce(Invoke([](internal::ComposeObjectRequest const& r) {
+        EXPECT_THAT(r.object_name(), HasSubstr(".compose-0-1"));
+        return StatusOr<ObjectMetadata>(PermanentError());
+      }));
+  std::set<std::string> deleted;
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .Times(41)
+      .WillRepeatedly(Invoke([&](internal::DeleteObjectRequest const& r) {
+        EXPECT_EQ(1U, objects.count(r.object_name()));
+        deleted.insert(r.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      }));
+
+  auto actual = client->UploadFile(file_name, "test-bucket-name",
+                                   "test-object-name", ParallelUpload(40));
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("error composing parts"));
+  EXPECT_EQ(41U, deleted.size());
+  EXPECT_EQ(1U, deleted.count(intermediate));
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, UploadFileParallelUnsupportedOptions) {
+  client_options.set_maximum_simple_upload_size(0);
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  std::string const contents(2 * 1024, 'x');
+  auto const file_name = ::testing::TempDir() + "upload-parallel-serial.txt";
+  std::ofstream(file_name, std::ios::binary) << contents;
+
+  // `ComposeObject()` cannot honor these options, the file is uploaded with a
+  // single resumable upload instead.
+  std::mutex mu;
+  std::map<std::string, std::string> objects;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](internal::ResumableUploadRequest const& r) {
+        EXPECT_EQ("test-object-name", r.object_name());
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(r.object_name(), objects, mu));
+        return make_status_or(std::move(session));
+      }));
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+
+  auto actual = client->UploadFile(file_name, "test-bucket-name",
+                                   "test-object-name", ParallelUpload(2),
+                                   IfGenerationNotMatch(7));
+  ASSERT_STATUS_OK(actual);
+  actual = client->UploadFile(file_name, "test-bucket-name",
+                              "test-object-name", ParallelUpload(2),
+                              IfMetagenerationNotMatch(7));
+  ASSERT_STATUS_OK(actual);
+  actual = client->UploadFile(file_name, "test-bucket-name",
+                              "test-object-name", ParallelUpload(2),
+                              MD5HashValue(ComputeMD5Hash(contents)));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, objects["test-object-name"]);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, UploadFileSimple) {
+  // Include characters that would be modified by a text mode stream.
+  std::string contents;
+  for (int i = 0; i != 1000; ++i) {
+    contents += std::string("line\r\n\0\x1a", 8);
+  }
+  auto const file_name = ::testing::TempDir() + "upload-simple.txt";
+  std::ofstream(file_name, std::ios::binary) << contents;
+
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Invoke([&](internal::InsertObjectMediaRequest const& r) {
+        EXPECT_EQ(contents.size(), r.contents().size());
+        EXPECT_TRUE(contents == r.contents());
+        internal::nl::json json{{"name", r.object_name()}};
+        return internal::ObjectMetadataParser::FromJson(json);
+      }));
+
+  auto actual =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name");
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object-name", actual->name());
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
+TEST_F(ObjectTest, UploadFileResumable) {
+  auto const quantum = internal::UploadChunkRequest::kChunkSizeQuantum;
+  client_options.SetUploadBufferSize(quantum);
+  client_options.set_maximum_simple_upload_size(0);
+  std::string contents;
+  for (std::size_t i = 0; i != 5 * quantum / 2; ++i) {
+    contents.push_back(static_cast<char>('a' + i % 26));
+  }
+  auto const file_name = ::testing::TempDir() + "upload-resumable.txt";
+  std::ofstream(file_name, std::ios::binary) << contents;
+
+  std::mutex mu;
+  std::map<std::string, std::string> objects;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([&](internal::ResumableUploadRequest const& r) {
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(r.object_name(), objects, mu));
+        return make_status_or(std::move(session));
+      }));
+
+  auto actual =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name");
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object-name", actual->name());
+  EXPECT_EQ(contents.size(), objects["test-object-name"].size());
+  EXPECT_TRUE(contents == objects["test-object-name"]);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -32,6 +32,7 @@ storage_client_hdrs = [
     "internal/complex_option.h",
     "internal/common_metadata.h",
     "internal/compute_engine_util.h",
+    "internal/crc32c_combine.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
     "internal/curl_download_request.h",
@@ -61,6 +62,7 @@ storage_client_hdrs = [
     "internal/object_requests.h",
     "internal/object_streambuf.h",
     "internal/parse_rfc3339.h",
+    "internal/pipelined_resumable_streambuf.h",
     "internal/patch_builder.h",
     "internal/policy_document_request.h",
     "internal/range_from_pagination.h",
@@ -68,6 +70,7 @@ storage_client_hdrs = [
     "internal/raw_client_wrapper_utils.h",
     "internal/resumable_upload_session.h",
     "internal/retry_client.h",
+    "internal/retry_object_read_streambuf.h",
     "internal/retry_resumable_upload_session.h",
     "internal/service_account_requests.h",
     "internal/sha256_hash.h",
@@ -118,6 +121,7 @@ storage_client_srcs = [
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
+    "internal/crc32c_combine.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
     "internal/curl_download_request.cc",
@@ -143,8 +147,10 @@ storage_client_srcs = [
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
     "internal/parse_rfc3339.cc",
+    "internal/pipelined_resumable_streambuf.cc",
     "internal/policy_document_request.cc",
     "internal/retry_client.cc",
+    "internal/retry_object_read_streambuf.cc",
     "internal/retry_resumable_upload_session.cc",
     "internal/service_account_requests.cc",
     "internal/sha256_hash.cc",
@@ -144,6 +144,15 @@ TEST_F(ClientOptionsTest, SetUploadBufferSize) {
   EXPECT_EQ(default_size, client_options.upload_buffer_size());
 }
 
+TEST_F(ClientOptionsTest, SetUploadBufferBudget) {
+  auto opts = ClientOptions::CreateDefaultClientOptions();
+  ASSERT_STATUS_OK(opts);
+  ClientOptions client_options = *opts;
+  EXPECT_EQ(0U, client_options.upload_buffer_budget());
+  client_options.set_upload_buffer_budget(1024);
+  EXPECT_EQ(1024U, client_options.upload_buffer_budget());
+}
+
 TEST_F(ClientOptionsTest, UserAgentPrefix) {
   ClientOptions options(oauth2::CreateAnonymousCredentials());
   EXPECT_EQ("", options.user_agent_prefix());
@@ -165,6 +174,26 @@ TEST_F(ClientOptionsTest, SetMaximumSimpleUploadSize) {
   EXPECT_EQ(0U, client_options.maximum_simple_upload_size());
 }
 
+TEST_F(ClientOptionsTest, SetParallelDownloadMinimumSliceSize) {
+  auto opts = ClientOptions::CreateDefaultClientOptions();
+  ASSERT_STATUS_OK(opts);
+  ClientOptions client_options = *opts;
+  EXPECT_EQ(16 * 1024 * 1024U,
+            client_options.parallel_download_minimum_slice_size());
+  client_options.set_parallel_download_minimum_slice_size(1024);
+  EXPECT_EQ(1024U, client_options.parallel_download_minimum_slice_size());
+}
+
+TEST_F(ClientOptionsTest, SetParallelUploadMinimumPartSize) {
+  auto opts = ClientOptions::CreateDefaultClientOptions();
+  ASSERT_STATUS_OK(opts);
+  ClientOptions client_options = *opts;
+  EXPECT_EQ(16 * 1024 * 1024U,
+            client_options.parallel_upload_minimum_part_size());
+  client_options.set_parallel_upload_minimum_part_size(1024);
+  EXPECT_EQ(1024U, client_options.parallel_upload_minimum_part_size());
+}
+
 TEST_F(ClientOptionsTest, SetEnableLockingCallbacks) {
   auto opts = ClientOptions::CreateDefaultClientOptions();
   ASSERT_STATUS_OK(opts);
@@ -38,6 +38,7 @@ storage_client_unit_tests = [
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/compute_engine_util_test.cc",
+    "internal/crc32c_combine_test.cc",
     "internal/curl_client_test.cc",
     "internal/curl_handle_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
@@ -60,9 +61,11 @@ storage_client_unit_tests = [
     "internal/object_requests_test.cc",
     "internal/object_streambuf_test.cc",
     "internal/parse_rfc3339_test.cc",
+    "internal/pipelined_resumable_streambuf_test.cc",
     "internal/patch_builder_test.cc",
     "internal/policy_document_request_test.cc",
     "internal/retry_client_test.cc",
+    "internal/retry_object_read_streambuf_test.cc",
     "internal/retry_resumable_upload_session_test.cc",
     "internal/service_account_requests_test.cc",
     "internal/sha256_hash_test.cc",
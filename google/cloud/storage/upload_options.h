@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -50,6 +51,36 @@ inline UseResumableUploadSession NewResumableUploadSession() {
   return UseResumableUploadSession("");
 }
 
+/**
+ * Upload a file using multiple concurrent streams.
+ *
+ * When this option is used with `Client::UploadFile()` the library splits the
+ * file into (at most) the given number of parts, uploads each part to a
+ * temporary object using a separate resumable upload, and then creates the
+ * destination object with `ComposeObject()`. If there are more parts than a
+ * single `ComposeObject()` request accepts the parts are composed in several
+ * rounds. The temporary objects are deleted when the upload completes or
+ * fails.
+ *
+ * The CRC32C checksum of the destination object is still validated, the MD5
+ * hash is not, and composite objects do not have one.
+ *
+ * The option is ignored for files small enough to use a simple upload, when
+ * restoring a previous resumable upload session, and when the request includes
+ * an `IfGenerationNotMatch`, `IfMetagenerationNotMatch`, or `MD5HashValue`
+ * option, which `ComposeObject()` cannot honor. The library uses fewer parts if
+ * the file is too small to make each part at least
+ * `parallel_upload_minimum_part_size()` long (16 MiB by default, see
+ * `ClientOptions`), and never uses more than 1024 parts, the maximum number of
+ * components in a composite object. At most 32 parts are uploaded at the same
+ * time.
+ */
+struct ParallelUpload
+    : public internal::ComplexOption<ParallelUpload, std::size_t> {
+  using ComplexOption<ParallelUpload, std::size_t>::ComplexOption;
+  static char const* name() { return "parallel-upload"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud